@@ -0,0 +1,137 @@
+/*
+ * batch_render_bench.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: zmij
+ */
+
+#include <pushkin/l10n/message_batch.hpp>
+#include "bench_util.hpp"
+
+#include <iomanip>
+#include <iostream>
+
+namespace psst {
+namespace l10n {
+namespace bench {
+
+namespace {
+
+/**
+ * A page of items, as a listing of an API response: a few distinct
+ * message texts with per-item arguments
+ */
+message_list
+make_page(::std::size_t size)
+{
+    message_list page;
+    page.reserve(size);
+    for (::std::size_t i = 0; i < size; ++i) {
+        switch (i % 4) {
+            case 0:
+                page.emplace_back("Download");
+                break;
+            case 1: {
+                message msg{"{1} file", "{1} files", static_cast<int>(i % 17)};
+                page.push_back(msg);
+                break;
+            }
+            case 2: {
+                message msg{"{1} sent you {2} messages"};
+                msg << "Alice" << static_cast<int>(i);
+                page.push_back(msg);
+                break;
+            }
+            default: {
+                message files{"{1} file", "{1} files", static_cast<int>(i % 5)};
+                message msg{"Folder {1} has {2}"};
+                msg << "Documents" << files;
+                page.push_back(msg);
+                break;
+            }
+        }
+    }
+    return page;
+}
+
+void
+compare(::std::size_t size, ::std::locale const& loc)
+{
+    auto page = make_page(size);
+    auto iterations = 2000000 / size;
+    auto batch = render_batch(page, loc);
+    for (::std::size_t i = 0; i < page.size(); ++i) {
+        if (batch.str(i) != page[i].str(loc))
+            ::std::cerr << "Results differ at " << i << "\n";
+    }
+    count_allocations(false);
+    auto each_ns = measure(iterations, [&]()
+    {
+        ::std::vector<::std::string> strs;
+        strs.reserve(page.size());
+        for (auto const& msg : page) {
+            strs.push_back(msg.str(loc));
+        }
+        do_not_optimize(strs);
+    });
+    rendered_batch reused;
+    auto batch_ns = measure(iterations, [&]()
+    {
+        reused.clear();
+        render_batch(page, loc, reused);
+        do_not_optimize(reused);
+    });
+    count_allocations(true);
+    ::std::size_t each_allocs, batch_allocs;
+    {
+        allocation_counter cnt;
+        for (auto const& msg : page) {
+            msg.str(loc);
+        }
+        each_allocs = cnt.count();
+    }
+    {
+        allocation_counter cnt;
+        render_batch(page, loc);
+        batch_allocs = cnt.count();
+    }
+    ::std::cout << ::std::setw(12) << size
+            << ::std::fixed << ::std::setprecision(1)
+            << ::std::setw(14) << each_ns / size
+            << ::std::setw(14) << batch_ns / size
+            << ::std::setw(10) << each_ns / batch_ns
+            << ::std::setw(10) << each_allocs
+            << ::std::setw(10) << batch_allocs << "\n";
+}
+
+}  /* namespace  */
+
+void
+run()
+{
+    ::boost::locale::generator gen;
+    for (auto name : { "en_US.UTF-8", "de_DE.UTF-8" }) {
+        auto loc = gen(name);
+        print_header(::std::string{"render a page of messages to "} + name);
+        ::std::cout << ::std::setw(12) << "items"
+                << ::std::setw(14) << "str ns/item"
+                << ::std::setw(14) << "batch ns/item"
+                << ::std::setw(10) << "speedup"
+                << ::std::setw(10) << "allocs"
+                << ::std::setw(10) << "batch" << "\n";
+        for (auto size : { 500, 5000 }) {
+            compare(size, loc);
+        }
+    }
+}
+
+}  /* namespace bench */
+}  /* namespace l10n */
+}  /* namespace psst */
+
+int
+main(int, char*[])
+{
+    psst::l10n::bench::run();
+    return 0;
+}
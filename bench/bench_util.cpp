@@ -0,0 +1,130 @@
+/*
+ * bench_util.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: zmij
+ */
+
+#include "bench_util.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <new>
+
+#include <sys/stat.h>
+
+namespace {
+
+::std::atomic<::std::size_t> allocations{0};
+::std::atomic<bool> counting{true};
+void const* volatile sink = nullptr;
+
+}  /* namespace  */
+
+void*
+operator new(::std::size_t sz)
+{
+    if (counting.load(::std::memory_order_relaxed))
+        allocations.fetch_add(1, ::std::memory_order_relaxed);
+    if (void* p = ::std::malloc(sz ? sz : 1))
+        return p;
+    throw ::std::bad_alloc{};
+}
+
+void
+operator delete(void* p) noexcept
+{
+    ::std::free(p);
+}
+
+void
+operator delete(void* p, ::std::size_t) noexcept
+{
+    ::std::free(p);
+}
+
+namespace psst {
+namespace l10n {
+namespace bench {
+
+::std::size_t
+allocation_count()
+{
+    return allocations.load(::std::memory_order_relaxed);
+}
+
+void
+count_allocations(bool enable)
+{
+    counting.store(enable, ::std::memory_order_relaxed);
+}
+
+void
+do_not_optimize(void const* p)
+{
+    sink = p;
+}
+
+void
+print_header(::std::string const& title)
+{
+    ::std::cout << "\n" << title << "\n"
+            << ::std::string(title.size(), '-') << "\n";
+}
+
+namespace {
+
+void
+put_word(::std::string& out, ::std::uint32_t w)
+{
+    out.append(reinterpret_cast<char const*>(&w), sizeof(w));
+}
+
+void
+make_dirs(::std::string const& file)
+{
+    for (auto pos = file.find('/', 1); pos != ::std::string::npos;
+            pos = file.find('/', pos + 1)) {
+        ::mkdir(file.substr(0, pos).c_str(), 0755);
+    }
+}
+
+}  /* namespace  */
+
+void
+write_catalog(::std::string const& file, ::std::vector<catalog_entry> entries)
+{
+    ::std::sort(entries.begin(), entries.end());
+    ::std::uint32_t n = entries.size();
+    ::std::uint32_t orig_table = 28;
+    ::std::uint32_t trans_table = orig_table + n * 8;
+    ::std::uint32_t strings = trans_table + n * 8;
+
+    ::std::string out;
+    for (auto w : { 0x950412deu, 0u, n, orig_table, trans_table, 0u, strings }) {
+        put_word(out, w);
+    }
+    ::std::string data;
+    ::std::string trans_descr;
+    for (auto const& e : entries) {
+        put_word(out, e.first.size());
+        put_word(out, strings + data.size());
+        data.append(e.first.c_str(), e.first.size() + 1);
+    }
+    for (auto const& e : entries) {
+        put_word(trans_descr, e.second.size());
+        put_word(trans_descr, strings + data.size());
+        data.append(e.second.c_str(), e.second.size() + 1);
+    }
+    make_dirs(file);
+    ::std::ofstream os{file, ::std::ios::binary};
+    os << out << trans_descr << data;
+}
+
+}  /* namespace bench */
+}  /* namespace l10n */
+}  /* namespace psst */
@@ -0,0 +1,96 @@
+/*
+ * bench_util.hpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: zmij
+ */
+
+#ifndef PUSHKIN_L10N_BENCH_BENCH_UTIL_HPP_
+#define PUSHKIN_L10N_BENCH_BENCH_UTIL_HPP_
+
+#include <chrono>
+#include <cstddef>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace psst {
+namespace l10n {
+namespace bench {
+
+/**
+ * Total count of calls to global operator new in the program
+ * (all threads).
+ */
+::std::size_t
+allocation_count();
+
+/**
+ * Enable or disable counting of allocations, e.g. to keep the shared
+ * counter out of multi-threaded timings. Enabled by default.
+ */
+void
+count_allocations(bool enable);
+
+/**
+ * Counts allocations made during the object's lifetime
+ */
+class allocation_counter {
+public:
+    allocation_counter() : start_{ allocation_count() } {}
+
+    ::std::size_t
+    count() const
+    { return allocation_count() - start_; }
+private:
+    ::std::size_t start_;
+};
+
+/**
+ * Run the function n times and return average time of a run in nanoseconds
+ */
+template < typename Func >
+double
+measure(::std::size_t n, Func f)
+{
+    using clock_type = ::std::chrono::steady_clock;
+    auto start = clock_type::now();
+    for (::std::size_t i = 0; i < n; ++i) {
+        f();
+    }
+    ::std::chrono::duration<double, ::std::nano> elapsed = clock_type::now() - start;
+    return elapsed.count() / n;
+}
+
+/**
+ * Prevent the compiler from optimizing away a value
+ */
+void
+do_not_optimize(void const*);
+
+template < typename T >
+void
+do_not_optimize(T const& v)
+{
+    do_not_optimize(static_cast<void const*>(&v));
+}
+
+void
+print_header(::std::string const& title);
+
+using catalog_entry = ::std::pair<::std::string, ::std::string>;
+/**
+ * Write a message catalog (.mo file) without a hash table, creating
+ * the directory of the file if needed. Message ids with context and
+ * plural forms are written as gettext does, with \x04 and \0 separators.
+ * @param file
+ * @param entries
+ */
+void
+write_catalog(::std::string const& file, ::std::vector<catalog_entry> entries);
+
+}  /* namespace bench */
+}  /* namespace l10n */
+}  /* namespace psst */
+
+#endif /* PUSHKIN_L10N_BENCH_BENCH_UTIL_HPP_ */
@@ -0,0 +1,190 @@
+/*
+ * catalog_reload_bench.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: zmij
+ */
+
+#include <pushkin/l10n/catalog_registry.hpp>
+#include <pushkin/l10n/message.hpp>
+#include "bench_util.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+namespace psst {
+namespace l10n {
+namespace bench {
+
+namespace {
+
+::std::size_t const MESSAGE_COUNT       = 1000;
+::std::size_t const READS_PER_THREAD    = 200000;
+// Pause between reloads, so that the writer doesn't take a core
+// from the readers
+::std::chrono::milliseconds const RELOAD_INTERVAL{10};
+
+using clock_type = ::std::chrono::steady_clock;
+using latencies = ::std::vector<double>;
+
+void
+write_version(::std::string const& file, int version)
+{
+    ::std::vector<catalog_entry> entries {
+        { "", "Content-Type: text/plain; charset=UTF-8\n" }
+    };
+    for (::std::size_t i = 0; i < MESSAGE_COUNT; ++i) {
+        entries.emplace_back("message " + ::std::to_string(i) + " {1}",
+                "сообщение " + ::std::to_string(i) + " {1} v" +
+                ::std::to_string(version));
+    }
+    // Replace the file atomically, the old one can be still mapped
+    write_catalog(file + ".new", entries);
+    ::std::rename((file + ".new").c_str(), file.c_str());
+}
+
+struct read_result {
+    latencies   get;
+    latencies   render;
+};
+
+/**
+ * Get the locale and render a message, measuring latency of each
+ */
+read_result
+run_readers(catalog_registry const& registry, ::std::vector<message> const& messages,
+        ::std::size_t threads)
+{
+    ::std::vector<read_result> results(threads);
+    ::std::vector<::std::thread> workers;
+    for (::std::size_t t = 0; t < threads; ++t) {
+        workers.emplace_back([&, t]()
+        {
+            auto& res = results[t];
+            res.get.reserve(READS_PER_THREAD);
+            res.render.reserve(READS_PER_THREAD);
+            ::std::string out;
+            for (::std::size_t i = 0; i < READS_PER_THREAD; ++i) {
+                auto const& msg = messages[(i * 7 + t) % messages.size()];
+                auto start = clock_type::now();
+                auto loc = registry.get("ru_RU.UTF-8");
+                auto got = clock_type::now();
+                out.clear();
+                msg.render(out, loc);
+                auto rendered = clock_type::now();
+                do_not_optimize(out);
+                ::std::chrono::duration<double, ::std::nano> get_time = got - start;
+                ::std::chrono::duration<double, ::std::nano> render_time = rendered - got;
+                res.get.push_back(get_time.count());
+                res.render.push_back(render_time.count());
+            }
+        });
+    }
+    for (auto& w : workers) {
+        w.join();
+    }
+    read_result total;
+    for (auto& r : results) {
+        total.get.insert(total.get.end(), r.get.begin(), r.get.end());
+        total.render.insert(total.render.end(), r.render.begin(), r.render.end());
+    }
+    return total;
+}
+
+double
+percentile(latencies& l, double p)
+{
+    auto idx = static_cast<::std::size_t>(p * (l.size() - 1));
+    ::std::nth_element(l.begin(), l.begin() + idx, l.end());
+    return l[idx];
+}
+
+void
+print_latencies(::std::string const& name, latencies& l)
+{
+    ::std::cout << ::std::setw(24) << name << ::std::fixed << ::std::setprecision(0)
+            << ::std::setw(10) << percentile(l, 0.5)
+            << ::std::setw(10) << percentile(l, 0.99)
+            << ::std::setw(10) << percentile(l, 0.999)
+            << ::std::setw(12) << *::std::max_element(l.begin(), l.end()) << "\n";
+}
+
+}  /* namespace  */
+
+void
+run()
+{
+    print_header("read latency during catalog reload, ns");
+    char tmpl[] = "/tmp/l10n-reload-bench-XXXXXX";
+    if (!::mkdtemp(tmpl)) {
+        ::std::cerr << "Failed to create a temporary directory\n";
+        return;
+    }
+    ::std::string dir = tmpl;
+    auto file = dir + "/ru/LC_MESSAGES/bench.mo";
+    write_version(file, 0);
+
+    catalog_registry registry{{dir}, {"bench"}};
+    ::std::vector<message> messages;
+    for (::std::size_t i = 0; i < MESSAGE_COUNT; ++i) {
+        messages.emplace_back("message " + ::std::to_string(i) + " {1}");
+        messages.back() << i;
+    }
+    registry.get("ru_RU.UTF-8");
+
+    count_allocations(false);
+    auto threads = ::std::max(2u, ::std::thread::hardware_concurrency() / 2);
+    ::std::cout << "reader threads: " << threads << "\n"
+            << ::std::setw(24) << ""
+            << ::std::setw(10) << "p50"
+            << ::std::setw(10) << "p99"
+            << ::std::setw(10) << "p99.9"
+            << ::std::setw(12) << "max" << "\n";
+
+    auto idle = run_readers(registry, messages, threads);
+    print_latencies("get, no reload", idle.get);
+    print_latencies("render, no reload", idle.render);
+
+    ::std::atomic<bool> done{false};
+    ::std::size_t reloads = 0;
+    ::std::thread writer{[&]()
+    {
+        int version = 1;
+        while (!done.load()) {
+            write_version(file, version++);
+            registry.reload();
+            ++reloads;
+            ::std::this_thread::sleep_for(RELOAD_INTERVAL);
+        }
+    }};
+    auto busy = run_readers(registry, messages, threads);
+    done.store(true);
+    writer.join();
+    print_latencies("get, reloading", busy.get);
+    print_latencies("render, reloading", busy.render);
+    ::std::cout << "reloads during the run: " << reloads << "\n";
+    count_allocations(true);
+
+    ::std::remove(file.c_str());
+    ::std::remove((dir + "/ru/LC_MESSAGES").c_str());
+    ::std::remove((dir + "/ru").c_str());
+    ::std::remove(dir.c_str());
+}
+
+}  /* namespace bench */
+}  /* namespace l10n */
+}  /* namespace psst */
+
+int
+main(int, char*[])
+{
+    psst::l10n::bench::run();
+    return 0;
+}
@@ -0,0 +1,130 @@
+/*
+ * fan_out_bench.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: zmij
+ */
+
+#include <pushkin/l10n/message.hpp>
+#include "bench_util.hpp"
+
+#include <iomanip>
+#include <iostream>
+
+namespace psst {
+namespace l10n {
+namespace bench {
+
+namespace {
+
+::std::size_t const ITERATIONS = 20000;
+
+char const* const locale_names[] {
+    "en_US.UTF-8", "en_GB.UTF-8", "de_DE.UTF-8", "fr_FR.UTF-8",
+    "es_ES.UTF-8", "it_IT.UTF-8", "pt_BR.UTF-8", "pt_PT.UTF-8",
+    "ru_RU.UTF-8", "uk_UA.UTF-8", "pl_PL.UTF-8", "cs_CZ.UTF-8",
+    "nl_NL.UTF-8", "sv_SE.UTF-8", "fi_FI.UTF-8", "da_DK.UTF-8",
+    "nb_NO.UTF-8", "tr_TR.UTF-8", "ja_JP.UTF-8", "ko_KR.UTF-8",
+    "zh_CN.UTF-8", "zh_TW.UTF-8", "he_IL.UTF-8", "el_GR.UTF-8",
+};
+
+/**
+ * Render a message to all locales, one locale at a time and at once
+ */
+void
+compare(char const* name, message const& msg,
+        message::locale_list const& locales)
+{
+    auto strs = msg.str(locales);
+    for (::std::size_t i = 0; i < locales.size(); ++i) {
+        if (strs[i] != msg.str(locales[i]))
+            ::std::cerr << "Results differ for " << name << "\n";
+    }
+    count_allocations(false);
+    auto each_ns = measure(ITERATIONS, [&]()
+    {
+        for (auto const& loc : locales) {
+            auto str = msg.str(loc);
+            do_not_optimize(str);
+        }
+    });
+    auto fan_out_ns = measure(ITERATIONS, [&]()
+    {
+        auto strs = msg.str(locales);
+        do_not_optimize(strs);
+    });
+    count_allocations(true);
+    ::std::size_t each_allocs, fan_out_allocs;
+    {
+        allocation_counter cnt;
+        for (auto const& loc : locales) {
+            msg.str(loc);
+        }
+        each_allocs = cnt.count();
+    }
+    {
+        allocation_counter cnt;
+        msg.str(locales);
+        fan_out_allocs = cnt.count();
+    }
+    ::std::cout << ::std::setw(30) << ::std::left << name
+            << ::std::right << ::std::fixed << ::std::setprecision(1)
+            << ::std::setw(12) << each_ns
+            << ::std::setw(12) << fan_out_ns
+            << ::std::setw(10) << each_ns / fan_out_ns
+            << ::std::setw(10) << each_allocs
+            << ::std::setw(10) << fan_out_allocs << "\n";
+}
+
+}  /* namespace  */
+
+void
+run()
+{
+    ::boost::locale::generator gen;
+    message::locale_list locales;
+    for (auto name : locale_names) {
+        locales.push_back(gen(name));
+    }
+
+    message flat{"{1} sent you {2} messages, {3} KB total"};
+    flat << "Alice" << 42 << 1536.5;
+
+    message files{"{1} file", "{1} files", 17};
+    message folder{"Folder {1} has {2}"};
+    folder << "Documents" << files;
+    message nested{"{1} shared {2} with {3} people, {4}"};
+    nested << "Bob" << folder << 12 << flat;
+
+    message deep{"{1}"};
+    deep << nested;
+    for (int i = 0; i < 4; ++i) {
+        message outer{"{1} / {2} / {3}"};
+        outer << deep << i << nested;
+        deep = outer;
+    }
+
+    print_header("render to " + ::std::to_string(locales.size()) + " locales");
+    ::std::cout << ::std::setw(30) << ::std::left << "message"
+            << ::std::right
+            << ::std::setw(12) << "each ns"
+            << ::std::setw(12) << "fan-out ns"
+            << ::std::setw(10) << "speedup"
+            << ::std::setw(10) << "allocs"
+            << ::std::setw(10) << "fan-out" << "\n";
+    compare("flat, 3 args", flat, locales);
+    compare("plural", files, locales);
+    compare("nested, 2 levels", nested, locales);
+    compare("nested, 6 levels", deep, locales);
+}
+
+}  /* namespace bench */
+}  /* namespace l10n */
+}  /* namespace psst */
+
+int
+main(int, char*[])
+{
+    psst::l10n::bench::run();
+    return 0;
+}
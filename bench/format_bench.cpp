@@ -0,0 +1,88 @@
+/*
+ * format_bench.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: zmij
+ */
+
+#include <pushkin/l10n/message.hpp>
+#include "bench_util.hpp"
+
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+namespace psst {
+namespace l10n {
+namespace bench {
+
+namespace {
+
+::std::size_t const ITERATIONS = 200000;
+
+char const* const formats[] {
+    "No placeholders at all",
+    "{1} received {2} from {3}",
+    "{1,num} items, {2} total",
+};
+
+}  /* namespace  */
+
+void
+run()
+{
+    print_header("render formatted message");
+    ::boost::locale::generator gen;
+    auto loc = gen("en_US.UTF-8");
+    ::std::cout << ::std::setw(30) << ::std::left << "format"
+            << ::std::right
+            << ::std::setw(12) << "boost ns"
+            << ::std::setw(12) << "l10n ns"
+            << ::std::setw(12) << "render ns" << "\n";
+    for (auto f : formats) {
+        int count = 42;
+        ::std::string name = "Somebody";
+        ::std::string what = "a message";
+        ::std::ostringstream os;
+        os.imbue(loc);
+        auto boost_ns = measure(ITERATIONS, [&]()
+        {
+            os.str("");
+            ::boost::locale::format fmt{ ::boost::locale::translate(f) };
+            fmt % name % count % what;
+            os << fmt;
+            do_not_optimize(os);
+        });
+        message msg{f};
+        msg << name << count << what;
+        auto l10n_ns = measure(ITERATIONS, [&]()
+        {
+            os.str("");
+            os << msg;
+            do_not_optimize(os);
+        });
+        ::std::string buffer;
+        auto render_ns = measure(ITERATIONS, [&]()
+        {
+            buffer.clear();
+            msg.render(buffer, loc);
+            do_not_optimize(buffer);
+        });
+        ::std::cout << ::std::setw(30) << ::std::left << f
+                << ::std::right << ::std::fixed << ::std::setprecision(1)
+                << ::std::setw(12) << boost_ns
+                << ::std::setw(12) << l10n_ns
+                << ::std::setw(12) << render_ns << "\n";
+    }
+}
+
+}  /* namespace bench */
+}  /* namespace l10n */
+}  /* namespace psst */
+
+int
+main(int, char*[])
+{
+    psst::l10n::bench::run();
+    return 0;
+}
@@ -0,0 +1,139 @@
+/*
+ * format_mt_bench.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: zmij
+ */
+
+#include <pushkin/l10n/message.hpp>
+#include "bench_util.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+namespace psst {
+namespace l10n {
+namespace bench {
+
+namespace {
+
+::std::size_t const RENDERS_PER_THREAD = 100000;
+
+char const* const format_str = "{1} received {2} messages from {3}";
+
+/**
+ * Render with a new boost::locale::format and stream each time
+ */
+void
+render_boost(::std::locale const& loc, ::std::string& out)
+{
+    ::std::string name = "Somebody";
+    int count = 42;
+    ::std::string from = "a friend";
+    ::boost::locale::format fmt{ ::boost::locale::translate(format_str) };
+    fmt % name % count % from;
+    out = fmt.str(loc);
+}
+
+/**
+ * Render a message into a reused buffer
+ */
+void
+render_l10n(message const& msg, ::std::locale const& loc, ::std::string& out)
+{
+    out.clear();
+    msg.render(out, loc);
+}
+
+template < typename Func >
+double
+run_threads(::std::size_t threads, Func f)
+{
+    using clock_type = ::std::chrono::steady_clock;
+    ::std::vector<::std::thread> workers;
+    auto start = clock_type::now();
+    for (::std::size_t t = 0; t < threads; ++t) {
+        workers.emplace_back([&]()
+        {
+            ::std::string out;
+            for (::std::size_t i = 0; i < RENDERS_PER_THREAD; ++i) {
+                f(out);
+                do_not_optimize(out);
+            }
+        });
+    }
+    for (auto& w : workers) {
+        w.join();
+    }
+    ::std::chrono::duration<double> elapsed = clock_type::now() - start;
+    // Renders per second
+    return threads * RENDERS_PER_THREAD / elapsed.count();
+}
+
+}  /* namespace  */
+
+void
+run()
+{
+    print_header("multi-threaded rendering");
+    ::boost::locale::generator gen;
+    auto loc = gen("en_US.UTF-8");
+    message msg{format_str};
+    msg << "Somebody" << 42 << "a friend";
+
+    // Allocations per render in steady state
+    ::std::string out;
+    render_boost(loc, out);
+    render_l10n(msg, loc, out);
+    ::std::size_t boost_allocs, l10n_allocs;
+    {
+        allocation_counter cnt;
+        for (int i = 0; i < 100; ++i)
+            render_boost(loc, out);
+        boost_allocs = cnt.count();
+    }
+    {
+        allocation_counter cnt;
+        for (int i = 0; i < 100; ++i)
+            render_l10n(msg, loc, out);
+        l10n_allocs = cnt.count();
+    }
+    ::std::cout << "allocations per render: boost "
+            << boost_allocs / 100.0 << ", l10n " << l10n_allocs / 100.0 << "\n";
+
+    count_allocations(false);
+    auto max_threads = ::std::max(4u, ::std::thread::hardware_concurrency());
+    ::std::cout << ::std::setw(8) << "threads"
+            << ::std::setw(16) << "boost r/s"
+            << ::std::setw(16) << "l10n r/s"
+            << ::std::setw(10) << "speedup" << "\n";
+    for (::std::size_t threads = 1; threads <= max_threads; threads *= 2) {
+        auto boost_rps = run_threads(threads,
+                [&](::std::string& o) { render_boost(loc, o); });
+        auto l10n_rps = run_threads(threads,
+                [&](::std::string& o) { render_l10n(msg, loc, o); });
+        ::std::cout << ::std::setw(8) << threads
+                << ::std::fixed << ::std::setprecision(0)
+                << ::std::setw(16) << boost_rps
+                << ::std::setw(16) << l10n_rps
+                << ::std::setprecision(2)
+                << ::std::setw(10) << l10n_rps / boost_rps << "\n";
+    }
+    count_allocations(true);
+}
+
+}  /* namespace bench */
+}  /* namespace l10n */
+}  /* namespace psst */
+
+int
+main(int, char*[])
+{
+    psst::l10n::bench::run();
+    return 0;
+}
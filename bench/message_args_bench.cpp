@@ -0,0 +1,134 @@
+/*
+ * message_args_bench.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: zmij
+ */
+
+#include <pushkin/l10n/message.hpp>
+#include "bench_util.hpp"
+
+#include <iomanip>
+#include <iostream>
+
+namespace psst {
+namespace l10n {
+namespace bench {
+
+namespace {
+
+::std::size_t const ITERATIONS = 1000000;
+
+message
+make_message(::std::size_t n_args)
+{
+    // Short id to stay within the string's small buffer
+    message msg{"{1}{2}{3}{4}"};
+    for (::std::size_t i = 0; i < n_args; ++i) {
+        if (i % 2) {
+            msg << "arg";
+        } else {
+            msg << static_cast<int>(i);
+        }
+    }
+    return msg;
+}
+
+message
+make_nested(::std::size_t depth)
+{
+    message msg{"{1}:{2}"};
+    msg << static_cast<int>(depth);
+    if (depth > 0) {
+        msg << make_nested(depth - 1);
+    } else {
+        msg << "leaf";
+    }
+    return msg;
+}
+
+void
+nested_copy()
+{
+    print_header("copy of a nested message by nesting depth");
+    ::std::cout << ::std::setw(6) << "depth"
+            << ::std::setw(14) << "copy allocs"
+            << ::std::setw(12) << "copy ns" << "\n";
+    for (::std::size_t depth : { 0, 1, 4, 16, 64 }) {
+        auto src = make_nested(depth);
+        double copy_allocs;
+        {
+            allocation_counter cnt;
+            for (::std::size_t i = 0; i < 1000; ++i) {
+                message copy{src};
+                do_not_optimize(copy);
+            }
+            copy_allocs = cnt.count() / 1000.0;
+        }
+        auto copy_ns = measure(ITERATIONS, [&]()
+                { message copy{src}; do_not_optimize(copy); });
+        ::std::cout << ::std::setw(6) << depth
+                << ::std::setw(14) << copy_allocs
+                << ::std::setw(12) << ::std::fixed << ::std::setprecision(1) << copy_ns
+                << ::std::defaultfloat << "\n";
+    }
+}
+
+}  /* namespace  */
+
+void
+run()
+{
+    // Keep message ids interned, so that only argument storage is measured
+    message const ids[] { message{"{1}{2}{3}{4}"}, message{"{1}:{2}"} };
+    do_not_optimize(ids);
+    print_header("message arguments: allocations and time per message");
+    ::std::cout << ::std::setw(6) << "args"
+            << ::std::setw(14) << "create allocs"
+            << ::std::setw(12) << "create ns"
+            << ::std::setw(14) << "copy allocs"
+            << ::std::setw(12) << "copy ns" << "\n";
+    for (::std::size_t n_args = 0; n_args <= 6; ++n_args) {
+        double create_allocs, copy_allocs;
+        {
+            allocation_counter cnt;
+            for (::std::size_t i = 0; i < 1000; ++i) {
+                do_not_optimize(make_message(n_args));
+            }
+            create_allocs = cnt.count() / 1000.0;
+        }
+        auto create_ns = measure(ITERATIONS, [&]()
+                { do_not_optimize(make_message(n_args)); });
+
+        auto src = make_message(n_args);
+        {
+            allocation_counter cnt;
+            for (::std::size_t i = 0; i < 1000; ++i) {
+                message copy{src};
+                do_not_optimize(copy);
+            }
+            copy_allocs = cnt.count() / 1000.0;
+        }
+        auto copy_ns = measure(ITERATIONS, [&]()
+                { message copy{src}; do_not_optimize(copy); });
+
+        ::std::cout << ::std::setw(6) << n_args
+                << ::std::setw(14) << create_allocs
+                << ::std::setw(12) << ::std::fixed << ::std::setprecision(1) << create_ns
+                << ::std::setw(14) << ::std::defaultfloat << copy_allocs
+                << ::std::setw(12) << ::std::fixed << copy_ns
+                << ::std::defaultfloat << "\n";
+    }
+    nested_copy();
+}
+
+}  /* namespace bench */
+}  /* namespace l10n */
+}  /* namespace psst */
+
+int
+main(int, char*[])
+{
+    psst::l10n::bench::run();
+    return 0;
+}
@@ -0,0 +1,72 @@
+/*
+ * message_memory_bench.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: zmij
+ */
+
+#include <pushkin/l10n/message.hpp>
+#include "bench_util.hpp"
+
+#include <iomanip>
+#include <iostream>
+
+namespace psst {
+namespace l10n {
+namespace bench {
+
+namespace {
+
+::std::size_t const CATALOG_SIZE   = 200000;
+::std::size_t const DISTINCT_IDS   = 2000;
+
+}  /* namespace  */
+
+void
+run()
+{
+    print_header("asset catalog memory usage");
+    message_list catalog;
+    catalog.reserve(CATALOG_SIZE);
+    message::domain_type domain{"assets"};
+    allocation_counter cnt;
+    auto create_ns = measure(CATALOG_SIZE, [&]()
+    {
+        auto i = catalog.size();
+        auto id = "Asset description number " + ::std::to_string(i % DISTINCT_IDS);
+        if (i % 3) {
+            catalog.emplace_back("asset.context", id, domain);
+        } else {
+            catalog.emplace_back(id, domain);
+        }
+    });
+    auto allocs = cnt.count();
+
+    ::std::size_t total = 0;
+    for (auto const& msg : catalog) {
+        total += msg.memory_usage();
+    }
+    ::std::cout << "messages           " << catalog.size() << "\n"
+            << "distinct ids       " << DISTINCT_IDS << "\n"
+            << "sizeof(message)    " << sizeof(message) << "\n"
+            << "memory usage       " << total << " bytes\n"
+            << "bytes per message  " << ::std::fixed << ::std::setprecision(1)
+                    << static_cast<double>(total) / catalog.size() << "\n"
+            << "allocs per message " << static_cast<double>(allocs) / catalog.size() << "\n"
+            << "ns per message     " << create_ns << "\n";
+
+    auto copy_ns = measure(100, [&]()
+            { message_list copy{catalog}; do_not_optimize(copy); });
+    ::std::cout << "copy catalog       " << copy_ns / 1000000 << " ms\n";
+}
+
+}  /* namespace bench */
+}  /* namespace l10n */
+}  /* namespace psst */
+
+int
+main(int, char*[])
+{
+    psst::l10n::bench::run();
+    return 0;
+}
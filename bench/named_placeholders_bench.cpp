@@ -0,0 +1,237 @@
+/*
+ * named_placeholders_bench.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: zmij
+ */
+
+#include <pushkin/l10n/message.hpp>
+#include <pushkin/l10n/message_util.hpp>
+#include <pushkin/l10n/grammar/placeholders.hpp>
+#include "bench_util.hpp"
+
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <map>
+#include <set>
+#include <sstream>
+
+namespace psst {
+namespace l10n {
+namespace bench {
+
+namespace {
+
+::std::size_t const ITERATIONS = 200000;
+
+/**
+ * The previous implementation of extract_named_placeholders, with the
+ * Spirit grammar, kept for comparison
+ */
+namespace previous {
+
+struct ph_usage {
+    ::std::size_t   number;
+    bool            is_pluralizer;
+    ::std::size_t   uses;
+};
+
+placeholders
+extract_placeholders(::std::string const& input)
+{
+    namespace qi = ::boost::spirit::qi;
+    using string_iterator   = ::std::string::const_iterator;
+    using grammar_type      = grammar::parse::placeholders_grammar<string_iterator>;
+    static grammar_type parser;
+
+    string_iterator first = input.begin();
+    string_iterator last = input.end();
+
+    placeholders ph;
+    qi::parse(first, last, parser, ph);
+    return ph;
+}
+
+::std::pair<::std::string, placeholders>
+extract_named_placeholders(::std::string const& input)
+{
+    auto phs = extract_placeholders(input);
+    if (phs.empty())
+        return {input, placeholders{}};
+    placeholders named_phs;
+    ::std::copy_if(phs.begin(), phs.end(), ::std::back_inserter(named_phs),
+            [](placeholder const& ph)
+            {
+                return ph.type() == placeholder::name;
+            });
+    if (named_phs.empty())
+        return {input, placeholders{}};
+
+    ::std::map< ::std::string, ph_usage > name_numbers;
+    for (auto const& ph : named_phs) {
+        auto nm = ::boost::get< ::std::string >(ph.id);
+        auto f = name_numbers.find(nm);
+        if (f == name_numbers.end()) {
+            name_numbers.emplace(nm, ph_usage{name_numbers.size() + 1, ph.is_pluralizer, 1});
+        } else{
+            if (ph.is_pluralizer)
+                f->second.is_pluralizer = ph.is_pluralizer;
+            ++f->second.uses;
+        }
+    }
+
+    auto delta = name_numbers.size();
+    for (auto& ph : phs) {
+        if (ph.type() == placeholder::number) {
+            ::boost::get<::std::size_t>(ph.id) += delta;
+        } else {
+            auto const& nm = ::boost::get< ::std::string >(ph.id);
+            ph.id = name_numbers[nm].number;
+        }
+    }
+    ::std::ostringstream os;
+    auto ph = phs.begin();
+    for (auto c = input.begin(); c != input.end(); ++c) {
+        if (*c == '{') {
+            ::std::ostringstream backtrack;
+            for (; c != input.end() && *c != '}'; ++c) {
+                backtrack.put(*c);
+            }
+            if (c == input.end()) {
+                os << backtrack.str();
+            } else {
+                os << *ph++;
+            }
+        } else {
+            os.put(*c);
+        }
+    }
+    if (named_phs.size() != name_numbers.size()) {
+        placeholders tmp;
+        tmp.reserve(name_numbers.size());
+        ::std::set<::std::string> seen;
+        for (auto& ph: named_phs) {
+            auto const& nm = ::boost::get< ::std::string >(ph.id);
+            if (!seen.count(nm)) {
+                auto const& use = name_numbers[nm];
+                ph.is_pluralizer = use.is_pluralizer;
+                ph.uses = use.uses;
+                tmp.push_back(ph);
+                seen.emplace(nm);
+            }
+        }
+        named_phs.swap(tmp);
+    }
+
+    return { os.str(), named_phs };
+}
+
+}  /* namespace previous */
+
+// Strings from placeholders_test.cpp
+char const* const inputs[] {
+    "{A} second {1} {B}",
+    "{A} second {1} {B} some {A}",
+    "{A} second {1} {B} some {n:A}",
+    "{A,hex} second {1,ftime='%I o''clock'} {B,time=full} some {n:A,oct}",
+    "{n:A} bar {B} {A}",
+    "{FogGrenades.EffectTimeSec} second",
+    "Today {1,date} I would meet {2} at home",
+};
+
+}  /* namespace  */
+
+void
+run()
+{
+    print_header("extract named placeholders");
+    ::std::cout << ::std::setw(72) << ::std::left << "input"
+            << ::std::right
+            << ::std::setw(12) << "prev ns"
+            << ::std::setw(12) << "ns"
+            << ::std::setw(10) << "speedup"
+            << ::std::setw(12) << "prev allocs"
+            << ::std::setw(8) << "allocs" << "\n";
+    for (auto in : inputs) {
+        ::std::string input = in;
+        if (previous::extract_named_placeholders(input).first !=
+                extract_named_placeholders(input).first) {
+            ::std::cerr << "Results differ for " << input << "\n";
+        }
+        count_allocations(false);
+        auto prev_ns = measure(ITERATIONS, [&]()
+        {
+            auto res = previous::extract_named_placeholders(input);
+            do_not_optimize(res);
+        });
+        auto ns = measure(ITERATIONS, [&]()
+        {
+            auto res = extract_named_placeholders(input);
+            do_not_optimize(res);
+        });
+        count_allocations(true);
+        ::std::size_t prev_allocs, allocs;
+        {
+            allocation_counter cnt;
+            previous::extract_named_placeholders(input);
+            prev_allocs = cnt.count();
+        }
+        {
+            allocation_counter cnt;
+            extract_named_placeholders(input);
+            allocs = cnt.count();
+        }
+        ::std::cout << ::std::setw(72) << ::std::left << input
+                << ::std::right << ::std::fixed << ::std::setprecision(1)
+                << ::std::setw(12) << prev_ns
+                << ::std::setw(12) << ns
+                << ::std::setw(10) << prev_ns / ns
+                << ::std::setw(12) << prev_allocs
+                << ::std::setw(8) << allocs << "\n";
+    }
+
+    print_header("create message, cached string template and static id");
+    ::std::cout << ::std::setw(72) << ::std::left << "input"
+            << ::std::right
+            << ::std::setw(12) << "cached ns"
+            << ::std::setw(12) << "static ns"
+            << ::std::setw(10) << "speedup" << "\n";
+    ::std::pair<char const*, int> const values[] {
+        { "A", 1 }, { "B", 2 }, { "count", 3 }, { "user", 4 }
+    };
+    auto compare = [&](::std::string const& input, static_named_id const& id)
+    {
+        auto cached_ns = measure(ITERATIONS, [&]()
+        {
+            auto msg = message::create_message(input, values);
+            do_not_optimize(msg);
+        });
+        auto static_ns = measure(ITERATIONS, [&]()
+        {
+            auto msg = message::create_message(id, values);
+            do_not_optimize(msg);
+        });
+        ::std::cout << ::std::setw(72) << ::std::left << input
+                << ::std::right << ::std::fixed << ::std::setprecision(1)
+                << ::std::setw(12) << cached_ns
+                << ::std::setw(12) << static_ns
+                << ::std::setw(10) << cached_ns / static_ns << "\n";
+    };
+    compare("{A} second {1} {B} some {n:A}",
+            PSST_L10N_NAMED_ID("{A} second {1} {B} some {n:A}"));
+    compare("{user} has {count} new messages in the inbox, {user}",
+            PSST_L10N_NAMED_ID("{user} has {count} new messages in the inbox, {user}"));
+}
+
+}  /* namespace bench */
+}  /* namespace l10n */
+}  /* namespace psst */
+
+int
+main(int, char*[])
+{
+    psst::l10n::bench::run();
+    return 0;
+}
@@ -0,0 +1,116 @@
+/*
+ * parallel_render_bench.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: zmij
+ */
+
+#include <pushkin/l10n/parallel_renderer.hpp>
+#include "bench_util.hpp"
+
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+namespace psst {
+namespace l10n {
+namespace bench {
+
+namespace {
+
+::std::size_t const MESSAGES   = 200000;
+::std::size_t const ITERATIONS = 5;
+
+message_list
+make_export(::std::size_t size)
+{
+    message_list messages;
+    messages.reserve(size);
+    for (::std::size_t i = 0; i < size; ++i) {
+        int n = static_cast<int>(i);
+        switch (i % 4) {
+            case 0:
+                messages.emplace_back("Download");
+                break;
+            case 1:
+                messages.emplace_back("{1} file", "{1} files", n % 17);
+                break;
+            case 2:
+                messages.emplace_back("{1} sent you {2} messages, {3} KB total");
+                messages.back() << "Alice" << n << 1536.5;
+                break;
+            default: {
+                message files{"{1} file", "{1} files", n % 5};
+                messages.emplace_back("Folder {1} has {2}");
+                messages.back() << "Documents" << files;
+                break;
+            }
+        }
+    }
+    return messages;
+}
+
+}  /* namespace  */
+
+void
+run(::std::size_t max_threads)
+{
+    ::boost::locale::generator gen;
+    auto loc = gen("en_US.UTF-8");
+    auto messages = make_export(MESSAGES);
+
+    auto str_ns = measure(ITERATIONS, [&]()
+    {
+        message::string_list strs;
+        strs.reserve(messages.size());
+        for (auto const& msg : messages) {
+            strs.push_back(msg.str(loc));
+        }
+        do_not_optimize(strs);
+    });
+
+    print_header("render " + ::std::to_string(MESSAGES) + " messages");
+    ::std::cout << ::std::setw(10) << "threads"
+            << ::std::setw(14) << "ms"
+            << ::std::setw(14) << "ns/message"
+            << ::std::setw(10) << "speedup" << "\n";
+    ::std::cout << ::std::setw(10) << "str()"
+            << ::std::fixed << ::std::setprecision(1)
+            << ::std::setw(14) << str_ns / 1e6
+            << ::std::setw(14) << str_ns / MESSAGES
+            << ::std::setw(10) << 1.0 << "\n";
+    // Powers of two up to the maximum, and the maximum
+    ::std::vector<::std::size_t> counts;
+    for (::std::size_t threads = 1; threads < max_threads; threads *= 2) {
+        counts.push_back(threads);
+    }
+    counts.push_back(max_threads);
+    for (auto threads : counts) {
+        parallel_renderer renderer{threads};
+        auto ns = measure(ITERATIONS, [&]()
+        {
+            auto strs = renderer.render(messages, loc).get();
+            do_not_optimize(strs);
+        });
+        ::std::cout << ::std::setw(10) << threads
+                << ::std::setw(14) << ns / 1e6
+                << ::std::setw(14) << ns / MESSAGES
+                << ::std::setw(10) << str_ns / ns << "\n";
+    }
+}
+
+}  /* namespace bench */
+}  /* namespace l10n */
+}  /* namespace psst */
+
+int
+main(int argc, char* argv[])
+{
+    ::std::size_t threads = ::std::thread::hardware_concurrency();
+    if (argc > 1)
+        threads = ::std::strtoul(argv[1], nullptr, 10);
+    psst::l10n::bench::run(::std::max<::std::size_t>(threads, 1));
+    return 0;
+}
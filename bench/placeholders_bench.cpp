@@ -0,0 +1,103 @@
+/*
+ * placeholders_bench.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: zmij
+ */
+
+#include <pushkin/l10n/message_util.hpp>
+#include <pushkin/l10n/grammar/placeholders.hpp>
+#include "bench_util.hpp"
+
+#include <iomanip>
+#include <iostream>
+
+namespace psst {
+namespace l10n {
+namespace bench {
+
+namespace {
+
+::std::size_t const TEXT_SIZE = 64 * 1024;
+
+placeholders
+parse_with_grammar(::std::string const& input)
+{
+    namespace qi = ::boost::spirit::qi;
+    using string_iterator   = ::std::string::const_iterator;
+    using grammar_type      = grammar::parse::placeholders_grammar<string_iterator>;
+    static grammar_type parser;
+
+    string_iterator first = input.begin();
+    string_iterator last = input.end();
+    placeholders ph;
+    qi::parse(first, last, parser, ph);
+    return ph;
+}
+
+/**
+ * Repeat a chunk of text up to the size
+ */
+::std::string
+make_text(::std::string const& chunk)
+{
+    ::std::string text;
+    while (text.size() < TEXT_SIZE) {
+        text += chunk;
+    }
+    return text;
+}
+
+}  /* namespace  */
+
+void
+run()
+{
+    print_header("extract placeholders from 64KiB text, MiB/s");
+    struct {
+        char const*     name;
+        ::std::string   text;
+    } const inputs[] {
+        { "plain text", make_text("The quick brown fox jumps over the lazy dog. ") },
+        { "escaped braces", make_text("Unexpected `{{' in line of the file. ") },
+        { "sparse placeholders", make_text(
+            "Ms. {1} had arrived at home, the exact time is {2,time=full}. "
+            "The quick brown fox jumps over the lazy dog again and again. ") },
+        { "dense placeholders", make_text("{1}{n:count,num} {name} ") },
+    };
+    ::std::cout << ::std::setw(24) << ::std::left << "input"
+            << ::std::right
+            << ::std::setw(12) << "spirit"
+            << ::std::setw(12) << "scanner"
+            << ::std::setw(10) << "speedup" << "\n";
+    for (auto const& in : inputs) {
+        auto iterations = 200;
+        auto spirit_ns = measure(iterations, [&]()
+        {
+            auto phs = parse_with_grammar(in.text);
+            do_not_optimize(phs);
+        });
+        auto scanner_ns = measure(iterations, [&]()
+        {
+            auto phs = extract_placeholders(in.text);
+            do_not_optimize(phs);
+        });
+        auto mib = static_cast<double>(in.text.size()) / (1024 * 1024);
+        ::std::cout << ::std::setw(24) << ::std::left << in.name
+                << ::std::right << ::std::fixed << ::std::setprecision(1)
+                << ::std::setw(12) << mib / (spirit_ns * 1e-9)
+                << ::std::setw(12) << mib / (scanner_ns * 1e-9)
+                << ::std::setw(10) << spirit_ns / scanner_ns << "\n";
+    }
+}
+
+}  /* namespace bench */
+}  /* namespace l10n */
+}  /* namespace psst */
+
+int
+main(int, char*[])
+{
+    psst::l10n::bench::run();
+    return 0;
+}
@@ -0,0 +1,97 @@
+/*
+ * prerendered_bench.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: zmij
+ */
+
+#include <pushkin/l10n/prerendered_messages.hpp>
+#include "bench_util.hpp"
+
+#include <iomanip>
+#include <iostream>
+
+namespace psst {
+namespace l10n {
+namespace bench {
+
+namespace {
+
+::std::size_t const ITERATIONS = 1000000;
+
+message_entry const entries[] {
+    { nullptr, "Download", nullptr },
+    { "menu", "Open", nullptr },
+    { nullptr, "Settings", nullptr },
+    { nullptr, "{1} file", "{1} files" },
+};
+message_table const table{ nullptr, entries, 4 };
+
+message_table const&
+get_table()
+{
+    return table;
+}
+
+}  /* namespace  */
+
+void
+run()
+{
+    ::boost::locale::generator gen;
+    message::locale_list locales {
+        gen("en_US.UTF-8"), gen("de_DE.UTF-8"), gen("ru_RU.UTF-8")
+    };
+    prerendered_messages prerendered{table, locales};
+    message_id ids[] { {&get_table, 0}, {&get_table, 1}, {&get_table, 2} };
+
+    print_header("argument-free messages");
+    ::std::cout << ::std::setw(24) << ::std::left << "method" << ::std::right
+            << ::std::setw(12) << "ns/op"
+            << ::std::setw(12) << "allocs" << "\n";
+    auto report = [&](char const* name, ::std::function<void(::std::size_t)> f)
+    {
+        count_allocations(false);
+        ::std::size_t i = 0;
+        auto ns = measure(ITERATIONS, [&]() { f(i++); });
+        count_allocations(true);
+        ::std::size_t allocs;
+        {
+            allocation_counter cnt;
+            for (::std::size_t j = 0; j < 1000; ++j) {
+                f(j);
+            }
+            allocs = cnt.count();
+        }
+        ::std::cout << ::std::setw(24) << ::std::left << name << ::std::right
+                << ::std::fixed << ::std::setprecision(1)
+                << ::std::setw(12) << ns
+                << ::std::setw(12) << allocs / 1000.0 << "\n";
+    };
+    report("message::str", [&](::std::size_t i)
+    {
+        auto str = message{ids[i % 3]}.str(locales[i % locales.size()]);
+        do_not_optimize(str);
+    });
+    report("prerendered str", [&](::std::size_t i)
+    {
+        auto const& str = prerendered.str(ids[i % 3], locales[i % locales.size()]);
+        do_not_optimize(str);
+    });
+    report("prerendered by index", [&](::std::size_t i)
+    {
+        auto str = prerendered.find(ids[i % 3], i % locales.size());
+        do_not_optimize(str);
+    });
+}
+
+}  /* namespace bench */
+}  /* namespace l10n */
+}  /* namespace psst */
+
+int
+main(int, char*[])
+{
+    psst::l10n::bench::run();
+    return 0;
+}
@@ -0,0 +1,121 @@
+/*
+ * typed_message_bench.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: zmij
+ */
+
+#include <pushkin/l10n/typed_message.hpp>
+#include "bench_util.hpp"
+
+#include <iomanip>
+#include <iostream>
+
+namespace psst {
+namespace l10n {
+namespace bench {
+
+namespace {
+
+::std::size_t const ITERATIONS = 200000;
+
+constexpr message_template<::std::string, int, ::std::string> received{
+        "{1} received {2} from {3}"};
+constexpr message_template<int, ::std::string> files{
+        "{1} file in {2}", "{1} files in {2}", plural_message};
+
+/**
+ * Create and render a message, with the message class and with a typed
+ * message
+ */
+template < typename MakeMessage, typename MakeTyped >
+void
+compare(char const* name, ::std::locale const& loc, MakeMessage make_message,
+        MakeTyped make_typed)
+{
+    ::std::string buffer;
+    if (make_message().render(buffer, loc) != make_typed().str(loc)) {
+        ::std::cerr << "Results differ for " << name << "\n";
+    }
+    count_allocations(false);
+    auto message_ns = measure(ITERATIONS, [&]()
+    {
+        buffer.clear();
+        make_message().render(buffer, loc);
+        do_not_optimize(buffer);
+    });
+    auto typed_ns = measure(ITERATIONS, [&]()
+    {
+        buffer.clear();
+        make_typed().render(buffer, loc);
+        do_not_optimize(buffer);
+    });
+    count_allocations(true);
+    ::std::size_t message_allocs, typed_allocs;
+    {
+        allocation_counter cnt;
+        buffer.clear();
+        make_message().render(buffer, loc);
+        message_allocs = cnt.count();
+    }
+    {
+        allocation_counter cnt;
+        buffer.clear();
+        make_typed().render(buffer, loc);
+        typed_allocs = cnt.count();
+    }
+    ::std::cout << ::std::setw(30) << ::std::left << name
+            << ::std::right << ::std::fixed << ::std::setprecision(1)
+            << ::std::setw(12) << message_ns
+            << ::std::setw(12) << typed_ns
+            << ::std::setw(10) << message_ns / typed_ns
+            << ::std::setw(10) << message_allocs
+            << ::std::setw(10) << typed_allocs << "\n";
+}
+
+}  /* namespace  */
+
+void
+run()
+{
+    print_header("create and render message, typed message");
+    ::boost::locale::generator gen;
+    auto loc = gen("en_US.UTF-8");
+    ::std::cout << ::std::setw(30) << ::std::left << "message"
+            << ::std::right
+            << ::std::setw(12) << "message ns"
+            << ::std::setw(12) << "typed ns"
+            << ::std::setw(10) << "speedup"
+            << ::std::setw(10) << "allocs"
+            << ::std::setw(10) << "typed" << "\n";
+    ::std::string name = "Somebody";
+    ::std::string what = "a message";
+    ::std::string dir = "/tmp";
+    compare("simple, 3 arguments", loc,
+        [&]()
+        {
+            message msg{"{1} received {2} from {3}"};
+            msg << name << 42 << what;
+            return msg;
+        },
+        [&]() { return received(name, 42, what); });
+    compare("plural, 2 arguments", loc,
+        [&]()
+        {
+            message msg{"{1} file in {2}", "{1} files in {2}", 5};
+            msg << dir;
+            return msg;
+        },
+        [&]() { return files(5, dir); });
+}
+
+}  /* namespace bench */
+}  /* namespace l10n */
+}  /* namespace psst */
+
+int
+main(int, char*[])
+{
+    psst::l10n::bench::run();
+    return 0;
+}
@@ -41,6 +41,19 @@ if (NOT L10N_MSGMERGE_SCRIPT)
         message(FATAL_ERROR "Failed to find CMake script for merging gettext message files")
     endif()
 endif()
+if (NOT L10N_MESSAGE_IDS_SCRIPT)
+    find_file(
+        L10N_MESSAGE_IDS_SCRIPT message_ids.cmake
+        NO_DEFAULT_PATH
+        HINTS
+            ${CMAKE_SOURCE_DIR}/cmake/scripts
+            ${CMAKE_SOURCE_DIR}/lib/l10n/cmake/scripts    # When in a subproject
+        DOC "CMake script for generating message ids from gettext template files"
+    )
+    if (NOT L10N_MESSAGE_IDS_SCRIPT)
+        message(FATAL_ERROR "Failed to find CMake script for generating message ids")
+    endif()
+endif()
 
 function(l10n_project)
     set(argnames
@@ -172,6 +185,50 @@ function(msgmerge DOMAIN POT_FILE)
     endforeach()
 endfunction()
 
+#
+# Generate a header with dense integer ids of messages in a .pot file.
+# Every message gets a ::psst::l10n::message_id constant, messages
+# constructed from the ids are translated by index in per-locale arrays.
+# usage
+# generate_message_ids(
+#     DOMAIN <domain> POT_FILE <pot file> HEADER <header>
+#     [NAMESPACE <c++ namespace, domain name by default>]
+#     [TARGET <target depending on the header>]
+# )
+#
+function(generate_message_ids)
+    set(argnames DOMAIN POT_FILE HEADER NAMESPACE TARGET)
+    # Don't append to variables of the caller, e.g. extract_l10n
+    foreach(arg_name ${argnames})
+        unset(${arg_name})
+    endforeach()
+    parse_argn("" argnames ${ARGN})
+    if (NOT DOMAIN)
+        message(FATAL_ERROR "No domain specified for message ids")
+    endif()
+    if (NOT POT_FILE OR NOT HEADER)
+        message(FATAL_ERROR "POT file and header must be specified for message ids")
+    endif()
+    if (NOT NAMESPACE)
+        set(NAMESPACE ${DOMAIN})
+    endif()
+    add_custom_command(
+        OUTPUT ${HEADER}
+        COMMENT "Generate message ids for domain ${DOMAIN}"
+        DEPENDS ${POT_FILE} ${L10N_MESSAGE_IDS_SCRIPT}
+        COMMAND ${CMAKE_COMMAND} -DPOT_FILE=${POT_FILE} -DHEADER=${HEADER}
+                -DDOMAIN=${DOMAIN} -DNAMESPACE=${NAMESPACE}
+                -P ${L10N_MESSAGE_IDS_SCRIPT}
+    )
+    add_custom_target(
+        ${DOMAIN}.ids
+        DEPENDS ${HEADER}
+    )
+    if (TARGET)
+        add_dependencies(${TARGET} ${DOMAIN}.ids)
+    endif()
+endfunction()
+
 function(extract_l10n)
     set(argnames
         PROGRAM OPTIONS
@@ -179,6 +236,7 @@ function(extract_l10n)
         WORKING_DIRECTORY
         PACKAGE PACKAGE_VERSION COPYRIGHT BUGS
         INSTALL TEST_TRANSLATION
+        IDS_HEADER IDS_NAMESPACE
     )
     parse_argn("" argnames ${ARGN})
 
@@ -260,6 +318,16 @@ function(extract_l10n)
         add_dependencies(${PACKAGE}.i18n ${l10n_target})
     endif()
 
+    if (IDS_HEADER)
+        generate_message_ids(
+            DOMAIN ${DOMAIN}
+            POT_FILE ${out_file_name}
+            HEADER ${IDS_HEADER}
+            NAMESPACE ${IDS_NAMESPACE}
+        )
+        add_dependencies(${l10n_target} ${DOMAIN}.ids)
+    endif()
+
     if (NOT L10N_DOMAINS)
         set(L10N_DOMAINS ${DOMAIN})
     else()
@@ -0,0 +1,235 @@
+# Generate a header with dense message ids from a .pot file
+#
+# Usage:
+# cmake -DPOT_FILE=<pot file> -DHEADER=<header> -DDOMAIN=<domain>
+#       -DNAMESPACE=<c++ namespace> -P message_ids.cmake
+#
+# Id of a message is it's index in the .pot file, so ids are stable while
+# the .pot file doesn't change and are dense. For every message the header
+# defines a ::psst::l10n::message_id constant, named after the message
+# context and id. Names that are not unique get a numeric suffix.
+# The message table is returned by function table_(), count of messages
+# is count_. The helpers end with an underscore, so they never clash with
+# message names.
+
+cmake_minimum_required(VERSION 3.4)
+
+if (NOT POT_FILE OR NOT HEADER)
+    message(FATAL_ERROR "POT_FILE and HEADER must be set for generating message ids")
+endif()
+if (NOT DOMAIN)
+    get_filename_component(DOMAIN ${POT_FILE} NAME_WE)
+endif()
+if (NOT NAMESPACE)
+    set(NAMESPACE ${DOMAIN})
+endif()
+
+set(cxx_keywords
+    alignas alignof and and_eq asm auto bitand bitor bool break case catch
+    char char16_t char32_t class compl const constexpr const_cast continue
+    decltype default delete do double dynamic_cast else enum explicit
+    export extern false float for friend goto if inline int long mutable
+    namespace new noexcept not not_eq nullptr operator or or_eq private
+    protected public register reinterpret_cast return short signed sizeof
+    static static_assert static_cast struct switch template this
+    thread_local throw true try typedef typeid typename union unsigned
+    using virtual void volatile wchar_t while xor xor_eq
+)
+
+# Lines of the file are split to a list. Semicolons and brackets in
+# strings would break the list, they are replaced while parsing.
+file(READ ${POT_FILE} pot_contents)
+string(REPLACE "\r" "" pot_contents "${pot_contents}")
+string(REPLACE ";" "@L10N_SEMICOLON@" pot_contents "${pot_contents}")
+string(REPLACE "[" "@L10N_LBRACKET@" pot_contents "${pot_contents}")
+string(REPLACE "]" "@L10N_RBRACKET@" pot_contents "${pot_contents}")
+string(REPLACE "\n" ";" pot_lines "${pot_contents}")
+
+# Convert a string from the .pot file to a C++ string literal.
+# Escape sequences of .pot files are the same as in C++.
+function(cxx_literal OUT STR)
+    string(REPLACE "@L10N_SEMICOLON@" ";" STR "${STR}")
+    string(REPLACE "@L10N_LBRACKET@" "[" STR "${STR}")
+    string(REPLACE "@L10N_RBRACKET@" "]" STR "${STR}")
+    # Avoid trigraphs
+    string(REPLACE "??" "?\\?" STR "${STR}")
+    set(${OUT} "\"${STR}\"" PARENT_SCOPE)
+endfunction()
+
+# Make a C++ identifier from message context and id
+function(message_name OUT CTX ID)
+    set(name "${ID}")
+    if (NOT CTX STREQUAL "")
+        set(name "${CTX}_${ID}")
+    endif()
+    string(REGEX REPLACE "@L10N_[A-Z]+@" "_" name "${name}")
+    string(REGEX REPLACE "\\\\." "_" name "${name}")
+    string(TOLOWER "${name}" name)
+    string(REGEX REPLACE "[^a-z0-9]+" "_" name "${name}")
+    string(LENGTH "${name}" len)
+    if (len GREATER 48)
+        string(SUBSTRING "${name}" 0 48 name)
+    endif()
+    string(REGEX REPLACE "^_+" "" name "${name}")
+    string(REGEX REPLACE "_+$" "" name "${name}")
+    list(FIND cxx_keywords "${name}" kw)
+    if (name STREQUAL "" OR name MATCHES "^[0-9]" OR NOT kw LESS 0)
+        set(name "msg_${name}")
+        string(REGEX REPLACE "_+$" "" name "${name}")
+    endif()
+    set(${OUT} ${name} PARENT_SCOPE)
+endfunction()
+
+set(entries "")
+set(constants "")
+set(names "")
+set(count 0)
+
+set(field "")
+set(in_msgstr FALSE)
+set(msgctxt "")
+set(msgid "")
+set(msgid_plural "")
+set(has_msgctxt FALSE)
+set(has_msgid FALSE)
+set(has_plural FALSE)
+
+macro(add_entry)
+    # Header entry has an empty id
+    if (has_msgid AND NOT msgid STREQUAL "")
+        if (has_msgctxt)
+            cxx_literal(ctx_literal "${msgctxt}")
+        else()
+            set(ctx_literal "nullptr")
+        endif()
+        cxx_literal(id_literal "${msgid}")
+        if (has_plural)
+            cxx_literal(plural_literal "${msgid_plural}")
+        else()
+            set(plural_literal "nullptr")
+        endif()
+        string(APPEND entries
+            "        { ${ctx_literal}, ${id_literal}, ${plural_literal} },\n")
+
+        message_name(name "${msgctxt}" "${msgid}")
+        set(unique_name ${name})
+        set(suffix 1)
+        list(FIND names ${unique_name} found)
+        while (NOT found LESS 0)
+            math(EXPR suffix "${suffix} + 1")
+            set(unique_name ${name}_${suffix})
+            list(FIND names ${unique_name} found)
+        endwhile()
+        list(APPEND names ${unique_name})
+        string(APPEND constants
+            "constexpr ::psst::l10n::message_id ${unique_name}{ &table_, ${count} };\n")
+        math(EXPR count "${count} + 1")
+    endif()
+    set(msgctxt "")
+    set(msgid "")
+    set(msgid_plural "")
+    set(has_msgctxt FALSE)
+    set(has_msgid FALSE)
+    set(has_plural FALSE)
+    set(in_msgstr FALSE)
+    set(field "")
+endmacro()
+
+foreach(line IN LISTS pot_lines)
+    string(STRIP "${line}" line)
+    if (line MATCHES "^#" OR line STREQUAL "")
+        # Comments and obsolete entries
+        continue()
+    endif()
+    if (line MATCHES "^(msgctxt|msgid|msgid_plural|msgstr(@L10N_LBRACKET@[0-9]+@L10N_RBRACKET@)?)[ \t]+\"(.*)\"$")
+        set(keyword ${CMAKE_MATCH_1})
+        set(value "${CMAKE_MATCH_3}")
+        if (keyword MATCHES "^msgstr")
+            set(in_msgstr TRUE)
+            set(field "")
+        else()
+            if (in_msgstr AND NOT keyword STREQUAL "msgid_plural")
+                add_entry()
+            endif()
+            set(field ${keyword})
+            if (keyword STREQUAL "msgctxt")
+                set(has_msgctxt TRUE)
+            elseif (keyword STREQUAL "msgid")
+                set(has_msgid TRUE)
+            else()
+                set(has_plural TRUE)
+            endif()
+            set(${field} "${value}")
+        endif()
+    elseif (line MATCHES "^\"(.*)\"$")
+        if (field)
+            string(APPEND ${field} "${CMAKE_MATCH_1}")
+        endif()
+    else()
+        message(FATAL_ERROR "Unexpected line in ${POT_FILE}: ${line}")
+    endif()
+endforeach()
+add_entry()
+
+get_filename_component(header_name ${HEADER} NAME)
+get_filename_component(pot_name ${POT_FILE} NAME)
+string(TOUPPER "${header_name}" guard)
+string(REGEX REPLACE "[^A-Z0-9]" "_" guard "${guard}")
+set(guard "L10N_GENERATED_${guard}_")
+
+string(REPLACE "::" ";" namespaces "${NAMESPACE}")
+set(ns_open "")
+set(ns_close "")
+foreach(ns ${namespaces})
+    string(APPEND ns_open "namespace ${ns} {\n")
+    set(ns_close "}  /* namespace ${ns} */\n${ns_close}")
+endforeach()
+
+if (count EQUAL 0)
+    set(table_init "nullptr, 0")
+    set(entries_def "")
+else()
+    set(table_init "entries, ${count}")
+    set(entries_def
+"    static ::psst::l10n::message_entry const entries[] {\n${entries}    };\n")
+endif()
+
+set(contents
+"/*
+ * ${header_name}
+ *
+ * Message ids of domain ${DOMAIN}, generated from ${pot_name}.
+ * Don't edit, the file is regenerated when the .pot file changes.
+ */
+
+#ifndef ${guard}
+#define ${guard}
+
+#include <pushkin/l10n/message_id.hpp>
+
+#include <cstddef>
+
+${ns_open}
+inline ::psst::l10n::message_table const&
+table_()
+{
+${entries_def}    static ::psst::l10n::message_table const table{ \"${DOMAIN}\", ${table_init} };
+    return table;
+}
+
+constexpr ::std::size_t count_ = ${count};
+
+${constants}
+${ns_close}
+#endif /* ${guard} */
+")
+
+# Don't touch the header if nothing changed, so that dependent sources
+# are not rebuilt
+if (EXISTS ${HEADER})
+    file(READ ${HEADER} old_contents)
+    if (old_contents STREQUAL contents)
+        return()
+    endif()
+endif()
+file(WRITE ${HEADER} "${contents}")
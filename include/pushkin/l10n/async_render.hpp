@@ -0,0 +1,128 @@
+/*
+ * async_render.hpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: zmij
+ */
+
+#ifndef PUSHKIN_L10N_ASYNC_RENDER_HPP_
+#define PUSHKIN_L10N_ASYNC_RENDER_HPP_
+
+#include <pushkin/l10n/message.hpp>
+
+#include <chrono>
+#include <functional>
+#include <future>
+#include <locale>
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+namespace psst {
+namespace l10n {
+
+/**
+ * Executor of rendering tasks. The executor must call the task once,
+ * in any thread, or destroy it without calling.
+ */
+using executor = ::std::function<void(::std::function<void()>)>;
+
+/**
+ * Exception reported by a render handle if rendering was cancelled
+ * or the executor destroyed the task without running it.
+ */
+class render_cancelled : public ::std::runtime_error {
+public:
+    render_cancelled() : ::std::runtime_error{"Message rendering cancelled"} {}
+};
+
+namespace detail {
+
+struct async_render_state;
+
+}  /* namespace detail */
+
+/**
+ * Handle of a message rendered by an executor
+ */
+class render_handle {
+public:
+    render_handle() = default;
+    render_handle(render_handle&&) = default;
+    render_handle&
+    operator = (render_handle&&) = default;
+
+    /**
+     * The handle refers to a rendering and the result was not taken yet
+     */
+    bool
+    valid() const
+    { return future_.valid(); }
+    /**
+     * The result is available, get won't block
+     */
+    bool
+    ready() const
+    {
+        return future_.wait_for(::std::chrono::seconds{0}) ==
+                ::std::future_status::ready;
+    }
+    void
+    wait() const
+    { future_.wait(); }
+    template < typename Rep, typename Period >
+    ::std::future_status
+    wait_for(::std::chrono::duration<Rep, Period> const& timeout) const
+    { return future_.wait_for(timeout); }
+
+    /**
+     * Wait for the rendered string and take it. Throws render_cancelled
+     * if the rendering was cancelled, or the exception thrown by
+     * rendering.
+     */
+    ::std::string
+    get()
+    { return future_.get(); }
+
+    /**
+     * Cancel the rendering if it hasn't started yet. The result of a
+     * cancelled rendering is ready at once. Rendering that has started
+     * is not interrupted.
+     * @return true if the rendering was cancelled
+     */
+    bool
+    cancel();
+    /**
+     * The rendering was cancelled by the handle or dropped by the executor
+     */
+    bool
+    cancelled() const;
+private:
+    using state_ptr = ::std::shared_ptr<detail::async_render_state>;
+
+    render_handle(::std::future<::std::string>&& future, state_ptr const& state)
+        : future_{::std::move(future)}, state_{state} {}
+
+    friend render_handle
+    render_async(message const&, ::std::locale const&, executor const&);
+
+    ::std::future<::std::string>    future_;
+    state_ptr                       state_;
+};
+
+/**
+ * Render a message in an executor. The message and the locale are copied
+ * to the task. The output is the same as message::str produces.
+ * If the executor throws, the exception is reported by the handle.
+ * @param msg
+ * @param loc
+ * @param exec
+ * @return Handle to the rendered string
+ */
+render_handle
+render_async(message const& msg, ::std::locale const& loc, executor const& exec);
+
+}  /* namespace l10n */
+}  /* namespace psst */
+
+#endif /* PUSHKIN_L10N_ASYNC_RENDER_HPP_ */
@@ -0,0 +1,98 @@
+/*
+ * catalog_registry.hpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: zmij
+ */
+
+#ifndef PUSHKIN_L10N_CATALOG_REGISTRY_HPP_
+#define PUSHKIN_L10N_CATALOG_REGISTRY_HPP_
+
+#include <pushkin/l10n/mo_catalog.hpp>
+
+#include <cstddef>
+#include <future>
+#include <locale>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace psst {
+namespace l10n {
+
+/**
+ * Registry of locales with memory mapped message catalogs that can be
+ * reloaded while the program runs.
+ *
+ * The locales are published as immutable versions. Getting a locale
+ * doesn't take any locks: a thread marks the version it reads in
+ * a per-thread slot, and a replaced version is destroyed when no thread
+ * reads it. Threads don't keep versions after reading them.
+ * A locale that was got from the registry keeps using the catalogs of
+ * it's version, so renders in progress are not affected by a reload,
+ * the old catalogs are unmapped when the last such locale is destroyed.
+ * A reload also releases the locales cached by threads for rendering.
+ *
+ * Catalog files should be replaced by renaming a new file over the old
+ * one, overwriting a mapped file in place changes the old version too.
+ */
+class catalog_registry {
+public:
+    using string_list = ::std::vector<::std::string>;
+public:
+    /**
+     * @param paths     Directories to search for catalogs
+     * @param domains   Message domains, the first is the default one
+     */
+    catalog_registry(string_list const& paths, string_list const& domains);
+    ~catalog_registry();
+
+    catalog_registry(catalog_registry const&) = delete;
+    catalog_registry&
+    operator = (catalog_registry const&) = delete;
+
+    /**
+     * Get a locale from the current version. A locale is loaded on first
+     * request, this publishes a new version.
+     * @param locale_name   Locale name, e.g. ru_RU.UTF-8
+     * @return
+     */
+    ::std::locale
+    get(::std::string const& locale_name) const;
+
+    /**
+     * Load catalogs of all locales in the registry again and publish
+     * them as a new version. If a catalog fails to load, the exception
+     * is propagated and the current version stays in use.
+     * Renders started after the call returns use the new catalogs.
+     */
+    void
+    reload();
+    /**
+     * Reload catalogs in a background thread
+     * @return Future to wait for the reload and get the exception if any
+     */
+    ::std::future<void>
+    reload_async();
+
+    /**
+     * Number of the current version, incremented each time a new
+     * version is published
+     */
+    ::std::size_t
+    version() const;
+    /**
+     * Names of locales in the current version
+     */
+    string_list
+    locales() const;
+private:
+    struct impl;
+    using pimpl = ::std::shared_ptr<impl>;
+    pimpl pimpl_;
+};
+
+}  /* namespace l10n */
+}  /* namespace psst */
+
+#endif /* PUSHKIN_L10N_CATALOG_REGISTRY_HPP_ */
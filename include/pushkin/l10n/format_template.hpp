@@ -0,0 +1,221 @@
+/*
+ * format_template.hpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: zmij
+ */
+
+#ifndef PUSHKIN_L10N_FORMAT_TEMPLATE_HPP_
+#define PUSHKIN_L10N_FORMAT_TEMPLATE_HPP_
+
+#include <pushkin/l10n/interned_string.hpp>
+
+#include <cstddef>
+#include <iosfwd>
+#include <locale>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace psst {
+namespace l10n {
+
+/**
+ * Format string parsed into literal segments and argument slots.
+ * The syntax is the one of ::boost::locale::format: {1}, {2,num},
+ * {3,ftime='%H:%M'}, {{ and }} for literal braces.
+ * The template is parsed once and can be rendered many times, the
+ * literal segments refer to the source string.
+ */
+class format_template {
+public:
+    /** Slot index when an argument position was not specified */
+    static constexpr unsigned no_argument = static_cast<unsigned>(-1);
+
+    /**
+     * Formatting option of an argument slot, e.g. `num` or `ftime='%H'`
+     */
+    struct option {
+        ::std::string   key;
+        ::std::string   value;
+        bool            quoted;
+    };
+    using options       = ::std::vector<option>;
+
+    /**
+     * Literal text followed by an optional argument slot
+     */
+    struct segment {
+        ::std::size_t   offset;
+        ::std::size_t   size;
+        /** Zero-based index of argument, no_argument if none */
+        unsigned        argument;
+        /** Index of slot options, -1 if the slot has no options */
+        int             options;
+        /** The segment ends with a slot */
+        bool            has_slot;
+    };
+    using segments      = ::std::vector<segment>;
+
+    /**
+     * Arguments to render the template with
+     */
+    struct arguments {
+        virtual ~arguments() = default;
+        virtual ::std::size_t
+        size() const = 0;
+        /**
+         * Argument can be written without saving and restoring the stream
+         * state, i.e. it is a builtin type that doesn't alter the stream.
+         */
+        virtual bool
+        is_plain(::std::size_t idx) const = 0;
+        virtual void
+        write(::std::ostream&, ::std::size_t idx) const = 0;
+        /**
+         * Append the argument to a string without a stream
+         * @return false if the argument must be written to a stream
+         */
+        virtual bool
+        append(::std::string&, ::std::size_t, ::std::locale const&) const
+        { return false; }
+        /**
+         * Message domain id to write the arguments to a stream with
+         */
+        virtual int
+        domain_id(::std::locale const&) const
+        { return 0; }
+    };
+public:
+    explicit
+    format_template(interned_string const& str);
+
+    interned_string const&
+    str() const
+    { return str_; }
+
+    segments const&
+    get_segments() const
+    { return segments_; }
+    options const&
+    get_options(segment const& seg) const
+    { return options_[seg.options]; }
+    /**
+     * The template has argument slots
+     */
+    bool
+    has_slots() const
+    { return slots_ > 0; }
+
+    /**
+     * Output the template with arguments to a stream
+     * @param os
+     * @param args
+     */
+    void
+    write(::std::ostream& os, arguments const& args) const;
+    /**
+     * Append the template with arguments to a string.
+     * Arguments that cannot be appended directly, and arguments in slots
+     * with options are written via a temporary stream.
+     * @param out
+     * @param args
+     * @param loc Locale for the arguments
+     */
+    void
+    render(::std::string& out, arguments const& args,
+            ::std::locale const& loc) const;
+    /**
+     * Append the template with arguments of types known at compile time.
+     * The arguments object has the same interface as arguments, but the
+     * functions are not virtual and are called directly.
+     * @param out
+     * @param args
+     * @param loc Locale for the arguments
+     */
+    template < typename Arguments >
+    typename ::std::enable_if<
+        !::std::is_base_of<arguments, Arguments>::value >::type
+    render(::std::string& out, Arguments const& args,
+            ::std::locale const& loc) const
+    {
+        char const* format = str_.str().data();
+        for (auto const& seg : segments_) {
+            if (seg.size > 0)
+                out.append(format + seg.offset, seg.size);
+            if (!seg.has_slot)
+                continue;
+            if (seg.options < 0 && (seg.argument >= args.size() ||
+                    args.append(out, seg.argument, loc)))
+                continue;
+            bool valid = seg.argument < args.size();
+            render_slot(out, seg, loc, args.domain_id(loc),
+                    valid && args.is_plain(seg.argument),
+                    valid ? &write_argument<Arguments> : nullptr, &args);
+        }
+    }
+
+    /**
+     * Append an integer as a stream imbued with the locale would write it,
+     * if the locale writes numbers without grouping.
+     * @return false if the number must be written to a stream
+     */
+    static bool
+    append_integer(::std::string& out, long long val, ::std::locale const& loc);
+    static bool
+    append_integer(::std::string& out, unsigned long long val,
+            ::std::locale const& loc);
+    /**
+     * Append a floating point number as a stream imbued with the locale
+     * would write it, if the locale writes numbers without grouping.
+     * @return false if the number must be written to a stream
+     */
+    static bool
+    append_double(::std::string& out, double val, ::std::locale const& loc);
+private:
+    /**
+     * Function writing an argument from an arguments object
+     */
+    using write_func = void (*)(::std::ostream&, void const* args,
+            ::std::size_t idx);
+
+    template < typename Arguments >
+    static void
+    write_argument(::std::ostream& os, void const* args, ::std::size_t idx)
+    {
+        static_cast<Arguments const*>(args)->write(os, idx);
+    }
+
+    /**
+     * Write an argument to a slot, applying the slot options
+     * @param os
+     * @param seg
+     * @param plain The argument can be written without options
+     * @param write Function to write the argument, nullptr if there
+     *              is no argument for the slot
+     * @param args
+     */
+    void
+    write_slot(::std::ostream& os, segment const& seg, bool plain,
+            write_func write, void const* args) const;
+    /**
+     * Append an argument to a string via a temporary stream
+     */
+    void
+    render_slot(::std::string& out, segment const& seg,
+            ::std::locale const& loc, int domain_id, bool plain,
+            write_func write, void const* args) const;
+private:
+    interned_string         str_;
+    segments                segments_;
+    ::std::vector<options>  options_;
+    ::std::size_t           slots_;
+};
+
+using format_template_ptr = ::std::shared_ptr<format_template const>;
+
+}  /* namespace l10n */
+}  /* namespace psst */
+
+#endif /* PUSHKIN_L10N_FORMAT_TEMPLATE_HPP_ */
@@ -0,0 +1,150 @@
+/*
+ * interned_string.hpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: zmij
+ */
+
+#ifndef PUSHKIN_L10N_INTERNED_STRING_HPP_
+#define PUSHKIN_L10N_INTERNED_STRING_HPP_
+
+#include <string>
+#include <cstddef>
+#include <iosfwd>
+#include <functional>
+
+namespace psst {
+namespace l10n {
+
+/**
+ * Handle to an immutable string stored in a process-wide pool.
+ * Equal strings share the same pool entry, so copying a handle is a
+ * refcount increment and equality check is a pointer comparison.
+ * The entry is removed from the pool when the last handle is destroyed.
+ *
+ * A default-constructed handle is null, it is different from a handle to
+ * an empty string.
+ */
+class interned_string {
+public:
+    /** Pool entry, opaque to users */
+    struct entry;
+public:
+    interned_string() noexcept : entry_{nullptr} {}
+    explicit
+    interned_string(::std::string const&);
+    explicit
+    interned_string(char const*);
+    interned_string(interned_string const& rhs) noexcept;
+    interned_string(interned_string&& rhs) noexcept
+        : entry_{rhs.entry_}
+    {
+        rhs.entry_ = nullptr;
+    }
+    ~interned_string();
+
+    void
+    swap(interned_string& rhs) noexcept
+    {
+        ::std::swap(entry_, rhs.entry_);
+    }
+
+    interned_string&
+    operator = (interned_string const& rhs) noexcept
+    {
+        interned_string tmp{rhs};
+        swap(tmp);
+        return *this;
+    }
+    interned_string&
+    operator = (interned_string&& rhs) noexcept
+    {
+        interned_string tmp{::std::move(rhs)};
+        swap(tmp);
+        return *this;
+    }
+
+    bool
+    is_null() const
+    { return entry_ == nullptr; }
+    bool
+    empty() const
+    { return str().empty(); }
+
+    /**
+     * Get the string value. A null handle returns an empty string.
+     * @return
+     */
+    ::std::string const&
+    str() const;
+    ::std::size_t
+    size() const
+    { return str().size(); }
+    /**
+     * Hash of the string value, computed once when the string is interned.
+     * @return
+     */
+    ::std::size_t
+    hash() const;
+
+    /**
+     * Memory used by the string entry divided by count of handles to it.
+     * @return
+     */
+    ::std::size_t
+    memory_usage() const;
+
+    /**
+     * Compare handles. As equal strings share the same entry, this is
+     * equivalent to comparing strings.
+     * @param rhs
+     * @return
+     */
+    bool
+    operator == (interned_string const& rhs) const
+    { return entry_ == rhs.entry_; }
+    bool
+    operator != (interned_string const& rhs) const
+    { return entry_ != rhs.entry_; }
+    /**
+     * Lexicographical order of string values, a null handle is less than
+     * any other.
+     * @param rhs
+     * @return
+     */
+    bool
+    operator < (interned_string const& rhs) const;
+
+    /**
+     * Count of distinct strings currently in the pool
+     * @return
+     */
+    static ::std::size_t
+    pool_size();
+private:
+    entry* entry_;
+};
+
+::std::ostream&
+operator << (::std::ostream& os, interned_string const& val);
+
+}  /* namespace l10n */
+}  /* namespace psst */
+
+namespace std {
+
+template <>
+struct hash<::psst::l10n::interned_string> {
+    using argument_type = ::psst::l10n::interned_string;
+    using result_type   = ::std::size_t;
+
+    result_type
+    operator()(argument_type const& v) const
+    {
+        return v.hash();
+    }
+};
+
+}  /* namespace std */
+
+#endif /* PUSHKIN_L10N_INTERNED_STRING_HPP_ */
@@ -0,0 +1,283 @@
+/*
+ * lru_cache.hpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: zmij
+ */
+
+#ifndef PUSHKIN_L10N_LRU_CACHE_HPP_
+#define PUSHKIN_L10N_LRU_CACHE_HPP_
+
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace psst {
+namespace l10n {
+
+/**
+ * Cache statistics snapshot
+ */
+struct cache_stats {
+    ::std::size_t   size;
+    ::std::size_t   capacity;
+    ::std::size_t   hits;
+    ::std::size_t   misses;
+    ::std::size_t   evictions;
+
+    double
+    hit_rate() const
+    {
+        auto total = hits + misses;
+        return total ? static_cast<double>(hits) / total : 0.0;
+    }
+};
+
+/**
+ * Thread-safe cache with least recently used eviction policy.
+ * The cache is split into shards by key hash, each shard has it's own
+ * lock and holds an equal part of the capacity.
+ * A cache with zero capacity doesn't store anything.
+ */
+template < typename Key, typename Value,
+        typename Hash = ::std::hash<Key>,
+        typename KeyEqual = ::std::equal_to<Key> >
+class lru_cache {
+public:
+    using key_type          = Key;
+    using value_type        = Value;
+    using hasher            = Hash;
+    using key_equal         = KeyEqual;
+
+    static constexpr ::std::size_t default_shards = 16;
+public:
+    explicit
+    lru_cache(::std::size_t capacity, ::std::size_t shards = default_shards)
+        : shards_(shards ? shards : 1), capacity_{capacity},
+          hits_{0}, misses_{0}, evictions_{0}
+    {
+        set_capacity(capacity);
+    }
+
+    lru_cache(lru_cache const&) = delete;
+    lru_cache&
+    operator = (lru_cache const&) = delete;
+
+    /**
+     * Get a cached value for the key or create a new one.
+     * The create function is called without holding a lock, so
+     * concurrent misses on the same key may call it more than once,
+     * only one result is stored.
+     * @param key
+     * @param create    Function to create a value
+     * @return
+     */
+    template < typename Create >
+    value_type
+    get(key_type const& key, Create create)
+    {
+        auto h = hasher{}(key);
+        auto& s = shard_for(h);
+        {
+            lock_type lock{s.mtx};
+            auto f = s.index.find(key);
+            if (f != s.index.end()) {
+                s.entries.splice(s.entries.begin(), s.entries, f->second);
+                hits_.fetch_add(1, ::std::memory_order_relaxed);
+                return f->second->second;
+            }
+        }
+        misses_.fetch_add(1, ::std::memory_order_relaxed);
+        value_type val = create();
+        insert(s, key, val);
+        return val;
+    }
+
+    /**
+     * Find a value for the key
+     * @param key
+     * @param val   Value to assign the cached value to
+     * @return true if the value is found
+     */
+    bool
+    find(key_type const& key, value_type& val)
+    {
+        auto& s = shard_for(hasher{}(key));
+        lock_type lock{s.mtx};
+        auto f = s.index.find(key);
+        if (f == s.index.end()) {
+            misses_.fetch_add(1, ::std::memory_order_relaxed);
+            return false;
+        }
+        s.entries.splice(s.entries.begin(), s.entries, f->second);
+        hits_.fetch_add(1, ::std::memory_order_relaxed);
+        val = f->second->second;
+        return true;
+    }
+
+    void
+    insert(key_type const& key, value_type const& val)
+    {
+        insert(shard_for(hasher{}(key)), key, val);
+    }
+
+    ::std::size_t
+    capacity() const
+    { return capacity_.load(::std::memory_order_relaxed); }
+
+    /**
+     * Change capacity of the cache. If the new capacity is less than the
+     * count of cached values, least recently used values are evicted.
+     * @param capacity
+     */
+    void
+    set_capacity(::std::size_t capacity)
+    {
+        capacity_.store(capacity, ::std::memory_order_relaxed);
+        // Distribute the remainder so that the total is exactly the capacity
+        auto per_shard = capacity / shards_.size();
+        auto remainder = capacity % shards_.size();
+        for (auto& s : shards_) {
+            lock_type lock{s.mtx};
+            s.capacity = per_shard + (remainder ? 1 : 0);
+            if (remainder)
+                --remainder;
+            evict(s);
+        }
+    }
+
+    ::std::size_t
+    size() const
+    {
+        ::std::size_t sz = 0;
+        for (auto& s : shards_) {
+            lock_type lock{s.mtx};
+            sz += s.index.size();
+        }
+        return sz;
+    }
+
+    /**
+     * Remove all cached values. Statistics counters are not reset.
+     */
+    void
+    clear()
+    {
+        for (auto& s : shards_) {
+            lock_type lock{s.mtx};
+            s.index.clear();
+            s.entries.clear();
+        }
+    }
+
+    /**
+     * Remove cached values with keys matching a predicate. Removed values
+     * are not counted as evictions.
+     * @param pred  Function taking a key
+     * @return Count of removed values
+     */
+    template < typename Predicate >
+    ::std::size_t
+    erase_if(Predicate pred)
+    {
+        ::std::size_t erased = 0;
+        for (auto& s : shards_) {
+            lock_type lock{s.mtx};
+            for (auto e = s.entries.begin(); e != s.entries.end();) {
+                if (pred(e->first)) {
+                    s.index.erase(e->first);
+                    e = s.entries.erase(e);
+                    ++erased;
+                } else {
+                    ++e;
+                }
+            }
+        }
+        return erased;
+    }
+
+    /**
+     * Reset hit, miss and eviction counters
+     */
+    void
+    reset_stats()
+    {
+        hits_.store(0, ::std::memory_order_relaxed);
+        misses_.store(0, ::std::memory_order_relaxed);
+        evictions_.store(0, ::std::memory_order_relaxed);
+    }
+
+    cache_stats
+    stats() const
+    {
+        return cache_stats {
+            size(),
+            capacity(),
+            hits_.load(::std::memory_order_relaxed),
+            misses_.load(::std::memory_order_relaxed),
+            evictions_.load(::std::memory_order_relaxed)
+        };
+    }
+private:
+    using mutex_type    = ::std::mutex;
+    using lock_type     = ::std::lock_guard<mutex_type>;
+    using entry_type    = ::std::pair<key_type, value_type>;
+    using entry_list    = ::std::list<entry_type>;
+    using entry_index   = ::std::unordered_map<key_type,
+            typename entry_list::iterator, hasher, key_equal>;
+
+    struct shard {
+        mutex_type mutable  mtx;
+        entry_list          entries;
+        entry_index         index;
+        ::std::size_t       capacity = 0;
+    };
+
+    shard&
+    shard_for(::std::size_t hash)
+    {
+        // Mix the hash, the low bits are used by the index of the shard
+        return shards_[(hash ^ (hash >> 16)) % shards_.size()];
+    }
+
+    void
+    insert(shard& s, key_type const& key, value_type const& val)
+    {
+        lock_type lock{s.mtx};
+        if (s.capacity == 0)
+            return;
+        auto f = s.index.find(key);
+        if (f != s.index.end())
+            return;
+        s.entries.emplace_front(key, val);
+        s.index.emplace(key, s.entries.begin());
+        evict(s);
+    }
+
+    void
+    evict(shard& s)
+    {
+        while (s.index.size() > s.capacity) {
+            s.index.erase(s.entries.back().first);
+            s.entries.pop_back();
+            evictions_.fetch_add(1, ::std::memory_order_relaxed);
+        }
+    }
+
+    ::std::vector<shard>            shards_;
+    ::std::atomic<::std::size_t>    capacity_;
+    ::std::atomic<::std::size_t>    hits_;
+    ::std::atomic<::std::size_t>    misses_;
+    ::std::atomic<::std::size_t>    evictions_;
+};
+
+}  /* namespace l10n */
+}  /* namespace psst */
+
+#endif /* PUSHKIN_L10N_LRU_CACHE_HPP_ */
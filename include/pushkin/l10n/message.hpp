@@ -12,11 +12,25 @@
 #include <memory>
 #include <iosfwd>
 #include <functional>
+#include <vector>
+#include <forward_list>
+#include <cstddef>
+#include <type_traits>
+#include <new>
+#include <atomic>
+#include <algorithm>
+#include <iterator>
+#include <locale>
+#include <stdexcept>
 
 #include <boost/optional.hpp>
 #include <boost/variant.hpp>
 #include <boost/locale.hpp>
 
+#include <pushkin/l10n/interned_string.hpp>
+#include <pushkin/l10n/message_id.hpp>
+#include <pushkin/l10n/static_placeholders.hpp>
+
 namespace psst {
 namespace l10n {
 
@@ -25,6 +39,9 @@ using message_list = ::std::vector<message>;
 
 namespace detail {
 
+class prepared_message;
+class batch_renderer;
+
 struct abstract_arg_value {
     using arg_ptr                   = ::std::unique_ptr<abstract_arg_value>;
     using formatted_message         = ::boost::locale::format;
@@ -33,10 +50,36 @@ struct abstract_arg_value {
 
     virtual arg_ptr
     clone() = 0;
+    /**
+     * Copy construct the value in a storage provided by caller.
+     * The storage must be big enough and suitably aligned.
+     * @param place
+     * @return Pointer to the constructed copy
+     */
+    virtual abstract_arg_value*
+    clone_to(void* place) const = 0;
+    /**
+     * Move construct the value in a storage provided by caller.
+     * @param place
+     * @return Pointer to the constructed value
+     */
+    virtual abstract_arg_value*
+    move_to(void* place) noexcept = 0;
     virtual void
     format(formatted_message&) const = 0;
+    /**
+     * Output the value to a stream
+     */
+    virtual void
+    write(::std::ostream&) const = 0;
     virtual void
     collect(message_list&) const {}
+    /**
+     * Size of the value object
+     */
+    virtual ::std::size_t
+    size() const
+    { return sizeof(abstract_arg_value); }
 };
 
 template < typename T >
@@ -64,42 +107,469 @@ struct arg_value : abstract_arg_value {
         return arg_ptr{ new arg_value{ *this } };
     }
 
+    abstract_arg_value*
+    clone_to(void* place) const override
+    {
+        return new (place) arg_value{ *this };
+    }
+
+    abstract_arg_value*
+    move_to(void* place) noexcept override
+    {
+        return new (place) arg_value{ ::std::move(*this) };
+    }
+
     void
     format(formatted_message& fmt) const override
     {
         fmt % value;
     }
+    void
+    write(::std::ostream& os) const override
+    {
+        os << value;
+    }
+
+    ::std::size_t
+    size() const override
+    { return sizeof(arg_value); }
 
     value_type value;
 };
 
-class message_args {
+/**
+ * Type of a value stored for an argument.
+ * C strings are stored as ::std::string, as the formatting is
+ * deferred and the pointer might be invalid by the time.
+ */
+template < typename T >
+struct stored_type {
+    using type = T;
+};
+
+template <>
+struct stored_type<char const*> {
+    using type = ::std::string;
+};
+
+template <>
+struct stored_type<char*> {
+    using type = ::std::string;
+};
+
+template < typename T >
+struct arg_type : stored_type< typename ::std::decay<T>::type > {};
+
+/**
+ * Holder for a type-erased argument value of a user type.
+ * Small values that are nothrow move constructible are stored in place,
+ * others are allocated on heap.
+ */
+class erased_arg {
 public:
-    using arg_holder        = ::std::unique_ptr<abstract_arg_value>;
+    static constexpr ::std::size_t inline_size  = 6 * sizeof(void*);
+    static constexpr ::std::size_t inline_align = alignof(::std::max_align_t);
+
+    template < typename T >
+    struct is_inline_value : ::std::integral_constant<bool,
+            sizeof(arg_value<T>) <= inline_size &&
+            alignof(arg_value<T>) <= inline_align &&
+            ::std::is_nothrow_move_constructible<T>::value> {};
+public:
+    erased_arg() noexcept : value_{nullptr} {}
+    template < typename T, typename ValueType = typename arg_type<T>::type,
+        typename = typename ::std::enable_if<
+            !::std::is_same<ValueType, erased_arg>::value >::type >
+    explicit
+    erased_arg(T&& v)
+        : value_{ construct<ValueType>(::std::forward<T>(v),
+                is_inline_value<ValueType>{}) }
+    {
+    }
+    erased_arg(erased_arg const& rhs);
+    erased_arg(erased_arg&& rhs) noexcept;
+    ~erased_arg()
+    {
+        clear();
+    }
+
+    void
+    swap(erased_arg& rhs) noexcept;
+
+    erased_arg&
+    operator = (erased_arg const& rhs)
+    {
+        erased_arg tmp{rhs};
+        swap(tmp);
+        return *this;
+    }
+    erased_arg&
+    operator = (erased_arg&& rhs) noexcept
+    {
+        erased_arg tmp{::std::move(rhs)};
+        swap(tmp);
+        return *this;
+    }
+
+    bool
+    empty() const
+    { return value_ == nullptr; }
+    /**
+     * @return true if the value is stored in place
+     */
+    bool
+    is_inline() const
+    { return value_ == inline_ptr(); }
+
+    abstract_arg_value const&
+    operator *() const
+    { return *value_; }
+    abstract_arg_value const*
+    operator ->() const
+    { return value_; }
+
+    void
+    clear() noexcept;
+private:
+    using storage_type = ::std::aligned_storage<inline_size, inline_align>::type;
+
+    void*
+    inline_ptr() const
+    { return const_cast<storage_type*>(&storage_); }
+
+    template < typename U, typename T >
+    abstract_arg_value*
+    construct(T&& v, ::std::true_type)
+    {
+        return new (inline_ptr()) arg_value<U>{ U(::std::forward<T>(v)) };
+    }
+    template < typename U, typename T >
+    abstract_arg_value*
+    construct(T&& v, ::std::false_type)
+    {
+        return new arg_value<U>{ U(::std::forward<T>(v)) };
+    }
+
+    storage_type        storage_;
+    abstract_arg_value* value_;
+};
+
+/**
+ * Pointer to a nested message argument. The nested message is immutable
+ * and shared between copies of the argument.
+ */
+class nested_message {
+public:
+    explicit
+    nested_message(message const&);
+    explicit
+    nested_message(message&&);
+
+    message const&
+    get() const
+    { return *msg_; }
+    long
+    use_count() const
+    { return msg_.use_count(); }
+private:
+    ::std::shared_ptr<message const> msg_;
+};
+
+/**
+ * Argument types that are stored and formatted without type erasure
+ */
+template < typename T >
+struct is_builtin_arg : ::std::false_type {};
+template <>
+struct is_builtin_arg<int> : ::std::true_type {};
+template <>
+struct is_builtin_arg<long> : ::std::true_type {};
+template <>
+struct is_builtin_arg<double> : ::std::true_type {};
+template <>
+struct is_builtin_arg<::std::string> : ::std::true_type {};
+
+/**
+ * Holder for an argument value.
+ * Most common argument types (int, long, double, ::std::string and
+ * nested messages) are held in a variant, so copying and formatting them
+ * doesn't involve virtual calls. Values of other types fall back to
+ * type erasure.
+ */
+class arg_holder {
+public:
+    using value_type = ::boost::variant< ::boost::blank,
+            int, long, double, ::std::string, nested_message, erased_arg >;
+    enum kind_type {
+        empty_value,
+        int_value,
+        long_value,
+        double_value,
+        string_value,
+        message_value,
+        erased_value
+    };
+public:
+    arg_holder() noexcept : value_{} {}
+    template < typename T, typename ValueType = typename arg_type<T>::type,
+        typename = typename ::std::enable_if<
+            !::std::is_same<ValueType, arg_holder>::value >::type >
+    explicit
+    arg_holder(T&& v)
+        : value_{ construct<ValueType>(::std::forward<T>(v),
+                is_builtin_arg<ValueType>{}) }
+    {
+    }
+    arg_holder(arg_holder const& rhs) = default;
+    arg_holder(arg_holder&& rhs) noexcept
+        : value_{ ::std::move(rhs.value_) }
+    {
+    }
+
+    void
+    swap(arg_holder& rhs) noexcept
+    {
+        value_.swap(rhs.value_);
+    }
+
+    arg_holder&
+    operator = (arg_holder const& rhs)
+    {
+        arg_holder tmp{rhs};
+        swap(tmp);
+        return *this;
+    }
+    arg_holder&
+    operator = (arg_holder&& rhs) noexcept
+    {
+        arg_holder tmp{::std::move(rhs)};
+        swap(tmp);
+        return *this;
+    }
+
+    kind_type
+    kind() const
+    { return static_cast<kind_type>(value_.which()); }
+
+    bool
+    empty() const
+    { return kind() == empty_value; }
+    /**
+     * @return true if the value doesn't use a separate heap node
+     */
+    bool
+    is_inline() const;
+
+    value_type const&
+    value() const
+    { return value_; }
+
+    void
+    format(abstract_arg_value::formatted_message&) const;
+    /**
+     * Output the value to a stream
+     */
+    void
+    write(::std::ostream&) const;
+    /**
+     * Append the value to a string without a stream
+     * @param out
+     * @param loc
+     * @param domain_id Domain for nested messages without a domain
+     * @return false if the value must be written to a stream
+     */
+    bool
+    append(::std::string& out, ::std::locale const& loc, int domain_id) const;
+    /**
+     * The value is of a builtin type, writing it to a stream doesn't
+     * change the stream state.
+     */
+    bool
+    is_plain() const
+    {
+        auto k = kind();
+        return int_value <= k && k <= string_value;
+    }
+    void
+    collect(message_list&) const;
+    /**
+     * Memory used by the value outside of the holder
+     */
+    ::std::size_t
+    memory_usage() const;
+private:
+    template < typename U, typename T >
+    static U
+    construct(T&& v, ::std::true_type)
+    {
+        return U(::std::forward<T>(v));
+    }
+    template < typename U, typename T >
+    static typename ::std::conditional<
+        ::std::is_same<U, message>::value, nested_message, erased_arg >::type
+    construct(T&& v, ::std::false_type)
+    {
+        using holder_type = typename ::std::conditional<
+            ::std::is_same<U, message>::value, nested_message, erased_arg >::type;
+        return holder_type{ ::std::forward<T>(v) };
+    }
+
+    value_type  value_;
+};
+
+/**
+ * Storage for message arguments.
+ * First inline_capacity arguments are held in place, the rest are moved
+ * to a vector.
+ */
+class arg_list {
+public:
+    static constexpr ::std::size_t inline_capacity = 4;
+
     using arg_values        = ::std::vector<arg_holder>;
     using size_type         = arg_values::size_type;
-    using const_iterator    = arg_values::const_iterator;
+    using const_iterator    = arg_holder const*;
+public:
+    arg_list() noexcept : size_{0} {}
+    arg_list(arg_list const& rhs);
+    arg_list(arg_list&& rhs) noexcept;
+    ~arg_list()
+    {
+        clear();
+    }
+
+    void
+    swap(arg_list& rhs) noexcept;
+
+    arg_list&
+    operator = (arg_list const& rhs)
+    {
+        arg_list tmp(rhs);
+        swap(tmp);
+        return *this;
+    }
+    arg_list&
+    operator = (arg_list&& rhs) noexcept
+    {
+        arg_list tmp{::std::move(rhs)};
+        swap(tmp);
+        return *this;
+    }
+
+    bool
+    empty() const
+    { return size() == 0; }
+
+    size_type
+    size() const
+    { return heap_.empty() ? size_ : heap_.size(); }
+
+    const_iterator
+    begin() const
+    { return data(); }
+    const_iterator
+    cbegin() const
+    { return data(); }
+
+    const_iterator
+    end() const
+    { return data() + size(); }
+    const_iterator
+    cend() const
+    { return data() + size(); }
+
+    arg_holder const&
+    back() const
+    {
+        return data()[size() - 1];
+    }
+
+    void
+    emplace_back(arg_holder&& arg);
+
+    void
+    clear() noexcept;
+private:
+    using inline_storage = ::std::aligned_storage<
+            sizeof(arg_holder), alignof(arg_holder)>::type;
+
+    arg_holder*
+    inline_data() const
+    {
+        return reinterpret_cast<arg_holder*>(
+                const_cast<inline_storage*>(inline_));
+    }
+    arg_holder const*
+    data() const
+    { return heap_.empty() ? inline_data() : heap_.data(); }
+
+    /**
+     * Move inline arguments to heap storage
+     */
+    void
+    spill();
+
+    inline_storage  inline_[inline_capacity];
+    size_type       size_;
+    arg_values      heap_;
+};
+
+/**
+ * Argument list shared by copies of message arguments
+ */
+struct shared_arg_list {
+    ::std::atomic<::std::size_t>    refs;
+    arg_list                        args;
+
+    shared_arg_list() : refs{1} {}
+};
+
+/**
+ * List of message arguments.
+ * The argument list is immutable and shared between copies, so copying
+ * a message doesn't depend on count of arguments or nesting depth. The
+ * list is cloned when arguments are added to a shared list.
+ * Lists of destroyed arguments are kept by the thread for reuse, so
+ * building a message with arguments doesn't allocate in a steady state.
+ */
+class message_args {
 public:
-    message_args() {}
-    message_args(message_args const& rhs);
-    message_args(message_args&& rhs);
+    using arg_values        = arg_list::arg_values;
+    using size_type         = arg_list::size_type;
+    using const_iterator    = arg_list::const_iterator;
+public:
+    message_args() noexcept : args_{nullptr} {}
+    message_args(message_args const& rhs) noexcept
+        : args_{rhs.args_}
+    {
+        if (args_)
+            args_->refs.fetch_add(1, ::std::memory_order_relaxed);
+    }
+    message_args(message_args&& rhs) noexcept
+        : args_{rhs.args_}
+    {
+        rhs.args_ = nullptr;
+    }
+    ~message_args()
+    {
+        release(args_);
+    }
 
     void
     swap(message_args& rhs) noexcept
     {
-        using ::std::swap;
-        swap(args_, rhs.args_);
+        ::std::swap(args_, rhs.args_);
     }
 
     message_args&
-    operator = (message_args const& rhs)
+    operator = (message_args const& rhs) noexcept
     {
-        message_args tmp(rhs);
+        message_args tmp{rhs};
         swap(tmp);
         return *this;
     }
     message_args&
-    operator = (message_args&& rhs)
+    operator = (message_args&& rhs) noexcept
     {
         message_args tmp{::std::move(rhs)};
         swap(tmp);
@@ -108,55 +578,264 @@ public:
 
     bool
     empty() const
-    { return args_.empty(); }
+    { return !args_ || args_->args.empty(); }
 
     size_type
     size() const
-    { return args_.size(); }
+    { return args_ ? args_->args.size() : 0; }
 
     const_iterator
     begin() const
-    { return args_.cbegin(); }
+    { return args_ ? args_->args.begin() : nullptr; }
     const_iterator
     cbegin() const
-    { return args_.cbegin(); }
+    { return begin(); }
 
     const_iterator
     end() const
-    { return args_.cend(); }
+    { return args_ ? args_->args.end() : nullptr; }
     const_iterator
     cend() const
-    { return args_.cend(); }
+    { return end(); }
 
-    abstract_arg_value const&
+    arg_holder const&
     back() const
     {
-        return *args_.back();
+        return args_->args.back();
+    }
+
+    /**
+     * @return true if the argument list is shared with another object
+     */
+    bool
+    shared() const
+    {
+        // Acquire releases of the other owners, so that an unshared list
+        // is not used by other threads anymore
+        return args_ && args_->refs.load(::std::memory_order_acquire) > 1;
+    }
+
+    template < typename T >
+    message_args&
+    operator << (T&& v)
+    {
+        mutable_args().emplace_back(arg_holder{ ::std::forward<T>(v) });
+        return *this;
+    }
+
+    /**
+     * Memory used by the argument list divided by count of owners
+     */
+    ::std::size_t
+    memory_usage() const;
+private:
+    /**
+     * Get a list that can be modified. Will clone the list if it is shared.
+     */
+    arg_list&
+    mutable_args();
+    /**
+     * Drop a reference to a list, the last owner returns the list to the
+     * thread's pool
+     */
+    static void
+    release(shared_arg_list* list) noexcept;
+
+    shared_arg_list*    args_;
+};
+
+/**
+ * Text of a message: type, context, id, translated string, plural form
+ * and domain.
+ * The text is stored in a single immutable block that is shared by all
+ * messages with the same text, so a message holds one pointer to it
+ * and a copy is a refcount increment. The block is interned, equal texts
+ * share the same block.
+ * A default-constructed text is empty and has no block.
+ *
+ * A text created for a message of a generated message_table refers to the
+ * table, it's block is different from the block of the same text created
+ * from strings.
+ */
+class message_text {
+public:
+    struct block {
+        ::std::atomic<::std::size_t>    refs;
+        ::std::size_t const             hash;
+        ::std::size_t const             fingerprint;
+        int const                       type;
+        interned_string const           id;
+        interned_string const           str;
+        interned_string const           context;
+        interned_string const           plural;
+        interned_string const           domain;
+        message_table const* const      table;
+        ::std::size_t const             index;
+
+        block(::std::size_t h, int t, interned_string const& i,
+                interned_string const& s, interned_string const& c,
+                interned_string const& p, interned_string const& d,
+                message_table const* tbl = nullptr, ::std::size_t idx = 0)
+            : refs{1}, hash{h},
+              fingerprint{ make_fingerprint(d, c, i, !p.is_null()) },
+              type{t}, id{i}, str{s}, context{c}, plural{p}, domain{d},
+              table{tbl}, index{idx} {}
+
+        bool
+        matches(block const& rhs) const
+        {
+            return type == rhs.type && id == rhs.id && str == rhs.str &&
+                    context == rhs.context && plural == rhs.plural &&
+                    domain == rhs.domain && table == rhs.table &&
+                    index == rhs.index;
+        }
+    };
+public:
+    message_text() noexcept : block_{nullptr} {}
+    message_text(int type, interned_string const& id,
+            interned_string const& str, interned_string const& context,
+            interned_string const& plural, interned_string const& domain);
+    /**
+     * Create a text of a message in a generated table
+     * @param table
+     * @param index Index of the message in the table
+     */
+    message_text(message_table const& table, ::std::size_t index);
+    message_text(message_text const& rhs) noexcept
+        : block_{rhs.block_}
+    {
+        if (block_)
+            block_->refs.fetch_add(1, ::std::memory_order_relaxed);
+    }
+    message_text(message_text&& rhs) noexcept
+        : block_{rhs.block_}
+    {
+        rhs.block_ = nullptr;
+    }
+    ~message_text();
+
+    void
+    swap(message_text& rhs) noexcept
+    {
+        ::std::swap(block_, rhs.block_);
+    }
+
+    message_text&
+    operator = (message_text const& rhs) noexcept
+    {
+        message_text tmp{rhs};
+        swap(tmp);
+        return *this;
     }
-
-    template < typename T >
-    message_args&
-    operator << (T&& v)
+    message_text&
+    operator = (message_text&& rhs) noexcept
     {
-        using arg_type = arg_value<typename ::std::decay<T>::type>;
-        args_.emplace_back( new arg_type{ ::std::forward<T>(v) });
+        message_text tmp{::std::move(rhs)};
+        swap(tmp);
         return *this;
     }
 
-    message_args&
-    operator << (char const* v)
+    //@{
+    /** @name Accessors */
+    int
+    type() const
+    { return block_ ? block_->type : 0; }
+    interned_string const&
+    id() const
+    { return block_ ? block_->id : null_string(); }
+    interned_string const&
+    str() const
+    { return block_ ? block_->str : null_string(); }
+    interned_string const&
+    context() const
+    { return block_ ? block_->context : null_string(); }
+    interned_string const&
+    plural() const
+    { return block_ ? block_->plural : null_string(); }
+    interned_string const&
+    domain() const
+    { return block_ ? block_->domain : null_string(); }
+    /**
+     * Generated table of the message, nullptr if the text was not created
+     * from a table
+     */
+    message_table const*
+    table() const
+    { return block_ ? block_->table : nullptr; }
+    /**
+     * Index of the message in the generated table
+     */
+    ::std::size_t
+    index() const
+    { return block_ ? block_->index : 0; }
+    //@}
+
+    ::std::size_t
+    hash() const
+    { return block_ ? block_->hash : 0; }
+    /**
+     * Hash of message identity: domain, context, id and presence of a
+     * plural form. Computed once when the text is created.
+     * @return
+     */
+    ::std::size_t
+    fingerprint() const
+    { return block_ ? block_->fingerprint : null_fingerprint(); }
+    /**
+     * Test if two texts identify the same message, i.e. they have the same
+     * domain, context, id and both or none of them have a plural form.
+     * @param rhs
+     * @return
+     */
+    bool
+    same_message(message_text const& rhs) const
     {
-        return *this << ::std::string{v};
+        return block_ == rhs.block_ || (fingerprint() == rhs.fingerprint() &&
+                id() == rhs.id() && context() == rhs.context() &&
+                domain() == rhs.domain() &&
+                plural().is_null() == rhs.plural().is_null());
     }
+
+    static ::std::size_t
+    make_fingerprint(interned_string const& domain,
+            interned_string const& context, interned_string const& id,
+            bool has_plural);
+
+    /**
+     * Memory used by the block and its strings divided by count of
+     * references to the block
+     * @return
+     */
+    ::std::size_t
+    memory_usage() const;
+
+    bool
+    operator == (message_text const& rhs) const
+    { return block_ == rhs.block_; }
+    bool
+    operator != (message_text const& rhs) const
+    { return block_ != rhs.block_; }
+
+    /**
+     * Count of distinct message texts currently in use
+     * @return
+     */
+    static ::std::size_t
+    pool_size();
 private:
-    arg_values args_;
+    static interned_string const&
+    null_string();
+    static ::std::size_t
+    null_fingerprint();
+
+    block* block_;
 };
 
 inline ::boost::locale::format&
 operator % (::boost::locale::format& fmt, message_args const& args)
 {
     for (auto const& arg : args) {
-        arg->format(fmt);
+        arg.format(fmt);
     }
     return fmt;
 }
@@ -165,7 +844,11 @@ operator % (::boost::locale::format& fmt, message_args const& args)
 
 /**
  * Class to move ::boost::locale::format around
- * Caches nested arguments and formats
+ * Caches nested arguments and formats.
+ *
+ * A format created from a message text defers translation until it is
+ * rendered, when the locale is known. The translated template is taken
+ * from the translation_cache.
  */
 class format {
 public:
@@ -179,55 +862,135 @@ public:
     format(localized_message&&);
     explicit
     format(formatted_message_ptr&& fmt);
+    /**
+     * Create a format translating the message text when rendered
+     * @param text
+     * @param n Plural number
+     */
+    format(detail::message_text const& text, int n);
 
     format(format const&) = delete; // noncopyable
     format(format&&) = default;     // move only
 
     ::std::string
-    str(::std::locale const& loc = ::std::locale{}) const
-    {
-        return fmt_->str(loc);
-    }
+    str(::std::locale const& loc = ::std::locale{}) const;
+    /**
+     * Append formatted message to a string without constructing a stream,
+     * unless there are arguments with formatting options or arguments
+     * of user types.
+     * @param out
+     * @param loc
+     * @param domain_id Domain to use if the message has no domain
+     */
+    void
+    render(::std::string& out, ::std::locale const& loc = ::std::locale{},
+            int domain_id = 0) const;
 
     format&&
     operator % (format&& v)
     {
-        nested_.push_back(::std::move(v));
-        *fmt_ % *nested_.back().fmt_;
+        nested_.emplace_back(new format{ ::std::move(v) });
+        feed(*nested_.back());
         return ::std::move(*this);
     }
     template < typename T >
-    format&&
+    typename ::std::enable_if<
+        !::std::is_same<typename ::std::decay<T>::type,
+                detail::message_args>::value, format&& >::type
     operator % (T&& v)
     {
-        tmps_ << v;
-        tmps_.back().format(*fmt_);
+        tmps_.emplace_front(::std::forward<T>(v));
+        feed(tmps_.front());
         return ::std::move(*this);
     }
     format&&
     operator % (detail::abstract_arg_value const& v)
     {
-        v.format(*fmt_);
+        feed(v);
         return ::std::move(*this);
     }
     format&&
     operator % (detail::abstract_arg_value::arg_ptr const& v)
     {
-        v->format(*fmt_);
+        feed(*v);
+        return ::std::move(*this);
+    }
+    format&&
+    operator % (detail::arg_holder const& v)
+    {
+        feed(v);
+        return ::std::move(*this);
+    }
+    /**
+     * Feed all arguments of a message. The arguments are shared with
+     * the message.
+     */
+    format&&
+    operator % (detail::message_args const& args)
+    {
+        if (args.empty())
+            return ::std::move(*this);
+        held_.push_front(args);
+        for (auto const& arg : held_.front()) {
+            feed(arg);
+        }
         return ::std::move(*this);
     }
 private:
-    using nested_formats = ::std::vector<format>;
+    void
+    feed(format const& v)
+    {
+        if (fmt_)
+            *fmt_ % v;
+        else
+            args_.emplace_back(&v);
+    }
+    void
+    feed(detail::abstract_arg_value const& v)
+    {
+        if (fmt_)
+            v.format(*fmt_);
+        else
+            args_.emplace_back(&v);
+    }
+    void
+    feed(detail::arg_holder const& v)
+    {
+        if (fmt_)
+            v.format(*fmt_);
+        else
+            args_.emplace_back(&v);
+    }
+
+    void
+    write(::std::ostream& os) const;
+private:
+    // Nested formats and temporaries are fed by pointer, so they
+    // must not move when the format object is moved. The lists don't
+    // allocate until a value is added.
+    using nested_formats = ::std::vector<::std::unique_ptr<format>>;
+    using temp_values    = ::std::forward_list<detail::arg_holder>;
+    using held_args      = ::std::forward_list<detail::message_args>;
+    using arg_ref        = ::boost::variant<
+                                format const*,
+                                detail::abstract_arg_value const*,
+                                detail::arg_holder const* >;
+    using arg_refs       = ::std::vector<arg_ref>;
+
     formatted_message_ptr   fmt_;
+    detail::message_text    text_;
+    int                     n_ = 0;
     nested_formats          nested_;
-    detail::message_args    tmps_;
+    temp_values             tmps_;
+    held_args               held_;
+    arg_refs                args_;
 
     friend ::std::ostream&
     operator << (::std::ostream& os, format const& val)
     {
         ::std::ostream::sentry s (os);
         if (s) {
-            os << *val.fmt_;
+            val.write(os);
         }
         return os;
     }
@@ -235,6 +998,97 @@ private:
 
 using format_shared_ptr = ::std::shared_ptr<format>;
 
+namespace detail {
+
+/**
+ * Callable feeding a value for a named placeholder to a message,
+ * `void(message&, ::std::string const& name)`
+ */
+template < typename Func, typename = void >
+struct is_named_param_func : ::std::false_type {};
+template < typename Func >
+struct is_named_param_func< Func, decltype(void(::std::declval<Func&>()(
+        ::std::declval<message&>(), ::std::declval<::std::string const&>()))) >
+    : ::std::true_type {};
+
+/**
+ * Callable returning plural number for a named placeholder,
+ * `int(::std::string const& name)`
+ */
+template < typename Func, typename = void >
+struct is_get_n_func : ::std::false_type {};
+template < typename Func >
+struct is_get_n_func< Func, decltype(void(static_cast<int>(::std::declval<Func&>()(
+        ::std::declval<::std::string const&>())))) >
+    : ::std::true_type {};
+
+/**
+ * Range of name-value pairs, e.g. an array or a vector of pairs
+ */
+template < typename Table, typename = void >
+struct is_named_value_table : ::std::false_type {};
+template < typename Table >
+struct is_named_value_table< Table, decltype(void((
+        ::std::declval<::std::string const&>() ==
+                ::std::begin(::std::declval<Table const&>())->first,
+        ::std::begin(::std::declval<Table const&>())->second,
+        ::std::end(::std::declval<Table const&>())))) >
+    : ::std::true_type {};
+
+/**
+ * Plural number from a value in a name-value table
+ */
+template < typename T >
+typename ::std::enable_if< ::std::is_arithmetic<T>::value, int >::type
+plural_number(T const& value, ::std::string const&)
+{
+    return static_cast<int>(value);
+}
+
+template < typename T >
+typename ::std::enable_if< !::std::is_arithmetic<T>::value, int >::type
+plural_number(T const&, ::std::string const& name)
+{
+    throw ::std::runtime_error{"Value of plural placeholder " + name +
+        " is not a number"};
+}
+
+/**
+ * Feeds values of named placeholders from a name-value table.
+ * Names are looked up linearly, the tables are expected to be small.
+ */
+template < typename Table >
+class named_value_table {
+public:
+    explicit
+    named_value_table(Table const& table) : table_(table) {}
+
+    void
+    operator()(message& msg, ::std::string const& name) const;
+
+    int
+    plural_n(::std::string const& name) const
+    {
+        return plural_number(find(name)->second, name);
+    }
+private:
+    auto
+    find(::std::string const& name) const
+        -> decltype(::std::begin(::std::declval<Table const&>()))
+    {
+        auto end = ::std::end(table_);
+        for (auto p = ::std::begin(table_); p != end; ++p) {
+            if (name == p->first)
+                return p;
+        }
+        throw ::std::runtime_error{"No value for placeholder " + name};
+    }
+private:
+    Table const& table_;
+};
+
+}  /* namespace detail */
+
 /**
  * Class for representing a message that must be translated when sending
  * to output. The message can contain predefined format arguments and
@@ -253,6 +1107,8 @@ public:
     using get_named_param_func              = ::std::function<void(message&,
                                                     ::std::string const& param_name)>;
     using get_n_func                        = ::std::function<int(::std::string const& param_name)>;
+    using locale_list                       = ::std::vector<::std::locale>;
+    using string_list                       = ::std::vector<::std::string>;
 
     enum class message_type {
         empty           = 0x00,
@@ -309,6 +1165,16 @@ public:
             std::string const& plural,
             int n,
             optional_string const& domain = optional_string());
+    /**
+     * Construct a message from a dense id generated from a .pot file.
+     * Translations of such messages are looked up by index.
+     */
+    explicit
+    message(message_id const& id);
+    /**
+     * Construct a message with singular/plural from a dense id
+     */
+    message(message_id const& id, int n);
 
     message(message const&) = default;
     message(message&&) = default;
@@ -340,18 +1206,22 @@ public:
     /** @name Comparison operators */
     /**
      * Test for equality. Don't take format arguments into account.
+     * Messages are equal if they have the same domain, context, id and
+     * both or none of them have a plural form.
      * @param rhs
      * @return
      */
     bool
-    operator == (message const& rhs) const;
+    operator == (message const& rhs) const
+    { return text_.same_message(rhs.text_); }
     /**
      * Test for not equality. Don't take format arguments into account.
      * @param rhs
      * @return
      */
     bool
-    operator != (message const& rhs) const;
+    operator != (message const& rhs) const
+    { return !(*this == rhs); }
     /**
      * Test for sorting order. Don't take format arguments into account.
      * @param rhs
@@ -363,25 +1233,24 @@ public:
 
     bool
     empty() const
-    { return type_ == message_type::empty || msgid_.empty(); }
+    { return type() == message_type::empty || text_.id().empty(); }
 
     //@{
     /** @name Accessors */
     message_type
     type() const
-    { return type_; }
+    { return static_cast<message_type>(text_.type()); }
 
     ::std::string const&
     id() const
-    { return msgid_; }
+    { return text_.id().str(); }
 
     void
-    set_id(::std::string const& id)
-    { msgid_ = id; }
+    set_id(::std::string const& id);
 
     ::std::string const&
     msgstr() const
-    { return msgstr_; }
+    { return text_.str().str(); }
 
     ::std::string const&
     plural() const;
@@ -397,6 +1266,19 @@ public:
      */
     void
     domain( std::string const& );
+    /**
+     * Hash of message identity: domain, context, id and presence of a
+     * plural form. The value is used for comparison and std::hash.
+     */
+    ::std::size_t
+    fingerprint() const
+    { return text_.fingerprint(); }
+    /**
+     * Interned text of the message
+     */
+    detail::message_text const&
+    text() const
+    { return text_; }
     int
     get_n() const
     { return n_; }
@@ -424,10 +1306,10 @@ public:
     /** @name Check functions */
     bool
     has_context() const
-    { return context_.is_initialized(); }
+    { return !text_.context().is_null(); }
     bool
     has_plural() const
-    { return plural_.is_initialized(); }
+    { return !text_.plural().is_null(); }
     bool
     has_format_args() const
     { return !args_.empty(); }
@@ -440,6 +1322,16 @@ public:
     args_size() const
     { return args_.size(); }
 
+    /**
+     * Estimate memory used by the message. Shared parts (text and
+     * arguments) are divided by count of their owners, so that a sum
+     * over a collection of messages gives the memory used by the
+     * collection.
+     * @return Count of bytes
+     */
+    ::std::size_t
+    memory_usage() const;
+
     /**
      * Add argument to predefined formatting arguments
      * @param v argument value
@@ -493,7 +1385,45 @@ public:
     ::std::string
     str(::std::locale const& loc = ::std::locale{}) const
     {
-        return this->format().str(loc);
+        ::std::string out;
+        render_format(out, loc, 0);
+        return out;
+    }
+    /**
+     * Get strings translated to several locales at once. Locale
+     * independent work is done once for all of the locales: arguments
+     * and nested messages are traversed and numbers are formatted for
+     * locales that write them without grouping.
+     * @param locales
+     * @return Strings in order of the locales
+     */
+    string_list
+    str(locale_list const& locales) const;
+    /**
+     * Append translated and formatted message to a string, the same
+     * output as write produces. No stream is constructed, unless there
+     * are arguments with formatting options or arguments of user types.
+     * @param out
+     * @param loc
+     * @param domain_id Domain to use if the message has no domain
+     * @return The string
+     */
+    ::std::string&
+    render(::std::string& out, ::std::locale const& loc = ::std::locale{},
+            int domain_id = 0) const;
+    /**
+     * Render translated and formatted message to an output iterator
+     * @param out
+     * @param loc
+     * @return Iterator past the last character written
+     */
+    template < typename OutputIterator >
+    OutputIterator
+    render(OutputIterator out, ::std::locale const& loc = ::std::locale{}) const
+    {
+        ::std::string buffer;
+        render(buffer, loc);
+        return ::std::copy(buffer.begin(), buffer.end(), out);
     }
     /**
      * Create a format object and feed a value into it.
@@ -548,13 +1478,304 @@ public:
             get_n_func get_n,
             int n = 0,
             optional_string const& domain = optional_string());
+
+    /**
+     * Create a message with the specified id, the same as the overload
+     * with ::std::function, but the function is called directly.
+     * @param id
+     * @param f     Callable `void(message&, ::std::string const& name)`
+     *              to feed a named parameter to the message
+     * @return
+     */
+    template < typename Func, typename = typename ::std::enable_if<
+            detail::is_named_param_func<Func>::value >::type >
+    static message
+    create_message(::std::string const& id, Func&& f,
+            domain_type const& domain = domain_type{})
+    {
+        auto id_phs = placeholder_cache::instance().get(id);
+        return create_named(*id_phs, f, domain);
+    }
+    template < typename Func, typename = typename ::std::enable_if<
+            detail::is_named_param_func<Func>::value >::type >
+    static message
+    create_message(::std::string const& context, ::std::string const& id,
+            Func&& f, domain_type const& domain = domain_type{})
+    {
+        auto id_phs = placeholder_cache::instance().get(id);
+        return create_named(context, *id_phs, f, domain);
+    }
+    /**
+     * Create a plural message, the same as the overload with
+     * ::std::function, but the functions are called directly.
+     * @param singular
+     * @param plural
+     * @param f     Callable `void(message&, ::std::string const& name)`
+     *              to feed a named parameter to the message
+     * @param get_n Callable `int(::std::string const& name)` to get
+     *              the plural number for a `{n:name}` placeholder
+     * @param n     Plural number if there is no such placeholder
+     * @return
+     */
+    template < typename Func, typename GetN, typename = typename ::std::enable_if<
+            detail::is_named_param_func<Func>::value &&
+            detail::is_get_n_func<GetN>::value >::type >
+    static message
+    create_message(::std::string const& singular, ::std::string const& plural,
+            Func&& f, GetN&& get_n, int n = 0,
+            domain_type const& domain = domain_type{})
+    {
+        auto& cache = placeholder_cache::instance();
+        auto singular_phs = cache.get(singular);
+        auto plural_phs   = cache.get(plural);
+        return create_named(*singular_phs, *plural_phs, f, get_n, n, domain);
+    }
+    template < typename Func, typename GetN, typename = typename ::std::enable_if<
+            detail::is_named_param_func<Func>::value &&
+            detail::is_get_n_func<GetN>::value >::type >
+    static message
+    create_message(::std::string const& context,
+            ::std::string const& singular, ::std::string const& plural,
+            Func&& f, GetN&& get_n, int n = 0,
+            optional_string const& domain = optional_string())
+    {
+        auto& cache = placeholder_cache::instance();
+        auto singular_phs = cache.get(singular);
+        auto plural_phs   = cache.get(plural);
+        return create_named(context, *singular_phs, *plural_phs, f, get_n, n,
+                domain);
+    }
+
+    /**
+     * Create a message with values of named parameters taken from
+     * a table of name-value pairs, e.g. an array of pairs.
+     * @param id
+     * @param values    Range of pairs, the first is the name
+     * @throws ::std::runtime_error if there is no value for a name
+     * @return
+     */
+    template < typename Table, typename = typename ::std::enable_if<
+            detail::is_named_value_table<Table>::value >::type >
+    static message
+    create_message(::std::string const& id, Table const& values,
+            domain_type const& domain = domain_type{})
+    {
+        return create_message(id, detail::named_value_table<Table>{values},
+                domain);
+    }
+    template < typename Table, typename = typename ::std::enable_if<
+            detail::is_named_value_table<Table>::value >::type >
+    static message
+    create_message(::std::string const& context, ::std::string const& id,
+            Table const& values, domain_type const& domain = domain_type{})
+    {
+        return create_message(context, id,
+                detail::named_value_table<Table>{values}, domain);
+    }
+    /**
+     * Create a plural message with values of named parameters taken from
+     * a table of name-value pairs. The plural number of a `{n:name}`
+     * placeholder is the value of the name, it must be a number.
+     * @param singular
+     * @param plural
+     * @param values    Range of pairs, the first is the name
+     * @param n         Plural number if there is no `{n:name}` placeholder
+     * @throws ::std::runtime_error if there is no value for a name
+     * @return
+     */
+    template < typename Table, typename = typename ::std::enable_if<
+            detail::is_named_value_table<Table>::value >::type >
+    static message
+    create_message(::std::string const& singular, ::std::string const& plural,
+            Table const& values, int n,
+            domain_type const& domain = domain_type{})
+    {
+        detail::named_value_table<Table> table{values};
+        return create_message(singular, plural, table,
+                [&table](::std::string const& name) { return table.plural_n(name); },
+                n, domain);
+    }
+    template < typename Table, typename = typename ::std::enable_if<
+            detail::is_named_value_table<Table>::value >::type >
+    static message
+    create_message(::std::string const& context,
+            ::std::string const& singular, ::std::string const& plural,
+            Table const& values, int n,
+            optional_string const& domain = optional_string())
+    {
+        detail::named_value_table<Table> table{values};
+        return create_message(context, singular, plural, table,
+                [&table](::std::string const& name) { return table.plural_n(name); },
+                n, domain);
+    }
+
+    //@{
+    /**
+     * @name Messages with placeholders parsed at compile time
+     * Create a message from ids created by PSST_L10N_NAMED_ID, the same
+     * as the overloads with strings. The placeholders are not parsed
+     * at run time.
+     */
+    template < typename Func, typename = typename ::std::enable_if<
+            detail::is_named_param_func<Func>::value >::type >
+    static message
+    create_message(static_named_id const& id, Func&& f,
+            domain_type const& domain = domain_type{})
+    {
+        return create_named(id.get(), f, domain);
+    }
+    template < typename Func, typename = typename ::std::enable_if<
+            detail::is_named_param_func<Func>::value >::type >
+    static message
+    create_message(::std::string const& context, static_named_id const& id,
+            Func&& f, domain_type const& domain = domain_type{})
+    {
+        return create_named(context, id.get(), f, domain);
+    }
+    template < typename Func, typename GetN, typename = typename ::std::enable_if<
+            detail::is_named_param_func<Func>::value &&
+            detail::is_get_n_func<GetN>::value >::type >
+    static message
+    create_message(static_named_id const& singular,
+            static_named_id const& plural,
+            Func&& f, GetN&& get_n, int n = 0,
+            domain_type const& domain = domain_type{})
+    {
+        return create_named(singular.get(), plural.get(), f, get_n, n, domain);
+    }
+    template < typename Func, typename GetN, typename = typename ::std::enable_if<
+            detail::is_named_param_func<Func>::value &&
+            detail::is_get_n_func<GetN>::value >::type >
+    static message
+    create_message(::std::string const& context,
+            static_named_id const& singular, static_named_id const& plural,
+            Func&& f, GetN&& get_n, int n = 0,
+            optional_string const& domain = optional_string())
+    {
+        return create_named(context, singular.get(), plural.get(), f, get_n,
+                n, domain);
+    }
+    template < typename Table, typename = typename ::std::enable_if<
+            detail::is_named_value_table<Table>::value >::type >
+    static message
+    create_message(static_named_id const& id, Table const& values,
+            domain_type const& domain = domain_type{})
+    {
+        return create_named(id.get(), detail::named_value_table<Table>{values},
+                domain);
+    }
+    template < typename Table, typename = typename ::std::enable_if<
+            detail::is_named_value_table<Table>::value >::type >
+    static message
+    create_message(::std::string const& context, static_named_id const& id,
+            Table const& values, domain_type const& domain = domain_type{})
+    {
+        return create_named(context, id.get(),
+                detail::named_value_table<Table>{values}, domain);
+    }
+    template < typename Table, typename = typename ::std::enable_if<
+            detail::is_named_value_table<Table>::value >::type >
+    static message
+    create_message(static_named_id const& singular,
+            static_named_id const& plural,
+            Table const& values, int n,
+            domain_type const& domain = domain_type{})
+    {
+        detail::named_value_table<Table> table{values};
+        return create_named(singular.get(), plural.get(), table,
+                [&table](::std::string const& name) { return table.plural_n(name); },
+                n, domain);
+    }
+    template < typename Table, typename = typename ::std::enable_if<
+            detail::is_named_value_table<Table>::value >::type >
+    static message
+    create_message(::std::string const& context,
+            static_named_id const& singular, static_named_id const& plural,
+            Table const& values, int n,
+            optional_string const& domain = optional_string())
+    {
+        detail::named_value_table<Table> table{values};
+        return create_named(context, singular.get(), plural.get(), table,
+                [&table](::std::string const& name) { return table.plural_n(name); },
+                n, domain);
+    }
+    //@}
+private:
+    //@{
+    /** @name Create messages from parsed named placeholders */
+    template < typename Func >
+    static message
+    create_named(named_placeholders const& id, Func&& f,
+            domain_type const& domain)
+    {
+        message msg{id.first, domain};
+        for (auto const& ph : id.second) {
+            f(msg, ::boost::get<::std::string>(ph.id));
+        }
+        return msg;
+    }
+    template < typename Func >
+    static message
+    create_named(::std::string const& context, named_placeholders const& id,
+            Func&& f, domain_type const& domain)
+    {
+        message msg{context, id.first, domain};
+        for (auto const& ph : id.second) {
+            f(msg, ::boost::get<::std::string>(ph.id));
+        }
+        return msg;
+    }
+    template < typename Func, typename GetN >
+    static message
+    create_named(named_placeholders const& singular,
+            named_placeholders const& plural, Func&& f, GetN&& get_n, int n,
+            domain_type const& domain)
+    {
+        message msg{singular.first, plural.first, n, domain};
+        for (auto const& ph : singular.second) {
+            auto const& nm = ::boost::get<::std::string>(ph.id);
+            if (ph.is_pluralizer) {
+                msg.set_n(get_n(nm));
+            } else {
+                f(msg, nm);
+            }
+        }
+        return msg;
+    }
+    template < typename Func, typename GetN >
+    static message
+    create_named(::std::string const& context,
+            named_placeholders const& singular,
+            named_placeholders const& plural, Func&& f, GetN&& get_n, int n,
+            optional_string const& domain)
+    {
+        message msg{context, singular.first, plural.first, n, domain};
+        for (auto const& ph : singular.second) {
+            auto const& nm = ::boost::get<::std::string>(ph.id);
+            if (ph.is_pluralizer) {
+                msg.set_n(get_n(nm));
+                if (ph.uses > 1)
+                    f(msg, nm);
+            } else {
+                f(msg, nm);
+            }
+        }
+        return msg;
+    }
+    //@}
+
+    /**
+     * Append the message to a string formatted with arguments,
+     * even if the message doesn't have any.
+     */
+    void
+    render_format(::std::string& out, ::std::locale const& loc,
+            int domain_id) const;
+
+    friend class detail::prepared_message;
+    friend class detail::batch_renderer;
 private:
-    message_type                type_;
-    std::string                 msgid_;
-    std::string                 msgstr_;
-    optional_string             context_;
-    optional_string             plural_;
-    optional_string             domain_;
+    detail::message_text        text_;
 
     int                         n_;
     detail::message_args        args_;
@@ -577,6 +1798,17 @@ operator << (std::ostream& os, message const& v);
 ::std::istream&
 operator >> (::std::istream& is, message& val);
 
+namespace detail {
+
+template < typename Table >
+void
+named_value_table<Table>::operator()(message& msg, ::std::string const& name) const
+{
+    msg << find(name)->second;
+}
+
+}  /* namespace detail */
+
 inline format&&
 operator % (format& fmt, message const& msg)
 {
@@ -610,11 +1842,28 @@ struct arg_value<message> : abstract_arg_value {
         return arg_ptr{ new arg_value{ *this } };
     }
 
+    abstract_arg_value*
+    clone_to(void* place) const override
+    {
+        return new (place) arg_value{ *this };
+    }
+
+    abstract_arg_value*
+    move_to(void* place) noexcept override
+    {
+        return new (place) arg_value{ ::std::move(*this) };
+    }
+
     void
     format(formatted_message& fmt) const override
     {
         fmt % value;
     }
+    void
+    write(::std::ostream& os) const override
+    {
+        os << value;
+    }
 
     void
     collect(message_list& messages) const override
@@ -631,4 +1880,20 @@ struct arg_value<message> : abstract_arg_value {
 } /* namespace l10n */
 } /* namespace psst */
 
+namespace std {
+
+template <>
+struct hash<::psst::l10n::message> {
+    using argument_type = ::psst::l10n::message;
+    using result_type   = ::std::size_t;
+
+    result_type
+    operator()(argument_type const& v) const
+    {
+        return v.fingerprint();
+    }
+};
+
+}  /* namespace std */
+
 #endif /* PUSHKIN_L10N_MESSAGE_HPP_ */
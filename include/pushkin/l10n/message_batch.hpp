@@ -0,0 +1,138 @@
+/*
+ * message_batch.hpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: zmij
+ */
+
+#ifndef PUSHKIN_L10N_MESSAGE_BATCH_HPP_
+#define PUSHKIN_L10N_MESSAGE_BATCH_HPP_
+
+#include <pushkin/l10n/message.hpp>
+
+#include <cstddef>
+#include <locale>
+#include <string>
+#include <vector>
+
+namespace psst {
+namespace l10n {
+
+/**
+ * Messages rendered to a single string.
+ * Message number i occupies characters [offset(i), offset(i + 1)) of the
+ * string.
+ */
+class rendered_batch {
+public:
+    using size_type     = ::std::size_t;
+    using offset_list   = ::std::vector<size_type>;
+public:
+    rendered_batch() = default;
+
+    /**
+     * Count of rendered messages
+     */
+    size_type
+    size() const
+    { return offsets_.empty() ? 0 : offsets_.size() - 1; }
+    bool
+    empty() const
+    { return size() == 0; }
+
+    /**
+     * All of the messages, one after another
+     */
+    ::std::string const&
+    data() const
+    { return data_; }
+    /**
+     * Offsets of the messages in the data, followed by the size of the data
+     */
+    offset_list const&
+    offsets() const
+    { return offsets_; }
+
+    size_type
+    offset(size_type idx) const
+    { return offsets_[idx]; }
+    size_type
+    length(size_type idx) const
+    { return offsets_[idx + 1] - offsets_[idx]; }
+    char const*
+    begin(size_type idx) const
+    { return data_.data() + offsets_[idx]; }
+    char const*
+    end(size_type idx) const
+    { return data_.data() + offsets_[idx + 1]; }
+    /**
+     * Copy of a rendered message
+     */
+    ::std::string
+    str(size_type idx) const
+    { return ::std::string{begin(idx), end(idx)}; }
+
+    /**
+     * Remove the messages, keeping allocated memory
+     */
+    void
+    clear()
+    {
+        data_.clear();
+        offsets_.clear();
+    }
+    /**
+     * Reserve memory for messages
+     * @param messages Count of messages
+     * @param chars    Count of characters
+     */
+    void
+    reserve(size_type messages, size_type chars)
+    {
+        offsets_.reserve(messages + 1);
+        data_.reserve(chars);
+    }
+private:
+    friend void
+    render_batch(message const*, message const*, ::std::locale const&,
+            rendered_batch&);
+
+    ::std::string   data_;
+    offset_list     offsets_;
+};
+
+/**
+ * Render messages to a locale and append them to a batch. The output is
+ * the same as message::str produces for each of the messages.
+ * Locale facets are looked up once for the batch, message domains are
+ * resolved once for each domain. Templates of messages without plural
+ * forms are taken from the translation_cache once for each message text.
+ * @param first
+ * @param last
+ * @param loc
+ * @param out
+ */
+void
+render_batch(message const* first, message const* last,
+        ::std::locale const& loc, rendered_batch& out);
+
+inline void
+render_batch(message_list const& messages, ::std::locale const& loc,
+        rendered_batch& out)
+{
+    render_batch(messages.data(), messages.data() + messages.size(), loc, out);
+}
+
+inline rendered_batch
+render_batch(message_list const& messages,
+        ::std::locale const& loc = ::std::locale{})
+{
+    rendered_batch out;
+    render_batch(messages, loc, out);
+    return out;
+}
+
+}  /* namespace l10n */
+}  /* namespace psst */
+
+#endif /* PUSHKIN_L10N_MESSAGE_BATCH_HPP_ */
@@ -0,0 +1,100 @@
+/*
+ * message_id.hpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: zmij
+ */
+
+#ifndef PUSHKIN_L10N_MESSAGE_ID_HPP_
+#define PUSHKIN_L10N_MESSAGE_ID_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+
+namespace psst {
+namespace l10n {
+
+namespace detail {
+class message_text;
+}  /* namespace detail */
+
+/**
+ * Message of a generated message table, strings are as in the .pot file
+ */
+struct message_entry {
+    /** Message context, nullptr if the message has no context */
+    char const*     context;
+    char const*     id;
+    /** Plural form, nullptr if the message is not plural */
+    char const*     plural;
+};
+
+/**
+ * Messages of a domain with dense ids. The tables are generated from .pot
+ * files by generate_message_ids function in cmake/scripts/l10n.cmake,
+ * id of a message is it's index in the table.
+ *
+ * Translations of messages constructed from ids are looked up by index
+ * in per-locale arrays, see translation_cache.
+ */
+class message_table {
+public:
+    /**
+     * @param domain    Domain of the messages, nullptr for the default domain
+     * @param entries   Messages, must outlive the table
+     * @param size      Count of messages
+     */
+    message_table(char const* domain, message_entry const* entries,
+            ::std::size_t size)
+        : domain_{domain}, entries_{entries}, size_{size}, texts_{nullptr} {}
+
+    message_table(message_table const&) = delete;
+    message_table&
+    operator = (message_table const&) = delete;
+
+    char const*
+    domain() const
+    { return domain_; }
+    ::std::size_t
+    size() const
+    { return size_; }
+    message_entry const&
+    operator[](::std::size_t idx) const
+    { return entries_[idx]; }
+
+    /**
+     * Interned text of a message. Texts of all messages are created on
+     * first call and are never destroyed.
+     * @param idx
+     * @throws ::std::out_of_range if the index is out of the table
+     */
+    detail::message_text const&
+    text(::std::size_t idx) const;
+private:
+    char const*                     domain_;
+    message_entry const*            entries_;
+    ::std::size_t                   size_;
+    mutable ::std::once_flag        once_;
+    mutable detail::message_text*   texts_;
+};
+
+/**
+ * Dense id of a message in a generated table.
+ * Generated headers define constants of this type, named after messages.
+ */
+struct message_id {
+    using table_func = message_table const& (*)();
+
+    table_func      table;
+    ::std::uint32_t value;
+
+    message_entry const&
+    entry() const
+    { return table()[value]; }
+};
+
+}  /* namespace l10n */
+}  /* namespace psst */
+
+#endif /* PUSHKIN_L10N_MESSAGE_ID_HPP_ */
@@ -0,0 +1,189 @@
+/*
+ * mo_catalog.hpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: zmij
+ */
+
+#ifndef PUSHKIN_L10N_MO_CATALOG_HPP_
+#define PUSHKIN_L10N_MO_CATALOG_HPP_
+
+#include <pushkin/l10n/plural_forms.hpp>
+
+#include <boost/locale/message.hpp>
+
+#include <cstddef>
+#include <locale>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace psst {
+namespace l10n {
+
+/**
+ * Compiled gettext message catalog (.mo file) mapped to memory read-only.
+ * The pages of the file are shared by all processes using the catalog.
+ * Messages are looked up via the hash table of the file, or via an index
+ * built at load time if the file has no hash table. Translations are
+ * returned as pointers into the mapped file.
+ *
+ * The catalog is expected to be in UTF-8.
+ */
+class mo_catalog {
+public:
+    /**
+     * Map a catalog file
+     * @param path
+     * @throws ::std::runtime_error if the file cannot be mapped or is not
+     *         a valid catalog
+     */
+    explicit
+    mo_catalog(::std::string const& path);
+    ~mo_catalog();
+
+    mo_catalog(mo_catalog const&) = delete;
+    mo_catalog&
+    operator = (mo_catalog const&) = delete;
+
+    ::std::string const&
+    path() const;
+    /**
+     * Number of messages in the catalog, including the header
+     */
+    ::std::size_t
+    size() const;
+    plural_forms const&
+    plural() const;
+
+    /**
+     * Find translation of a message
+     * @param context   Message context, nullptr or empty for none
+     * @param id        Message id
+     * @return Translation or nullptr if the message is not translated
+     */
+    char const*
+    get(char const* context, char const* id) const;
+    /**
+     * Find translation of a plural form of a message
+     * @param context   Message context, nullptr or empty for none
+     * @param id        Message id, singular
+     * @param n         Number to select the plural form
+     * @return Translation or nullptr if the message is not translated
+     */
+    char const*
+    get(char const* context, char const* id, long n) const;
+    /**
+     * Find translation of a plural form by index
+     * @param context
+     * @param id
+     * @param form      Index of the plural form
+     * @return
+     */
+    char const*
+    get_form(char const* context, char const* id, long form) const;
+private:
+    struct impl;
+    using pimpl = ::std::unique_ptr<impl>;
+    pimpl pimpl_;
+};
+
+using mo_catalog_ptr = ::std::shared_ptr<mo_catalog const>;
+
+/**
+ * Message format facet looking up translations in mapped catalogs.
+ * Replaces the facet created by ::boost::locale::generator, so that
+ * messages and formats use the mapped catalogs.
+ */
+class mo_message_format : public ::boost::locale::message_format<char> {
+public:
+    /** Domain name and catalog, the catalog can be null */
+    using domain_catalog    = ::std::pair<::std::string, mo_catalog_ptr>;
+    using domain_list       = ::std::vector<domain_catalog>;
+public:
+    /**
+     * @param domains Domains, id of a domain is it's index in the list
+     * @param refs
+     */
+    explicit
+    mo_message_format(domain_list const& domains, ::std::size_t refs = 0);
+
+    char const*
+    get(int domain_id, char const* context, char const* id) const override;
+    char const*
+    get(int domain_id, char const* context, char const* id, int n) const override;
+    int
+    domain(::std::string const& domain) const override;
+    char const*
+    convert(char const* msg, ::std::string& buffer) const override;
+
+    /**
+     * Index of plural form for a number in catalog of a domain
+     * @param domain_id
+     * @param n
+     * @return Index of the form, -1 if the domain has no catalog
+     */
+    long
+    plural_form(int domain_id, long n) const;
+    /**
+     * Number of plural forms in catalog of a domain
+     * @param domain_id
+     * @return Number of forms, 0 if the domain has no catalog
+     */
+    ::std::size_t
+    plural_count(int domain_id) const;
+    /**
+     * Find translation of a plural form by index
+     * @param domain_id
+     * @param context
+     * @param id
+     * @param form
+     * @return Translation or nullptr if the message is not translated
+     */
+    char const*
+    get_form(int domain_id, char const* context, char const* id, long form) const;
+
+    domain_list const&
+    domains() const
+    { return domains_; }
+private:
+    mo_catalog const*
+    catalog(int domain_id) const;
+private:
+    domain_list domains_;
+};
+
+/**
+ * Find catalog files for a locale, the same way as ::boost::locale does:
+ * `<path>/<locale>/LC_MESSAGES/<domain>.mo`, where locale is tried as
+ * `lang_COUNTRY@variant`, `lang@variant`, `lang_COUNTRY`, `lang`.
+ * The first domain is the default one.
+ * @param locale_name   Locale name, e.g. ru_RU.UTF-8
+ * @param paths         Directories to search
+ * @param domains       Message domains
+ * @return Domain list, with null catalogs for domains without files
+ */
+mo_message_format::domain_list
+find_catalogs(::std::string const& locale_name,
+        ::std::vector<::std::string> const& paths,
+        ::std::vector<::std::string> const& domains);
+
+/**
+ * Create a locale with message catalogs mapped to memory
+ * @param base          Locale to take other facets from, e.g. created
+ *                      by ::boost::locale::generator
+ * @param locale_name   Locale name
+ * @param paths         Directories to search for catalogs
+ * @param domains       Message domains, the first is the default one
+ * @return
+ */
+::std::locale
+catalog_locale(::std::locale const& base, ::std::string const& locale_name,
+        ::std::vector<::std::string> const& paths,
+        ::std::vector<::std::string> const& domains);
+
+}  /* namespace l10n */
+}  /* namespace psst */
+
+#endif /* PUSHKIN_L10N_MO_CATALOG_HPP_ */
@@ -0,0 +1,124 @@
+/*
+ * parallel_renderer.hpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: zmij
+ */
+
+#ifndef PUSHKIN_L10N_PARALLEL_RENDERER_HPP_
+#define PUSHKIN_L10N_PARALLEL_RENDERER_HPP_
+
+#include <pushkin/l10n/message.hpp>
+
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <future>
+#include <locale>
+#include <memory>
+#include <string>
+
+namespace psst {
+namespace l10n {
+
+/**
+ * Renders lists of messages on a pool of worker threads.
+ * A list is split to chunks of messages that are distributed between
+ * the workers' queues. A worker takes chunks from the front of it's
+ * queue and steals from the back of other queues when it's queue is
+ * empty. Each chunk is rendered with the facets of the locale, domain ids
+ * and translated templates looked up once for the chunk, the streams used
+ * for formatting are per thread. The output is the same as message::str
+ * produces.
+ *
+ * Several lists can be rendered at the same time. The destructor waits
+ * until all of the submitted lists are rendered.
+ */
+class parallel_renderer {
+public:
+    /**
+     * Called with index of a message in the list and the rendered string
+     */
+    using result_callback       = ::std::function<
+            void(::std::size_t, ::std::string&&)>;
+    /**
+     * Called once when all of the messages are rendered and delivered,
+     * with the first exception thrown by rendering or by the result
+     * callback, or null. The callback must not throw.
+     */
+    using completion_callback   = ::std::function<void(::std::exception_ptr)>;
+
+    enum class delivery {
+        /**
+         * Results are delivered in order of the messages. The result
+         * callback is not called concurrently.
+         */
+        ordered,
+        /**
+         * Results are delivered as soon as they are rendered. The result
+         * callback is called concurrently from several workers.
+         */
+        unordered
+    };
+public:
+    /**
+     * @param threads Count of worker threads, 0 for count of cores
+     */
+    explicit
+    parallel_renderer(::std::size_t threads = 0);
+    ~parallel_renderer();
+
+    parallel_renderer(parallel_renderer const&) = delete;
+    parallel_renderer&
+    operator = (parallel_renderer const&) = delete;
+
+    /**
+     * Count of worker threads
+     */
+    ::std::size_t
+    size() const;
+
+    /**
+     * Render messages and deliver the results to a callback.
+     * Callbacks are called from the worker threads. If rendering of a
+     * message or a result callback throws, rendering of the list stops
+     * and the exception is passed to the completion callback.
+     * @param messages
+     * @param loc
+     * @param on_result
+     * @param on_complete
+     * @param order
+     */
+    void
+    render(message_list messages, ::std::locale const& loc,
+            result_callback on_result, completion_callback on_complete,
+            delivery order = delivery::unordered);
+    /**
+     * Render messages and deliver the results to a callback
+     * @param messages
+     * @param loc
+     * @param on_result
+     * @param order
+     * @return Future that is ready when all of the results are delivered
+     */
+    ::std::future<void>
+    render(message_list messages, ::std::locale const& loc,
+            result_callback on_result, delivery order = delivery::unordered);
+    /**
+     * Render messages
+     * @param messages
+     * @param loc
+     * @return Future of strings in order of the messages
+     */
+    ::std::future<message::string_list>
+    render(message_list messages, ::std::locale const& loc = ::std::locale{});
+private:
+    struct impl;
+    using pimpl = ::std::unique_ptr<impl>;
+    pimpl pimpl_;
+};
+
+}  /* namespace l10n */
+}  /* namespace psst */
+
+#endif /* PUSHKIN_L10N_PARALLEL_RENDERER_HPP_ */
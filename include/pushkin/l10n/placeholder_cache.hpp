@@ -0,0 +1,90 @@
+/*
+ * placeholder_cache.hpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: zmij
+ */
+
+#ifndef PUSHKIN_L10N_PLACEHOLDER_CACHE_HPP_
+#define PUSHKIN_L10N_PLACEHOLDER_CACHE_HPP_
+
+#include <pushkin/l10n/message_util.hpp>
+#include <pushkin/l10n/lru_cache.hpp>
+
+#include <memory>
+#include <string>
+#include <utility>
+
+namespace psst {
+namespace l10n {
+
+/**
+ * Message id with named placeholders replaced by numbers and the list
+ * of named placeholders, as returned by extract_named_placeholders
+ */
+using named_placeholders        = ::std::pair<::std::string, placeholders>;
+using named_placeholders_ptr    = ::std::shared_ptr<named_placeholders const>;
+
+/**
+ * Cache of message templates with named placeholders parsed by
+ * extract_named_placeholders. Used by message::create_message, so that
+ * messages created from the same template repeatedly don't parse it
+ * each time.
+ */
+class placeholder_cache {
+public:
+    static constexpr ::std::size_t default_capacity = 1 << 12;
+public:
+    explicit
+    placeholder_cache(::std::size_t capacity = default_capacity);
+    ~placeholder_cache();
+
+    placeholder_cache(placeholder_cache const&) = delete;
+    placeholder_cache&
+    operator = (placeholder_cache const&) = delete;
+
+    /**
+     * Process-wide cache used by message::create_message
+     * @return
+     */
+    static placeholder_cache&
+    instance();
+
+    /**
+     * Get parsed template
+     * @param tmpl  Message id or plural string with named placeholders
+     * @return Renumbered string and named placeholders
+     */
+    named_placeholders_ptr
+    get(::std::string const& tmpl);
+
+    ::std::size_t
+    capacity() const;
+    /**
+     * Set maximum count of cached templates. Least recently used
+     * templates are evicted.
+     * @param
+     */
+    void
+    set_capacity(::std::size_t);
+    void
+    clear();
+
+    /**
+     * Size of the cache and hit rate
+     * @return
+     */
+    cache_stats
+    stats() const;
+    void
+    reset_stats();
+private:
+    struct impl;
+    using pimpl = ::std::unique_ptr<impl>;
+    pimpl pimpl_;
+};
+
+}  /* namespace l10n */
+}  /* namespace psst */
+
+#endif /* PUSHKIN_L10N_PLACEHOLDER_CACHE_HPP_ */
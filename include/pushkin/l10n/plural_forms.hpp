@@ -0,0 +1,125 @@
+/*
+ * plural_forms.hpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: zmij
+ */
+
+#ifndef PUSHKIN_L10N_PLURAL_FORMS_HPP_
+#define PUSHKIN_L10N_PLURAL_FORMS_HPP_
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace psst {
+namespace l10n {
+
+/**
+ * Plural form selection rule of a message catalog, from the gettext
+ * `Plural-Forms: nplurals=N; plural=EXPR;` header.
+ * The expression is a C expression of variable `n`.
+ *
+ * The expression is compiled once to a flat program for a stack machine.
+ * Expressions of the common rule families (the ones listed in the gettext
+ * manual) are recognized regardless of spacing and parentheses and
+ * are evaluated by native functions.
+ */
+class plural_forms {
+public:
+    /**
+     * Construct the default rule `nplurals=2; plural=(n != 1);`
+     */
+    plural_forms();
+    /**
+     * Parse and compile plural expression
+     * @param expr      C expression of n
+     * @param nplurals  Number of plural forms
+     * @throws ::std::runtime_error if the expression is invalid
+     */
+    plural_forms(::std::string const& expr, ::std::size_t nplurals);
+
+    /**
+     * Get the rule from catalog header. If the header doesn't have
+     * a valid Plural-Forms entry, the default rule is returned.
+     * @param header Header of a message catalog, the translation of
+     *               an empty msgid
+     * @return
+     */
+    static plural_forms
+    from_header(::std::string const& header);
+
+    /**
+     * Number of plural forms
+     */
+    ::std::size_t
+    size() const
+    { return nplurals_; }
+    ::std::string const&
+    expression() const
+    { return expr_; }
+    /**
+     * The expression is evaluated by a native function
+     */
+    bool
+    is_native() const
+    { return func_ != nullptr; }
+
+    /**
+     * Index of plural form for a number
+     * @param n
+     * @return Result of the expression, can be out of range of forms
+     *         for an erroneous catalog
+     */
+    long
+    operator()(long n) const
+    { return func_ ? func_(n) : run(n); }
+private:
+    enum op_type {
+        op_n, op_const,
+        op_not, op_mul, op_div, op_mod, op_add, op_sub,
+        op_lt, op_gt, op_le, op_ge, op_eq, op_ne,
+        op_and, op_or, op_cond,
+        // Program only
+        op_bool, op_jz, op_jnz, op_jmp
+    };
+    struct node {
+        op_type op;
+        long    value;
+        int     args[3];
+    };
+    using nodes = ::std::vector<node>;
+    class parser;
+    class compiler;
+
+    /**
+     * Instruction of the program. Binary operations take the right
+     * operand from the value if it is immediate, jumps take the target
+     * from the value.
+     */
+    struct instruction {
+        op_type op;
+        bool    immediate;
+        long    value;
+    };
+    using program = ::std::vector<instruction>;
+    using function_type = long(*)(long);
+
+    static ::std::string
+    canonical(nodes const& n, int idx);
+    static function_type
+    find_native(::std::string const& canonical_expr);
+
+    long
+    run(long n) const;
+private:
+    ::std::string   expr_;
+    ::std::size_t   nplurals_;
+    program         code_;
+    function_type   func_;
+};
+
+}  /* namespace l10n */
+}  /* namespace psst */
+
+#endif /* PUSHKIN_L10N_PLURAL_FORMS_HPP_ */
@@ -0,0 +1,130 @@
+/*
+ * prerendered_messages.hpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: zmij
+ */
+
+#ifndef PUSHKIN_L10N_PRERENDERED_MESSAGES_HPP_
+#define PUSHKIN_L10N_PRERENDERED_MESSAGES_HPP_
+
+#include <pushkin/l10n/message.hpp>
+#include <pushkin/l10n/message_id.hpp>
+
+#include <cstddef>
+#include <locale>
+#include <string>
+#include <vector>
+
+namespace psst {
+namespace l10n {
+
+class catalog_registry;
+
+/**
+ * Messages of a generated message_table rendered in advance to several
+ * locales. Messages without plural forms and without placeholders,
+ * i.e. messages that are never formatted with arguments, are rendered
+ * once when the table is built. Getting such a message doesn't allocate
+ * and doesn't look up the translation.
+ *
+ * The strings are stored in one array, locale by locale, in order of the
+ * message ids. A locale is matched by it's message_format facet, so any
+ * locale with the catalogs the table was built for finds the strings,
+ * copies of the locales themselves are found faster. The table keeps the
+ * locales alive. Locales of a catalog_registry get new facets when the
+ * catalogs are reloaded, the table must be built again after a reload.
+ */
+class prerendered_messages {
+public:
+    using size_type     = ::std::size_t;
+    using locale_list   = message::locale_list;
+    static constexpr size_type npos = static_cast<size_type>(-1);
+public:
+    /**
+     * Render messages of a table to locales
+     * @param table
+     * @param locales
+     */
+    prerendered_messages(message_table const& table, locale_list const& locales);
+    /**
+     * Render messages of a table to the locales loaded by a registry
+     * @param table
+     * @param registry
+     */
+    prerendered_messages(message_table const& table,
+            catalog_registry const& registry);
+
+    message_table const&
+    table() const
+    { return *table_; }
+    /**
+     * Count of locales
+     */
+    size_type
+    size() const
+    { return locales_.size(); }
+
+    /**
+     * Test if a message is rendered in advance
+     * @param id
+     * @return
+     */
+    bool
+    prerendered(message_id const& id) const
+    {
+        return &id.table() == table_ && id.value < rendered_.size() &&
+                rendered_[id.value];
+    }
+    /**
+     * Index of a locale in the table
+     * @param loc
+     * @return Index of the locale, npos if the table has no strings for it
+     */
+    size_type
+    locale_index(::std::locale const& loc) const;
+
+    /**
+     * Get a string rendered in advance
+     * @param id            Message id
+     * @param locale_idx    Index of the locale, see locale_index
+     * @return Pointer to the string, nullptr if the message is not rendered
+     *         in advance
+     */
+    ::std::string const*
+    find(message_id const& id, size_type locale_idx) const
+    {
+        if (locale_idx >= size() || !prerendered(id))
+            return nullptr;
+        return &strings_[locale_idx * rendered_.size() + id.value];
+    }
+    ::std::string const*
+    find(message_id const& id, ::std::locale const& loc) const
+    { return find(id, locale_index(loc)); }
+    /**
+     * Get a string rendered in advance, the same as message::str returns
+     * for the message.
+     * Throws ::std::out_of_range if the message is not rendered in advance
+     * to the locale.
+     * @param id
+     * @param loc
+     * @return
+     */
+    ::std::string const&
+    str(message_id const& id, ::std::locale const& loc = ::std::locale{}) const;
+private:
+    void
+    render(locale_list const& locales);
+
+    message_table const*        table_;
+    locale_list                 locales_;
+    /** message_format facets of the locales, nullptr for a locale without one */
+    ::std::vector<void const*>  catalogs_;
+    ::std::vector<bool>         rendered_;
+    ::std::vector<::std::string> strings_;
+};
+
+}  /* namespace l10n */
+}  /* namespace psst */
+
+#endif /* PUSHKIN_L10N_PRERENDERED_MESSAGES_HPP_ */
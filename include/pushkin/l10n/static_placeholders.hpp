@@ -0,0 +1,732 @@
+/*
+ * static_placeholders.hpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: zmij
+ */
+
+#ifndef PUSHKIN_L10N_STATIC_PLACEHOLDERS_HPP_
+#define PUSHKIN_L10N_STATIC_PLACEHOLDERS_HPP_
+
+#include <pushkin/l10n/placeholder_cache.hpp>
+
+#include <cstddef>
+#include <stdexcept>
+
+namespace psst {
+namespace l10n {
+namespace detail {
+
+//@{
+/**
+ * @name Compile-time placeholder parsing
+ * The functions are evaluated by the compiler and accept the same
+ * placeholders as extract_placeholders, but an invalid placeholder is
+ * an error instead of the end of placeholders. ::std::logic_error thrown
+ * in a constant expression becomes a compilation error.
+ */
+constexpr bool
+is_digit(char c)
+{
+    return '0' <= c && c <= '9';
+}
+
+constexpr bool
+is_name_start(char c)
+{
+    return ('a' <= c && c <= 'z') || ('A' <= c && c <= 'Z') || c == '_';
+}
+
+constexpr bool
+is_name_char(char c)
+{
+    return is_name_start(c) || is_digit(c) || c == '.';
+}
+
+constexpr ::std::size_t
+find_char(char const* str, ::std::size_t b, ::std::size_t e, char c);
+
+constexpr ::std::size_t
+find_char_right(char const* str, ::std::size_t found, ::std::size_t m,
+        ::std::size_t e, char c)
+{
+    return found != m ? found : find_char(str, m, e, c);
+}
+
+/**
+ * Position of the first c in [b, e) of str, e if not found.
+ * The range is halved, so that the recursion depth doesn't depend on
+ * length of the string.
+ */
+constexpr ::std::size_t
+find_char(char const* str, ::std::size_t b, ::std::size_t e, char c)
+{
+    return e - b == 0 ? e :
+           e - b == 1 ? (str[b] == c ? b : e) :
+           find_char_right(str, find_char(str, b, b + (e - b) / 2, c),
+                   b + (e - b) / 2, e, c);
+}
+
+constexpr ::std::size_t
+skip_digits(char const* str, ::std::size_t p, ::std::size_t size)
+{
+    return p < size && is_digit(str[p]) ? skip_digits(str, p + 1, size) : p;
+}
+
+constexpr ::std::size_t
+skip_name(char const* str, ::std::size_t p, ::std::size_t size)
+{
+    return p < size && is_name_char(str[p]) ? skip_name(str, p + 1, size) : p;
+}
+
+constexpr ::std::size_t
+parse_number(char const* str, ::std::size_t b, ::std::size_t e,
+        ::std::size_t val = 0)
+{
+    return b == e ? val : parse_number(str, b + 1, e, val * 10 + (str[b] - '0'));
+}
+
+constexpr ::std::size_t
+options_end(::std::size_t close, ::std::size_t size)
+{
+    return close == size ?
+            throw ::std::logic_error{"Unterminated placeholder"} : close + 1;
+}
+
+/**
+ * Position past a placeholder, p is the position after the number or name
+ */
+constexpr ::std::size_t
+placeholder_end(char const* str, ::std::size_t p, ::std::size_t size)
+{
+    return p == size ? throw ::std::logic_error{"Unterminated placeholder"} :
+           str[p] == '}' ? p + 1 :
+           str[p] == ',' && p + 1 < size && str[p + 1] != '}' ?
+                   options_end(find_char(str, p + 1, size, '}'), size) :
+           throw ::std::logic_error{"Invalid placeholder"};
+}
+
+constexpr ::std::size_t
+next_placeholder(char const* str, ::std::size_t pos, ::std::size_t size);
+
+constexpr ::std::size_t
+next_placeholder_at(char const* str, ::std::size_t b, ::std::size_t size)
+{
+    return b == size ? size :
+           b + 1 < size && str[b + 1] == '{' ?
+                   next_placeholder(str, b + 2, size) : b;
+}
+
+/**
+ * Position of the next placeholder starting from pos, escaped braces are
+ * skipped
+ * @return Position of the opening brace, size if there are no more
+ *         placeholders
+ */
+constexpr ::std::size_t
+next_placeholder(char const* str, ::std::size_t pos, ::std::size_t size)
+{
+    return next_placeholder_at(str, find_char(str, pos, size, '{'), size);
+}
+
+// Placeholder functions take position of the opening brace
+constexpr bool
+is_numbered(char const* str, ::std::size_t b, ::std::size_t size)
+{
+    return b + 1 < size && is_digit(str[b + 1]);
+}
+
+constexpr bool
+is_pluralizer(char const* str, ::std::size_t b, ::std::size_t size)
+{
+    return !is_numbered(str, b, size) &&
+            b + 2 < size && str[b + 1] == 'n' && str[b + 2] == ':';
+}
+
+/**
+ * Start of placeholder number or name
+ */
+constexpr ::std::size_t
+id_begin(char const* str, ::std::size_t b, ::std::size_t size)
+{
+    return is_pluralizer(str, b, size) ? b + 3 : b + 1;
+}
+
+constexpr ::std::size_t
+id_end(char const* str, ::std::size_t b, ::std::size_t size)
+{
+    return is_numbered(str, b, size) ? skip_digits(str, b + 1, size) :
+           id_begin(str, b, size) < size &&
+                   is_name_start(str[id_begin(str, b, size)]) ?
+                   skip_name(str, id_begin(str, b, size) + 1, size) :
+           throw ::std::logic_error{"Invalid placeholder"};
+}
+
+constexpr ::std::size_t
+end_of_placeholder(char const* str, ::std::size_t b, ::std::size_t size)
+{
+    return placeholder_end(str, id_end(str, b, size), size);
+}
+
+constexpr bool
+same_chars(char const* lhs, char const* rhs, ::std::size_t n)
+{
+    return n == 0 || (*lhs == *rhs && same_chars(lhs + 1, rhs + 1, n - 1));
+}
+
+/**
+ * Both placeholders are named and have the same name
+ */
+constexpr bool
+same_name(char const* str, ::std::size_t lhs, ::std::size_t rhs,
+        ::std::size_t size)
+{
+    return !is_numbered(str, lhs, size) && !is_numbered(str, rhs, size) &&
+            id_end(str, lhs, size) - id_begin(str, lhs, size) ==
+                    id_end(str, rhs, size) - id_begin(str, rhs, size) &&
+            same_chars(str + id_begin(str, lhs, size),
+                    str + id_begin(str, rhs, size),
+                    id_end(str, lhs, size) - id_begin(str, lhs, size));
+}
+
+constexpr ::std::size_t
+count_digits(::std::size_t n)
+{
+    return n < 10 ? 1 : 1 + count_digits(n / 10);
+}
+
+constexpr ::std::size_t
+power_of_ten(::std::size_t n)
+{
+    return n == 0 ? 1 : 10 * power_of_ten(n - 1);
+}
+
+constexpr char
+digit_of(::std::size_t n, ::std::size_t idx)
+{
+    return static_cast<char>('0' +
+            n / power_of_ten(count_digits(n) - 1 - idx) % 10);
+}
+
+constexpr ::std::size_t
+options_begin(char const* str, ::std::size_t b, ::std::size_t size)
+{
+    return str[id_end(str, b, size)] == ',' ? id_end(str, b, size) + 1 :
+            id_end(str, b, size);
+}
+
+constexpr ::std::size_t
+options_size(char const* str, ::std::size_t b, ::std::size_t size)
+{
+    return end_of_placeholder(str, b, size) - 1 - options_begin(str, b, size);
+}
+//@}
+
+constexpr ::std::size_t
+count_placeholders(char const* str, ::std::size_t pos, ::std::size_t size);
+
+constexpr ::std::size_t
+count_placeholders_at(char const* str, ::std::size_t b, ::std::size_t size)
+{
+    return b == size ? 0 :
+            1 + count_placeholders(str, end_of_placeholder(str, b, size), size);
+}
+
+/**
+ * Count of placeholders starting from pos
+ */
+constexpr ::std::size_t
+count_placeholders(char const* str, ::std::size_t pos, ::std::size_t size)
+{
+    return count_placeholders_at(str, next_placeholder(str, pos, size), size);
+}
+
+constexpr ::std::size_t
+nth_placeholder(char const* str, ::std::size_t pos, ::std::size_t n,
+        ::std::size_t size);
+
+constexpr ::std::size_t
+nth_placeholder_at(char const* str, ::std::size_t b, ::std::size_t n,
+        ::std::size_t size)
+{
+    return b == size || n == 0 ? b :
+            nth_placeholder(str, end_of_placeholder(str, b, size), n - 1, size);
+}
+
+/**
+ * Position of the opening brace of the n-th placeholder starting from pos
+ */
+constexpr ::std::size_t
+nth_placeholder(char const* str, ::std::size_t pos, ::std::size_t n,
+        ::std::size_t size)
+{
+    return nth_placeholder_at(str, next_placeholder(str, pos, size), n, size);
+}
+
+/**
+ * Placeholders of a string indexed in order of appearance. The string is
+ * parsed once into the tables, the renumbered string and the named
+ * placeholders are built from them, so the work doesn't grow with
+ * the product of the string length and the count of placeholders.
+ * The tables are filled in stages by placeholder_table, a table is
+ * nullptr until it's stage.
+ */
+struct placeholder_tables {
+    char const*             str;
+    ::std::size_t           size;
+    ::std::size_t           count;
+    /** Positions of opening braces */
+    ::std::size_t const*    pos;
+    /** Index of the first placeholder with the same name, own index
+     *  for a numbered placeholder */
+    ::std::size_t const*    first;
+    /** Numbers of placeholders after renumbering */
+    ::std::size_t const*    number;
+    /** Positions of opening braces in the renumbered string */
+    ::std::ptrdiff_t const* out;
+};
+
+/**
+ * Index of the first placeholder with the name of the placeholder k,
+ * searching from j
+ */
+constexpr ::std::size_t
+first_same_name(placeholder_tables const& t, ::std::size_t k, ::std::size_t j)
+{
+    return j >= k ? k :
+           same_name(t.str, t.pos[j], t.pos[k], t.size) ? j :
+           first_same_name(t, k, j + 1);
+}
+
+/**
+ * The placeholder k is the first one with it's name
+ */
+constexpr bool
+starts_name(placeholder_tables const& t, ::std::size_t k)
+{
+    return !is_numbered(t.str, t.pos[k], t.size) && t.first[k] == k;
+}
+
+/**
+ * Count of distinct names of placeholders [b, e)
+ */
+constexpr ::std::size_t
+count_names(placeholder_tables const& t, ::std::size_t b, ::std::size_t e)
+{
+    return b >= e ? 0 :
+            (starts_name(t, b) ? 1 : 0) + count_names(t, b + 1, e);
+}
+
+/**
+ * Number of a placeholder after renumbering: names are numbered in
+ * order of first appearance, numbered placeholders go after them
+ */
+constexpr ::std::size_t
+new_number(placeholder_tables const& t, ::std::size_t k, ::std::size_t names)
+{
+    return is_numbered(t.str, t.pos[k], t.size) ?
+            parse_number(t.str, t.pos[k] + 1,
+                    id_end(t.str, t.pos[k], t.size)) + names :
+            count_names(t, 0, t.first[k] + 1);
+}
+
+/**
+ * Difference of the placeholder's length after renumbering
+ */
+constexpr ::std::ptrdiff_t
+size_change(placeholder_tables const& t, ::std::size_t k)
+{
+    return static_cast<::std::ptrdiff_t>(count_digits(t.number[k])) -
+            static_cast<::std::ptrdiff_t>(
+                    id_end(t.str, t.pos[k], t.size) - t.pos[k] - 1);
+}
+
+/**
+ * Sum of length differences of placeholders [b, e)
+ */
+constexpr ::std::ptrdiff_t
+size_change(placeholder_tables const& t, ::std::size_t b, ::std::size_t e)
+{
+    return b >= e ? 0 : size_change(t, b) + size_change(t, b + 1, e);
+}
+
+constexpr ::std::ptrdiff_t
+renumbered_position(placeholder_tables const& t, ::std::size_t k)
+{
+    return static_cast<::std::ptrdiff_t>(t.pos[k]) + size_change(t, 0, k);
+}
+
+/**
+ * Index of the first placeholder in [b, e) starting at or after the
+ * position i of the renumbered string, e if none
+ */
+constexpr ::std::size_t
+placeholder_from(placeholder_tables const& t, ::std::ptrdiff_t i,
+        ::std::size_t b, ::std::size_t e)
+{
+    return b == e ? b :
+           t.out[b + (e - b) / 2] < i ?
+                   placeholder_from(t, i, b + (e - b) / 2 + 1, e) :
+                   placeholder_from(t, i, b, b + (e - b) / 2);
+}
+
+/**
+ * Character at position i of the renumbered string, the placeholder k
+ * is the last one starting before i
+ */
+constexpr char
+renumbered_char_after(placeholder_tables const& t, ::std::ptrdiff_t i,
+        ::std::size_t k)
+{
+    return i <= t.out[k] +
+                static_cast<::std::ptrdiff_t>(count_digits(t.number[k])) ?
+            digit_of(t.number[k], static_cast<::std::size_t>(i - t.out[k] - 1)) :
+            t.str[i - (t.out[k] - static_cast<::std::ptrdiff_t>(t.pos[k]) +
+                    size_change(t, k))];
+}
+
+/**
+ * Character at position i of the string with renumbered placeholders
+ */
+constexpr char
+renumbered_char(placeholder_tables const& t, ::std::size_t i,
+        ::std::size_t from)
+{
+    return from == 0 ? t.str[i] :
+            renumbered_char_after(t, static_cast<::std::ptrdiff_t>(i), from - 1);
+}
+
+constexpr char
+renumbered_char(placeholder_tables const& t, ::std::size_t i)
+{
+    return renumbered_char(t, i,
+            placeholder_from(t, static_cast<::std::ptrdiff_t>(i), 0, t.count));
+}
+
+/**
+ * Index of the first placeholder with the n-th distinct name, searching
+ * from k
+ */
+constexpr ::std::size_t
+nth_name(placeholder_tables const& t, ::std::size_t n, ::std::size_t k)
+{
+    return k >= t.count ? t.count :
+           starts_name(t, k) ? (n == 0 ? k : nth_name(t, n - 1, k + 1)) :
+           nth_name(t, n, k + 1);
+}
+
+/**
+ * Count of placeholders [k, count) with the name of the placeholder f
+ */
+constexpr ::std::size_t
+count_uses(placeholder_tables const& t, ::std::size_t f, ::std::size_t k)
+{
+    return k >= t.count ? 0 :
+            (t.first[k] == f ? 1 : 0) + count_uses(t, f, k + 1);
+}
+
+/**
+ * Any of placeholders [k, count) with the name of the placeholder f is
+ * a pluralizer
+ */
+constexpr bool
+used_as_pluralizer(placeholder_tables const& t, ::std::size_t f,
+        ::std::size_t k)
+{
+    return k < t.count && ((t.first[k] == f &&
+            is_pluralizer(t.str, t.pos[k], t.size)) ||
+            used_as_pluralizer(t, f, k + 1));
+}
+
+/**
+ * Named placeholder parsed at compile time
+ */
+struct static_placeholder {
+    char const*     name;
+    ::std::size_t   name_size;
+    bool            is_pluralizer;
+    ::std::size_t   uses;
+    char const*     options;
+    ::std::size_t   options_size;
+};
+
+constexpr static_placeholder
+make_static_placeholder(placeholder_tables const& t, ::std::size_t k)
+{
+    return static_placeholder{
+        t.str + id_begin(t.str, t.pos[k], t.size),
+        id_end(t.str, t.pos[k], t.size) - id_begin(t.str, t.pos[k], t.size),
+        used_as_pluralizer(t, k, 0),
+        count_uses(t, k, 0),
+        t.str + options_begin(t.str, t.pos[k], t.size),
+        options_size(t.str, t.pos[k], t.size)
+    };
+}
+
+template < ::std::size_t ... I >
+struct index_sequence {};
+
+template < typename L, typename R >
+struct concat_indexes;
+
+template < ::std::size_t ... L, ::std::size_t ... R >
+struct concat_indexes< index_sequence<L...>, index_sequence<R...> > {
+    using type = index_sequence< L..., (sizeof...(L) + R)... >;
+};
+
+/**
+ * Index sequence 0..N-1, the recursion depth is logarithmic
+ */
+template < ::std::size_t N >
+struct make_index_sequence : concat_indexes<
+    typename make_index_sequence< N / 2 >::type,
+    typename make_index_sequence< N - N / 2 >::type > {};
+
+template <>
+struct make_index_sequence<0> {
+    using type = index_sequence<>;
+};
+
+template <>
+struct make_index_sequence<1> {
+    using type = index_sequence<0>;
+};
+
+template < typename Literal >
+struct placeholder_count {
+    static constexpr ::std::size_t value =
+            count_placeholders(Literal::get(), 0, Literal::size());
+};
+
+template < typename Literal, typename Indexes = typename
+    make_index_sequence< placeholder_count<Literal>::value >::type >
+struct placeholder_table;
+
+/**
+ * Placeholder tables of a literal. The literal type has static constexpr
+ * functions `get()` returning the string and `size()` returning
+ * it's length. The arrays have an extra element, so that they are
+ * not empty.
+ */
+template < typename Literal, ::std::size_t ... I >
+struct placeholder_table< Literal, index_sequence<I...> > {
+    static constexpr ::std::size_t count = sizeof...(I);
+    static constexpr ::std::size_t pos[count + 1] = {
+        nth_placeholder(Literal::get(), 0, I, Literal::size())...,
+        Literal::size()
+    };
+    static constexpr placeholder_tables positions{
+        Literal::get(), Literal::size(), count, pos, nullptr, nullptr, nullptr
+    };
+    static constexpr ::std::size_t first[count + 1] = {
+        first_same_name(positions, I, 0)..., count
+    };
+    static constexpr placeholder_tables names_table{
+        Literal::get(), Literal::size(), count, pos, first, nullptr, nullptr
+    };
+    static constexpr ::std::size_t names = count_names(names_table, 0, count);
+    static constexpr ::std::size_t number[count + 1] = {
+        new_number(names_table, I, names)..., 0
+    };
+    static constexpr placeholder_tables numbers_table{
+        Literal::get(), Literal::size(), count, pos, first, number, nullptr
+    };
+    static constexpr ::std::ptrdiff_t out[count + 1] = {
+        renumbered_position(numbers_table, I)..., 0
+    };
+    static constexpr placeholder_tables value{
+        Literal::get(), Literal::size(), count, pos, first, number, out
+    };
+};
+
+template < typename Literal, ::std::size_t ... I >
+constexpr ::std::size_t
+placeholder_table< Literal, index_sequence<I...> >::pos[];
+template < typename Literal, ::std::size_t ... I >
+constexpr placeholder_tables
+placeholder_table< Literal, index_sequence<I...> >::positions;
+template < typename Literal, ::std::size_t ... I >
+constexpr ::std::size_t
+placeholder_table< Literal, index_sequence<I...> >::first[];
+template < typename Literal, ::std::size_t ... I >
+constexpr placeholder_tables
+placeholder_table< Literal, index_sequence<I...> >::names_table;
+template < typename Literal, ::std::size_t ... I >
+constexpr ::std::size_t
+placeholder_table< Literal, index_sequence<I...> >::number[];
+template < typename Literal, ::std::size_t ... I >
+constexpr placeholder_tables
+placeholder_table< Literal, index_sequence<I...> >::numbers_table;
+template < typename Literal, ::std::size_t ... I >
+constexpr ::std::ptrdiff_t
+placeholder_table< Literal, index_sequence<I...> >::out[];
+template < typename Literal, ::std::size_t ... I >
+constexpr placeholder_tables
+placeholder_table< Literal, index_sequence<I...> >::value;
+
+/**
+ * Parsed string literal
+ */
+template < typename Literal >
+struct static_literal {
+    using table = placeholder_table<Literal>;
+    static constexpr ::std::size_t names = table::names;
+    static constexpr ::std::size_t size = names == 0 ? Literal::size() :
+            Literal::size() + size_change(table::value, 0, table::count);
+};
+
+template < typename Literal, typename Indexes =
+    typename make_index_sequence< static_literal<Literal>::size >::type >
+struct renumbered_string;
+
+/**
+ * The literal with placeholders renumbered as by
+ * extract_named_placeholders
+ */
+template < typename Literal, ::std::size_t ... I >
+struct renumbered_string< Literal, index_sequence<I...> > {
+    static constexpr char value[sizeof...(I) + 1] = {
+        (static_literal<Literal>::names == 0 ? Literal::get()[I] :
+            renumbered_char(placeholder_table<Literal>::value, I))...,
+        '\0'
+    };
+};
+
+template < typename Literal, ::std::size_t ... I >
+constexpr char renumbered_string< Literal, index_sequence<I...> >::value[];
+
+template < typename Literal, typename Indexes =
+    typename make_index_sequence< static_literal<Literal>::names >::type >
+struct named_placeholder_list;
+
+/**
+ * Named placeholders of the literal, in order of first appearance.
+ * The last element is empty, so that the array is not empty.
+ */
+template < typename Literal, ::std::size_t ... I >
+struct named_placeholder_list< Literal, index_sequence<I...> > {
+    static constexpr static_placeholder value[sizeof...(I) + 1] = {
+        make_static_placeholder(placeholder_table<Literal>::value,
+                nth_name(placeholder_table<Literal>::value, I, 0))...,
+        static_placeholder{ nullptr, 0, false, 0, nullptr, 0 }
+    };
+};
+
+template < typename Literal, ::std::size_t ... I >
+constexpr static_placeholder
+named_placeholder_list< Literal, index_sequence<I...> >::value[];
+
+/**
+ * Make the same result as extract_named_placeholders from placeholders
+ * parsed at compile time
+ */
+named_placeholders
+make_named_placeholders(char const* str, ::std::size_t size,
+        static_placeholder const* phs, ::std::size_t count);
+
+}  /* namespace detail */
+
+/**
+ * Message id or plural form with named placeholders parsed at compile
+ * time, created by PSST_L10N_NAMED_ID macro. Used by
+ * message::create_message instead of a string, the placeholders are
+ * not parsed at run time and not looked up in the placeholder_cache.
+ */
+class static_named_id {
+public:
+    using placeholder_list = detail::static_placeholder const*;
+    using get_func         = named_placeholders const& (*)();
+public:
+    constexpr
+    static_named_id(char const* str, ::std::size_t size,
+            placeholder_list phs, ::std::size_t count, get_func get)
+        : str_{str}, size_{size}, phs_{phs}, count_{count}, get_{get} {}
+
+    /**
+     * String with renumbered placeholders
+     */
+    constexpr char const*
+    str() const
+    { return str_; }
+    constexpr ::std::size_t
+    size() const
+    { return size_; }
+    /**
+     * Named placeholders in order of first appearance
+     */
+    constexpr placeholder_list
+    placeholders() const
+    { return phs_; }
+    constexpr ::std::size_t
+    count() const
+    { return count_; }
+
+    /**
+     * The same value as extract_named_placeholders returns for the source
+     * string. The value is constructed once from the parsed placeholders.
+     */
+    named_placeholders const&
+    get() const
+    { return get_(); }
+private:
+    char const*         str_;
+    ::std::size_t       size_;
+    placeholder_list    phs_;
+    ::std::size_t       count_;
+    get_func            get_;
+};
+
+namespace detail {
+
+template < typename Literal >
+named_placeholders const&
+get_named_placeholders()
+{
+    using text = renumbered_string<Literal>;
+    using list = named_placeholder_list<Literal>;
+    // Never destroyed, messages can be created by static objects' destructors
+    static named_placeholders const* value = new named_placeholders{
+        make_named_placeholders(text::value, static_literal<Literal>::size,
+                list::value, static_literal<Literal>::names) };
+    return *value;
+}
+
+template < typename Literal >
+static_named_id
+make_static_named_id()
+{
+    return static_named_id{
+        renumbered_string<Literal>::value,
+        static_literal<Literal>::size,
+        named_placeholder_list<Literal>::value,
+        static_literal<Literal>::names,
+        &get_named_placeholders<Literal>
+    };
+}
+
+}  /* namespace detail */
+}  /* namespace l10n */
+}  /* namespace psst */
+
+/**
+ * Parse named placeholders of a string literal at compile time.
+ * An invalid placeholder is a compilation error.
+ * @code
+ * auto msg = message::create_message(
+ *         PSST_L10N_NAMED_ID("{user} has {n:count} new messages"),
+ *         values);
+ * @endcode
+ * @return psst::l10n::static_named_id
+ */
+#define PSST_L10N_NAMED_ID(str)                                             \
+    ([]() -> ::psst::l10n::static_named_id {                                \
+        struct literal {                                                    \
+            static constexpr char const*                                    \
+            get() { return str; }                                           \
+            static constexpr ::std::size_t                                  \
+            size() { return sizeof(str) - 1; }                              \
+        };                                                                  \
+        return ::psst::l10n::detail::make_static_named_id<literal>();       \
+    }())
+
+#endif /* PUSHKIN_L10N_STATIC_PLACEHOLDERS_HPP_ */
@@ -0,0 +1,136 @@
+/*
+ * translation_cache.hpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: zmij
+ */
+
+#ifndef PUSHKIN_L10N_TRANSLATION_CACHE_HPP_
+#define PUSHKIN_L10N_TRANSLATION_CACHE_HPP_
+
+#include <pushkin/l10n/message.hpp>
+#include <pushkin/l10n/lru_cache.hpp>
+#include <pushkin/l10n/format_template.hpp>
+
+#include <limits>
+#include <locale>
+#include <memory>
+
+namespace psst {
+namespace l10n {
+
+/**
+ * Cache of translated message templates.
+ * Resolves a message text in a locale, domain and plural number to the
+ * translated and parsed template once and reuses it for subsequent renders.
+ * The translations are taken from the locale's
+ * ::boost::locale::message_format facet. Cached translations are keyed
+ * by the facet and keep the locale they were translated for alive, so
+ * the facet's address is not reused while a translation is cached.
+ *
+ * Plural messages are cached per plural form for locales with mapped
+ * catalogs (see mo_message_format), and per plural number otherwise,
+ * as the plural rule of other message_format facets is not known.
+ *
+ * Messages constructed from dense ids of a generated message_table are
+ * translated all at once per locale and domain when first rendered, and
+ * are looked up by index afterwards.
+ */
+class translation_cache {
+public:
+    static constexpr ::std::size_t default_capacity = 1 << 16;
+    /**
+     * Domain id to use the message's domain, or the default domain
+     * if the message doesn't have one. message_format facets return -1
+     * for an unknown domain, so the value is not a domain id any facet
+     * can return.
+     */
+    static constexpr int message_domain = ::std::numeric_limits<int>::min();
+public:
+    explicit
+    translation_cache(::std::size_t capacity = default_capacity);
+    ~translation_cache();
+
+    translation_cache(translation_cache const&) = delete;
+    translation_cache&
+    operator = (translation_cache const&) = delete;
+
+    /**
+     * Process-wide cache used by message formatting
+     * @return
+     */
+    static translation_cache&
+    instance();
+
+    /**
+     * Get a translated template for a message text
+     * @param loc       Locale to translate to
+     * @param text      Message text
+     * @param n         Plural number, ignored for non-plural messages
+     * @param domain_id Id of domain in the locale's message_format facet,
+     *                  message_domain to use the domain of the message
+     * @return Translated template
+     */
+    interned_string
+    translate(::std::locale const& loc, detail::message_text const& text,
+            int n, int domain_id = message_domain);
+    /**
+     * Get a translated and parsed template for a message text
+     * @param loc       Locale to translate to
+     * @param text      Message text
+     * @param n         Plural number, ignored for non-plural messages
+     * @param domain_id Id of domain in the locale's message_format facet,
+     *                  message_domain to use the domain of the message
+     * @return Parsed template
+     */
+    format_template_ptr
+    get_template(::std::locale const& loc, detail::message_text const& text,
+            int n, int domain_id = message_domain);
+
+    /**
+     * Resolve a domain name to id in the locale's message_format facet
+     * @param loc
+     * @param domain Domain name, null for the default domain
+     * @return Domain id, 0 if the locale has no message_format facet
+     */
+    static int
+    domain_id(::std::locale const& loc, interned_string const& domain);
+
+    ::std::size_t
+    capacity() const;
+    /**
+     * Set maximum count of cached translations. Least recently used
+     * translations are evicted.
+     * @param
+     */
+    void
+    set_capacity(::std::size_t);
+    /**
+     * Remove cached translations of a locale's message_format facet,
+     * e.g. when the locale's catalogs are replaced. Translations for other
+     * locales stay cached.
+     * @param loc
+     */
+    void
+    release(::std::locale const& loc);
+    /**
+     * Remove all cached translations. Locales are released when the
+     * templates taken from the cache are destroyed.
+     */
+    void
+    clear();
+
+    cache_stats
+    stats() const;
+    void
+    reset_stats();
+private:
+    struct impl;
+    using pimpl = ::std::unique_ptr<impl>;
+    pimpl pimpl_;
+};
+
+}  /* namespace l10n */
+}  /* namespace psst */
+
+#endif /* PUSHKIN_L10N_TRANSLATION_CACHE_HPP_ */
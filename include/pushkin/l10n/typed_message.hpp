@@ -0,0 +1,653 @@
+/*
+ * typed_message.hpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: zmij
+ */
+
+#ifndef PUSHKIN_L10N_TYPED_MESSAGE_HPP_
+#define PUSHKIN_L10N_TYPED_MESSAGE_HPP_
+
+#include <pushkin/l10n/message.hpp>
+#include <pushkin/l10n/static_placeholders.hpp>
+#include <pushkin/l10n/translation_cache.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace psst {
+namespace l10n {
+
+template < typename ... Args >
+class typed_message;
+
+namespace detail {
+
+//@{
+/** @name Compile-time placeholder checks */
+/**
+ * Set of placeholder numbers used in a message, bit 0 is {1}
+ */
+using placeholder_set = ::std::uint64_t;
+/** Maximum count of arguments of a typed message */
+constexpr ::std::size_t max_typed_arguments = 64;
+
+constexpr placeholder_set
+placeholder_bit(::std::size_t number, ::std::size_t count)
+{
+    return number == 0 || number > count ?
+            throw ::std::logic_error{"Placeholder number is out of range of "
+                "message arguments"} :
+            placeholder_set{1} << (number - 1);
+}
+
+constexpr placeholder_set
+used_placeholders(char const* str, ::std::size_t pos, ::std::size_t size,
+        ::std::size_t count, placeholder_set used);
+
+constexpr placeholder_set
+used_placeholders_number(char const* str, ::std::size_t b, ::std::size_t e,
+        ::std::size_t size, ::std::size_t count, placeholder_set used)
+{
+    return b == e ? throw ::std::logic_error{"Only numbered placeholders "
+                "can be used in a typed message"} :
+           e - b > 2 ? throw ::std::logic_error{"Placeholder number is "
+                "out of range of message arguments"} :
+           used_placeholders(str, placeholder_end(str, e, size), size, count,
+                   used | placeholder_bit(parse_number(str, b, e), count));
+}
+
+constexpr placeholder_set
+used_placeholders_brace(char const* str, ::std::size_t b, ::std::size_t size,
+        ::std::size_t count, placeholder_set used)
+{
+    return b == size ? used :
+           b + 1 < size && str[b + 1] == '{' ?
+                   used_placeholders(str, b + 2, size, count, used) :
+           used_placeholders_number(str, b + 1, skip_digits(str, b + 1, size),
+                   size, count, used);
+}
+
+/**
+ * Set of placeholders used in a message string, throws
+ * ::std::logic_error if a placeholder is invalid, named or it's number
+ * is greater than count of arguments. Used in constant expressions,
+ * the error becomes a compilation error.
+ * @param str       Message string
+ * @param pos       Position to start from
+ * @param size      Length of the string
+ * @param count     Count of arguments
+ * @param used      Placeholders found so far
+ */
+constexpr placeholder_set
+used_placeholders(char const* str, ::std::size_t pos, ::std::size_t size,
+        ::std::size_t count, placeholder_set used = 0)
+{
+    return used_placeholders_brace(str, find_char(str, pos, size, '{'),
+            size, count, used);
+}
+
+constexpr placeholder_set
+all_placeholders(::std::size_t count)
+{
+    return count == max_typed_arguments ?
+            ~placeholder_set{0} : (placeholder_set{1} << count) - 1;
+}
+
+/**
+ * @return The string if all the arguments have placeholders
+ */
+constexpr char const*
+check_all_used(char const* str, placeholder_set used, ::std::size_t count)
+{
+    return used == all_placeholders(count) ? str :
+            throw ::std::logic_error{"Not all arguments of a typed message "
+                "are used in the message"};
+}
+
+/**
+ * @return The string if it is a valid message with count arguments
+ */
+template < ::std::size_t N >
+constexpr char const*
+check_message(char const (&str)[N], ::std::size_t count)
+{
+    return check_all_used(str, used_placeholders(str, 0, N - 1, count), count);
+}
+
+/**
+ * @return The plural string if the singular and the plural forms are
+ *         valid messages and together use all the arguments
+ */
+template < ::std::size_t N, ::std::size_t M >
+constexpr char const*
+check_plural(char const (&singular)[N], char const (&plural)[M],
+        ::std::size_t count)
+{
+    return check_all_used(plural,
+            used_placeholders(singular, 0, N - 1, count) |
+            used_placeholders(plural, 0, M - 1, count), count);
+}
+//@}
+
+/**
+ * Interned text of a message with static strings. The texts are cached
+ * per thread by addresses of the strings, so the strings must have
+ * static storage duration, e.g. be string literals.
+ */
+message_text const&
+static_message_text(int type, char const* context, char const* id,
+        char const* plural, char const* domain);
+
+template < typename ... Args >
+struct first_is_integral : ::std::false_type {};
+template < typename T, typename ... Args >
+struct first_is_integral< T, Args... > : ::std::is_integral<T> {};
+
+template < typename T >
+struct is_string_arg : ::std::false_type {};
+template <>
+struct is_string_arg<::std::string> : ::std::true_type {};
+template <>
+struct is_string_arg<char const*> : ::std::true_type {};
+template <>
+struct is_string_arg<char*> : ::std::true_type {};
+
+template < typename T >
+struct is_message_arg : ::std::is_same<T, message> {};
+template < typename ... Args >
+struct is_message_arg< typed_message<Args...> > : ::std::true_type {};
+
+/**
+ * Arithmetic type written as a number, not a character or a boolean
+ */
+template < typename T >
+struct is_number_arg : ::std::integral_constant< bool,
+    ::std::is_arithmetic<T>::value &&
+    !::std::is_same<T, bool>::value &&
+    !::std::is_same<T, char>::value &&
+    !::std::is_same<T, signed char>::value &&
+    !::std::is_same<T, unsigned char>::value > {};
+
+//@{
+/** @name Appending arguments of typed messages */
+template < typename T >
+typename ::std::enable_if< is_number_arg<T>::value &&
+    ::std::is_integral<T>::value && ::std::is_signed<T>::value, bool >::type
+append_typed(::std::string& out, T const& v, ::std::locale const& loc, int)
+{
+    return format_template::append_integer(out, static_cast<long long>(v), loc);
+}
+template < typename T >
+typename ::std::enable_if< is_number_arg<T>::value &&
+    ::std::is_unsigned<T>::value, bool >::type
+append_typed(::std::string& out, T const& v, ::std::locale const& loc, int)
+{
+    return format_template::append_integer(out,
+            static_cast<unsigned long long>(v), loc);
+}
+template < typename T >
+typename ::std::enable_if< ::std::is_same<T, double>::value ||
+    ::std::is_same<T, float>::value, bool >::type
+append_typed(::std::string& out, T const& v, ::std::locale const& loc, int)
+{
+    return format_template::append_double(out, v, loc);
+}
+template < typename T >
+typename ::std::enable_if< is_string_arg<T>::value, bool >::type
+append_typed(::std::string& out, T const& v, ::std::locale const&, int)
+{
+    out += v;
+    return true;
+}
+template < typename T >
+typename ::std::enable_if< is_message_arg<T>::value, bool >::type
+append_typed(::std::string& out, T const& v, ::std::locale const& loc,
+        int domain_id)
+{
+    v.render(out, loc, domain_id);
+    return true;
+}
+/**
+ * Other values are written to a stream
+ */
+template < typename T >
+typename ::std::enable_if< !(is_number_arg<T>::value &&
+    !::std::is_same<T, long double>::value) &&
+    !is_string_arg<T>::value && !is_message_arg<T>::value, bool >::type
+append_typed(::std::string&, T const&, ::std::locale const&, int)
+{
+    return false;
+}
+//@}
+
+/**
+ * Call a predicate with the element of a tuple at a run-time index
+ */
+template < ::std::size_t I, ::std::size_t N >
+struct tuple_element_visitor {
+    template < typename Tuple, typename Func >
+    static bool
+    visit(Tuple const& t, ::std::size_t idx, Func const& f)
+    {
+        if (idx == I)
+            return f(::std::get<I>(t));
+        return tuple_element_visitor<I + 1, N>::visit(t, idx, f);
+    }
+};
+
+template < ::std::size_t N >
+struct tuple_element_visitor<N, N> {
+    template < typename Tuple, typename Func >
+    static bool
+    visit(Tuple const&, ::std::size_t, Func const&)
+    {
+        return false;
+    }
+};
+
+template < typename Tuple, typename Func >
+bool
+visit_element(Tuple const& t, ::std::size_t idx, Func const& f)
+{
+    return tuple_element_visitor<0, ::std::tuple_size<Tuple>::value>::visit(
+            t, idx, f);
+}
+
+/**
+ * Arguments of a typed message for format_template, dispatched by
+ * the argument types without virtual calls.
+ */
+template < typename Tuple >
+struct typed_arguments {
+    Tuple const&        args;
+    message_text const& text;
+    int                 inherited_domain;
+
+    struct is_plain_arg {
+        template < typename T >
+        bool
+        operator()(T const&) const
+        {
+            return ::std::is_arithmetic<T>::value || is_string_arg<T>::value;
+        }
+    };
+    struct write_arg {
+        ::std::ostream& os;
+        template < typename T >
+        bool
+        operator()(T const& v) const
+        {
+            os << v;
+            return true;
+        }
+    };
+    struct append_arg {
+        ::std::string&          out;
+        ::std::locale const&    loc;
+        int                     domain_id;
+        template < typename T >
+        bool
+        operator()(T const& v) const
+        {
+            return append_typed(out, v, loc, domain_id);
+        }
+    };
+
+    ::std::size_t
+    size() const
+    { return ::std::tuple_size<Tuple>::value; }
+    bool
+    is_plain(::std::size_t idx) const
+    {
+        return visit_element(args, idx, is_plain_arg{});
+    }
+    void
+    write(::std::ostream& os, ::std::size_t idx) const
+    {
+        visit_element(args, idx, write_arg{os});
+    }
+    bool
+    append(::std::string& out, ::std::size_t idx,
+            ::std::locale const& loc) const
+    {
+        return visit_element(args, idx, append_arg{out, loc, domain_id(loc)});
+    }
+    int
+    domain_id(::std::locale const& loc) const
+    {
+        if (!text.domain().is_null())
+            return translation_cache::domain_id(loc, text.domain());
+        return inherited_domain;
+    }
+};
+
+/**
+ * Feed elements of a tuple starting with I to a message
+ */
+template < ::std::size_t I, ::std::size_t N >
+struct tuple_feeder {
+    template < typename Tuple >
+    static void
+    feed(message& msg, Tuple const& t, ::std::size_t first)
+    {
+        if (I >= first)
+            msg << ::std::get<I>(t);
+        tuple_feeder<I + 1, N>::feed(msg, t, first);
+    }
+};
+
+template < ::std::size_t N >
+struct tuple_feeder<N, N> {
+    template < typename Tuple >
+    static void
+    feed(message&, Tuple const&, ::std::size_t)
+    {}
+};
+
+template < typename Tuple >
+int
+tuple_plural_number(Tuple const& t, ::std::true_type)
+{
+    return static_cast<int>(::std::get<0>(t));
+}
+
+template < typename Tuple >
+int
+tuple_plural_number(Tuple const&, ::std::false_type)
+{
+    return 0;
+}
+
+/**
+ * Plural number of a typed message, the first argument if it is an integer
+ */
+template < typename ... Args >
+int
+tuple_plural_number(::std::tuple<Args...> const& t)
+{
+    return tuple_plural_number(t, first_is_integral<Args...>{});
+}
+
+}  /* namespace detail */
+
+/**
+ * Tag to construct a plural message template
+ */
+struct plural_message_tag {};
+constexpr plural_message_tag plural_message{};
+
+/**
+ * Text of a message with types of it's arguments known at compile time.
+ * The message strings are checked when the template is constructed:
+ * placeholders must be numbered and refer to the arguments, and each
+ * argument must be used. Plural messages take the plural number as the
+ * first argument, it must be an integer, and it is the placeholder {1}.
+ * When the template is declared constexpr, the checks are done by the
+ * compiler and an invalid message is a compilation error, otherwise
+ * ::std::logic_error is thrown.
+ *
+ * @code
+ * constexpr message_template<::std::string, int> received{
+ *         "{1} received {2} messages"};
+ * constexpr message_template<int> files{
+ *         "{1} file", "{1} files", plural_message};
+ *
+ * auto msg = received("Alice", 42);
+ * ::std::cout << msg << files(3);
+ * @endcode
+ *
+ * The strings are not copied, they must have static storage duration.
+ */
+template < typename ... Args >
+class message_template {
+public:
+    static_assert(sizeof...(Args) <= detail::max_typed_arguments,
+            "Too many arguments of a typed message");
+    using message_type      = message::message_type;
+    using message_object    = typed_message<Args...>;
+public:
+    /**
+     * Simple message template
+     */
+    template < ::std::size_t N >
+    constexpr
+    message_template(char const (&id)[N])
+        : message_template{ message_type::simple, nullptr,
+            detail::check_message(id, sizeof...(Args)), nullptr, nullptr } {}
+    /**
+     * Message template with a context
+     */
+    template < ::std::size_t M, ::std::size_t N >
+    constexpr
+    message_template(char const (&context)[M], char const (&id)[N])
+        : message_template{ message_type::context, context,
+            detail::check_message(id, sizeof...(Args)), nullptr, nullptr } {}
+    /**
+     * Plural message template
+     */
+    template < ::std::size_t N, ::std::size_t M >
+    constexpr
+    message_template(char const (&singular)[N], char const (&plural)[M],
+            plural_message_tag)
+        : message_template{ message_type::plural, nullptr, singular,
+            detail::check_plural(singular, plural, sizeof...(Args)), nullptr }
+    {
+        static_assert(detail::first_is_integral<Args...>::value,
+                "Plural number must be the first argument of a plural "
+                "message and must be an integer");
+    }
+    /**
+     * Plural message template with a context
+     */
+    template < ::std::size_t L, ::std::size_t N, ::std::size_t M >
+    constexpr
+    message_template(char const (&context)[L], char const (&singular)[N],
+            char const (&plural)[M], plural_message_tag)
+        : message_template{ message_type::context_plural, context, singular,
+            detail::check_plural(singular, plural, sizeof...(Args)), nullptr }
+    {
+        static_assert(detail::first_is_integral<Args...>::value,
+                "Plural number must be the first argument of a plural "
+                "message and must be an integer");
+    }
+
+    /**
+     * Copy of the template in a domain. The text of the message is cached
+     * by the address of the domain, so the domain must be a string with
+     * static storage duration, like the strings of the template.
+     * @param domain
+     * @return
+     */
+    template < ::std::size_t N >
+    constexpr message_template
+    in_domain(char const (&domain)[N]) const
+    {
+        return message_template{ type_, context_, id_, plural_, domain };
+    }
+    /**
+     * A mutable buffer can change or go away while the template is in use
+     */
+    template < ::std::size_t N >
+    message_template
+    in_domain(char (&domain)[N]) const = delete;
+
+    constexpr message_type
+    type() const
+    { return type_; }
+    constexpr char const*
+    context() const
+    { return context_; }
+    constexpr char const*
+    id() const
+    { return id_; }
+    constexpr char const*
+    plural() const
+    { return plural_; }
+    constexpr char const*
+    domain() const
+    { return domain_; }
+    constexpr bool
+    has_plural() const
+    { return plural_ != nullptr; }
+
+    /**
+     * Interned text of the message
+     */
+    detail::message_text const&
+    text() const
+    {
+        return detail::static_message_text(static_cast<int>(type_),
+                context_, id_, plural_, domain_);
+    }
+
+    /**
+     * Create a message with the arguments
+     */
+    template < typename ... T >
+    message_object
+    operator()(T&& ... args) const
+    {
+        static_assert(sizeof...(T) == sizeof...(Args),
+                "Count of arguments doesn't match the message template");
+        return message_object{ *this, ::std::forward<T>(args)... };
+    }
+private:
+    constexpr
+    message_template(message_type type, char const* context, char const* id,
+            char const* plural, char const* domain)
+        : type_{type}, context_{context}, id_{id}, plural_{plural},
+          domain_{domain} {}
+
+    message_type    type_;
+    char const*     context_;
+    char const*     id_;
+    char const*     plural_;
+    char const*     domain_;
+};
+
+/**
+ * Message with arguments of types known at compile time.
+ * The arguments are stored in a tuple and rendered without type erasure
+ * and virtual calls. The message can be converted to a message object,
+ * e.g. to collect it for translation or to pass to functions accepting
+ * messages.
+ */
+template < typename ... Args >
+class typed_message {
+public:
+    using template_type     = message_template<Args...>;
+    using arguments_type    = ::std::tuple<Args...>;
+public:
+    template < typename ... T >
+    explicit
+    typed_message(template_type const& tmpl, T&& ... args)
+        : tmpl_(tmpl), args_(::std::forward<T>(args)...) {}
+
+    template_type const&
+    get_template() const
+    { return tmpl_; }
+    arguments_type const&
+    args() const
+    { return args_; }
+    /**
+     * Plural number, the first argument of a plural message
+     */
+    int
+    get_n() const
+    {
+        return tmpl_.has_plural() ? detail::tuple_plural_number(args_) : 0;
+    }
+
+    /**
+     * Get a string translated to specified locale
+     * @param loc
+     * @return
+     */
+    ::std::string
+    str(::std::locale const& loc = ::std::locale{}) const
+    {
+        ::std::string out;
+        render(out, loc);
+        return out;
+    }
+    /**
+     * Append translated and formatted message to a string
+     * @param out
+     * @param loc
+     * @param domain_id Domain to use if the message has no domain
+     * @return The string
+     */
+    ::std::string&
+    render(::std::string& out, ::std::locale const& loc = ::std::locale{},
+            int domain_id = 0) const
+    {
+        auto const& text = tmpl_.text();
+        auto tmpl = translation_cache::instance().get_template(loc, text,
+                get_n(), text.domain().is_null() ?
+                        domain_id : translation_cache::message_domain);
+        tmpl->render(out, detail::typed_arguments<arguments_type>{
+                args_, text, domain_id }, loc);
+        return out;
+    }
+
+    /**
+     * Convert to a message with the same text and arguments
+     */
+    message
+    to_message() const
+    {
+        message msg;
+        message::domain_type domain;
+        if (tmpl_.domain())
+            domain = ::std::string{ tmpl_.domain() };
+        switch (tmpl_.type()) {
+            case message::message_type::context:
+                msg = message{ tmpl_.context(), tmpl_.id(), domain };
+                break;
+            case message::message_type::plural:
+                msg = message{ tmpl_.id(), tmpl_.plural(), get_n(), domain };
+                break;
+            case message::message_type::context_plural:
+                msg = message{ tmpl_.context(), tmpl_.id(), tmpl_.plural(),
+                        get_n(), domain };
+                break;
+            default:
+                msg = message{ tmpl_.id(), domain };
+                break;
+        }
+        // The plural number is not an argument of a message
+        detail::tuple_feeder<0, sizeof...(Args)>::feed(msg, args_,
+                tmpl_.has_plural() ? 1 : 0);
+        return msg;
+    }
+    operator message() const
+    { return to_message(); }
+private:
+    template_type   tmpl_;
+    arguments_type  args_;
+
+    friend ::std::ostream&
+    operator << (::std::ostream& os, typed_message const& val)
+    {
+        ::std::ostream::sentry s(os);
+        if (s) {
+            ::std::string out;
+            val.render(out, os.getloc(),
+                    ::boost::locale::ios_info::get(os).domain_id());
+            os << out;
+        }
+        return os;
+    }
+};
+
+}  /* namespace l10n */
+}  /* namespace psst */
+
+#endif /* PUSHKIN_L10N_TYPED_MESSAGE_HPP_ */
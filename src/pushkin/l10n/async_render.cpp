@@ -0,0 +1,123 @@
+/*
+ * async_render.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: zmij
+ */
+
+#include <pushkin/l10n/async_render.hpp>
+
+#include <atomic>
+
+namespace psst {
+namespace l10n {
+
+namespace detail {
+
+/**
+ * Shared state of a rendering. The status is changed from pending once,
+ * either to running by the task or to finished by cancellation, so the
+ * promise is satisfied only once.
+ */
+struct async_render_state {
+    enum status_type {
+        pending,
+        running,
+        finished
+    };
+
+    ::std::atomic<int>              status;
+    ::std::atomic<bool>             cancelled;
+    ::std::promise<::std::string>   promise;
+
+    async_render_state() : status{pending}, cancelled{false} {}
+
+    bool
+    start()
+    {
+        int expected = pending;
+        return status.compare_exchange_strong(expected, running);
+    }
+    bool
+    fail(::std::exception_ptr e, bool cancel = false)
+    {
+        int expected = pending;
+        if (!status.compare_exchange_strong(expected, finished))
+            return false;
+        cancelled = cancel;
+        promise.set_exception(e);
+        return true;
+    }
+    bool
+    cancel()
+    {
+        return fail(::std::make_exception_ptr(render_cancelled{}), true);
+    }
+};
+
+}  /* namespace detail */
+
+namespace {
+
+using state_ptr = ::std::shared_ptr<detail::async_render_state>;
+
+/**
+ * Renders the message when run. If the executor destroys the task without
+ * running it, the rendering is cancelled.
+ */
+struct render_task {
+    state_ptr       state;
+    message         msg;
+    ::std::locale   loc;
+
+    render_task(state_ptr const& s, message const& m, ::std::locale const& l)
+        : state{s}, msg{m}, loc{l} {}
+    ~render_task()
+    {
+        state->cancel();
+    }
+
+    void
+    run()
+    {
+        if (!state->start())
+            return;
+        try {
+            state->promise.set_value(msg.str(loc));
+        } catch (...) {
+            state->promise.set_exception(::std::current_exception());
+        }
+        state->status = detail::async_render_state::finished;
+    }
+};
+
+}  /* namespace  */
+
+bool
+render_handle::cancel()
+{
+    return state_ && state_->cancel();
+}
+
+bool
+render_handle::cancelled() const
+{
+    return state_ && state_->cancelled;
+}
+
+render_handle
+render_async(message const& msg, ::std::locale const& loc, executor const& exec)
+{
+    auto state = ::std::make_shared<detail::async_render_state>();
+    render_handle handle{state->promise.get_future(), state};
+    auto task = ::std::make_shared<render_task>(state, msg, loc);
+    try {
+        exec([task]() { task->run(); });
+    } catch (...) {
+        state->fail(::std::current_exception());
+    }
+    return handle;
+}
+
+}  /* namespace l10n */
+}  /* namespace psst */
@@ -0,0 +1,198 @@
+/*
+ * batch_renderer.hpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: zmij
+ */
+
+#ifndef PUSHKIN_L10N_BATCH_RENDERER_HPP_
+#define PUSHKIN_L10N_BATCH_RENDERER_HPP_
+
+#include <pushkin/l10n/message.hpp>
+#include <pushkin/l10n/translation_cache.hpp>
+#include "format_context.hpp"
+#include "intern_pool.hpp"
+#include "number_format.hpp"
+
+#include <boost/variant/get.hpp>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace psst {
+namespace l10n {
+namespace detail {
+
+/**
+ * Renders messages of a batch to a locale. Facets of the locale, domain
+ * ids and translated templates are looked up once per batch.
+ * The renderer refers to texts of the messages, so it must not outlive
+ * the batch.
+ */
+class batch_renderer {
+public:
+    explicit
+    batch_renderer(::std::locale const& loc)
+        : loc_(loc), plain_numbers_{get_locale_info(loc).plain_numbers},
+          cache_(translation_cache::instance())
+    {
+    }
+
+    /**
+     * Append a message, the same output as message::render or
+     * message::render_format produce
+     * @param out
+     * @param msg
+     * @param domain_id Domain to use if the message has no domain
+     * @param format    Format the message even if it has no arguments
+     */
+    void
+    render(::std::string& out, message const& msg, int domain_id, bool format)
+    {
+        auto const& text = msg.text_;
+        int tmpl_domain = text.domain().is_null() ?
+                domain_id : translation_cache::message_domain;
+        auto const& tmpl = get_template(text, msg.n_, tmpl_domain);
+        if (!format && !msg.has_plural() && !msg.has_format_args()) {
+            out += tmpl.str().str();
+            return;
+        }
+        if (!text.domain().is_null())
+            domain_id = resolve_domain(text.domain());
+        tmpl.render(out, arguments{*this, msg, domain_id}, loc_);
+    }
+private:
+    struct template_key {
+        message_text const* text;
+        int                 n;
+        int                 domain_id;
+
+        bool
+        operator == (template_key const& rhs) const
+        {
+            return *text == *rhs.text && n == rhs.n &&
+                    domain_id == rhs.domain_id;
+        }
+    };
+    struct template_key_hash {
+        ::std::size_t
+        operator()(template_key const& key) const
+        {
+            auto h = hash_combine(key.text->hash(), ::std::hash<int>{}(key.n));
+            return hash_combine(h, ::std::hash<int>{}(key.domain_id));
+        }
+    };
+    using template_map = ::std::unordered_map<template_key,
+            format_template_ptr, template_key_hash>;
+    using domain_list = ::std::vector<::std::pair<interned_string, int>>;
+
+    /**
+     * Arguments of a message, preceded by the plural number if the message
+     * has a plural form. Nested messages are rendered by the batch renderer.
+     */
+    struct arguments {
+        batch_renderer&     renderer;
+        message const&      msg;
+        int                 domain;
+
+        ::std::size_t
+        plural() const
+        { return msg.has_plural() ? 1 : 0; }
+        arg_holder const&
+        arg(::std::size_t idx) const
+        { return msg.args_.begin()[idx - plural()]; }
+
+        ::std::size_t
+        size() const
+        { return msg.args_.size() + plural(); }
+        bool
+        is_plain(::std::size_t idx) const
+        { return idx < plural() || arg(idx).is_plain(); }
+        void
+        write(::std::ostream& os, ::std::size_t idx) const
+        {
+            if (idx < plural()) {
+                os << msg.n_;
+            } else {
+                arg(idx).write(os);
+            }
+        }
+        bool
+        append(::std::string& out, ::std::size_t idx,
+                ::std::locale const& loc) const
+        {
+            if (idx < plural()) {
+                if (!renderer.plain_numbers_)
+                    return false;
+                append_integer(out, msg.n_);
+                return true;
+            }
+            auto const& v = arg(idx);
+            switch (v.kind()) {
+                case arg_holder::int_value:
+                    if (!renderer.plain_numbers_)
+                        return false;
+                    append_integer(out, ::boost::get<int>(v.value()));
+                    return true;
+                case arg_holder::long_value:
+                    if (!renderer.plain_numbers_)
+                        return false;
+                    append_integer(out, ::boost::get<long>(v.value()));
+                    return true;
+                case arg_holder::double_value:
+                    if (!renderer.plain_numbers_)
+                        return false;
+                    append_double(out, ::boost::get<double>(v.value()));
+                    return true;
+                case arg_holder::message_value:
+                    renderer.render(out,
+                            ::boost::get<nested_message>(v.value()).get(),
+                            domain, false);
+                    return true;
+                default:
+                    return v.append(out, loc, 0);
+            }
+        }
+        int
+        domain_id(::std::locale const&) const
+        { return domain; }
+    };
+
+    format_template const&
+    get_template(message_text const& text, int n, int domain_id)
+    {
+        // The translation cache selects a template by plural form, the
+        // batch by plural number
+        template_key key{ &text, text.plural().is_null() ? 0 : n, domain_id };
+        auto f = templates_.find(key);
+        if (f == templates_.end()) {
+            f = templates_.emplace(key,
+                    cache_.get_template(loc_, text, n, domain_id)).first;
+        }
+        return *f->second;
+    }
+    int
+    resolve_domain(interned_string const& domain)
+    {
+        for (auto const& d : domains_) {
+            if (d.first == domain)
+                return d.second;
+        }
+        auto id = translation_cache::domain_id(loc_, domain);
+        domains_.emplace_back(domain, id);
+        return id;
+    }
+
+    ::std::locale const&    loc_;
+    bool                    plain_numbers_;
+    translation_cache&      cache_;
+    template_map            templates_;
+    domain_list             domains_;
+};
+
+}  /* namespace detail */
+
+}  /* namespace l10n */
+}  /* namespace psst */
+
+#endif /* PUSHKIN_L10N_BATCH_RENDERER_HPP_ */
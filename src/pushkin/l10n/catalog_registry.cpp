@@ -0,0 +1,325 @@
+/*
+ * catalog_registry.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: zmij
+ */
+
+#include <pushkin/l10n/catalog_registry.hpp>
+#include <pushkin/l10n/translation_cache.hpp>
+#include "format_context.hpp"
+
+#include <boost/locale/generator.hpp>
+
+#include <atomic>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+
+namespace psst {
+namespace l10n {
+
+namespace {
+
+/**
+ * Immutable set of locales
+ */
+struct snapshot {
+    using locale_map = ::std::unordered_map<::std::string, ::std::locale>;
+
+    ::std::size_t   version;
+    locale_map      locales;
+};
+
+using snapshot_ptr = ::std::shared_ptr<snapshot const>;
+
+/**
+ * Snapshot being read by a thread. A replaced snapshot is destroyed
+ * when no thread reads it, threads don't own snapshots after reading.
+ */
+struct hazard_slot {
+    ::std::atomic<snapshot const*>  snap{nullptr};
+    // Guarded by the mutex of the hazard list
+    bool                            used = false;
+};
+
+/**
+ * Hazard slots of all threads. Slots of finished threads are reused.
+ */
+struct hazard_list {
+    using mutex_type    = ::std::mutex;
+    using lock_type     = ::std::lock_guard<mutex_type>;
+
+    mutex_type                  mtx;
+    ::std::deque<hazard_slot>   slots;
+
+    hazard_slot*
+    acquire()
+    {
+        lock_type lock{mtx};
+        for (auto& s : slots) {
+            if (!s.used) {
+                s.used = true;
+                return &s;
+            }
+        }
+        slots.emplace_back();
+        slots.back().used = true;
+        return &slots.back();
+    }
+    void
+    release(hazard_slot* slot)
+    {
+        lock_type lock{mtx};
+        slot->snap.store(nullptr);
+        slot->used = false;
+    }
+    bool
+    in_use(snapshot const* snap)
+    {
+        lock_type lock{mtx};
+        for (auto const& s : slots) {
+            if (s.snap.load() == snap)
+                return true;
+        }
+        return false;
+    }
+    /**
+     * Wait until no thread reads the snapshot
+     */
+    void
+    wait(snapshot const* snap)
+    {
+        while (in_use(snap)) {
+            ::std::this_thread::yield();
+        }
+    }
+};
+
+hazard_list&
+hazards()
+{
+    // Never destroyed, threads can exit after static objects are destroyed
+    static hazard_list* list = new hazard_list{};
+    return *list;
+}
+
+thread_local hazard_slot* thread_hazard = nullptr;
+// Set when the thread's slot is released on exit, a slot acquired after
+// that, e.g. by destructors of static objects, is not released
+thread_local bool thread_finished = false;
+
+struct hazard_releaser {
+    ~hazard_releaser()
+    {
+        thread_finished = true;
+        if (thread_hazard)
+            hazards().release(thread_hazard);
+        thread_hazard = nullptr;
+    }
+};
+
+hazard_slot&
+get_hazard()
+{
+    if (!thread_hazard) {
+        thread_hazard = hazards().acquire();
+        if (!thread_finished) {
+            static thread_local hazard_releaser releaser;
+            (void)releaser;
+        }
+    }
+    return *thread_hazard;
+}
+
+/**
+ * Current snapshot of a registry, protected from destruction while
+ * the guard exists. Guards are not nested, a thread has one slot.
+ */
+class snapshot_guard {
+public:
+    explicit
+    snapshot_guard(::std::atomic<snapshot const*> const& current)
+        : slot_(get_hazard()), snap_{nullptr}
+    {
+        // The snapshot can be replaced and destroyed before the slot is
+        // set, the slot is published before checking it is still current
+        do {
+            snap_ = current.load();
+            slot_.snap.store(snap_);
+        } while (snap_ != current.load());
+    }
+    ~snapshot_guard()
+    {
+        slot_.snap.store(nullptr, ::std::memory_order_release);
+    }
+
+    snapshot_guard(snapshot_guard const&) = delete;
+    snapshot_guard&
+    operator = (snapshot_guard const&) = delete;
+
+    snapshot const&
+    operator *() const
+    { return *snap_; }
+    snapshot const*
+    operator ->() const
+    { return snap_; }
+private:
+    hazard_slot&        slot_;
+    snapshot const*     snap_;
+};
+
+}  /* namespace  */
+
+struct catalog_registry::impl {
+    using mutex_type    = ::std::mutex;
+    using lock_type     = ::std::lock_guard<mutex_type>;
+    using base_locales  = ::std::map<::std::string, ::std::locale>;
+
+    string_list const               paths;
+    string_list const               domains;
+
+    // Owned by writers, readers use the pointer
+    snapshot_ptr                    current;
+    ::std::atomic<snapshot const*>  current_ptr;
+    ::std::atomic<::std::size_t>    version;
+
+    // Writers' state
+    mutex_type                      mtx;
+    ::boost::locale::generator      gen;
+    base_locales                    bases;
+
+    impl(string_list const& p, string_list const& d)
+        : paths{p}, domains{d},
+          current{ ::std::make_shared<snapshot>() },
+          current_ptr{ current.get() }, version{0}
+    {
+    }
+
+    /**
+     * Find a locale in the current snapshot
+     * @return true if the locale is loaded
+     */
+    bool
+    find(::std::string const& name, ::std::locale& loc) const
+    {
+        snapshot_guard snap{current_ptr};
+        auto f = snap->locales.find(name);
+        if (f == snap->locales.end())
+            return false;
+        loc = f->second;
+        return true;
+    }
+
+    ::std::locale
+    load(::std::string const& name)
+    {
+        auto f = bases.find(name);
+        if (f == bases.end()) {
+            // Only facets other than messages are taken from the generated
+            // locale, so no domains are added to the generator
+            f = bases.emplace(name, gen(name)).first;
+        }
+        return catalog_locale(f->second, name, paths, domains);
+    }
+
+    void
+    publish(::std::shared_ptr<snapshot> snap)
+    {
+        snap->version = current->version + 1;
+        auto old = current;
+        current = snap;
+        current_ptr.store(snap.get());
+        version.store(snap->version, ::std::memory_order_release);
+        // Threads reading the old snapshot finish with copying a locale
+        hazards().wait(old.get());
+    }
+
+    ::std::locale
+    add(::std::string const& name)
+    {
+        lock_type lock{mtx};
+        auto f = current->locales.find(name);
+        if (f != current->locales.end())
+            return f->second;
+        auto loc = load(name);
+        auto snap = ::std::make_shared<snapshot>(*current);
+        snap->locales.emplace(name, loc);
+        publish(snap);
+        return loc;
+    }
+
+    void
+    reload()
+    {
+        lock_type lock{mtx};
+        auto snap = ::std::make_shared<snapshot>();
+        for (auto const& l : current->locales) {
+            snap->locales.emplace(l.first, load(l.first));
+        }
+        auto old = current;
+        publish(snap);
+        // Translations of the replaced catalogs are not used by new
+        // renders, translations of other locales stay cached
+        auto& cache = translation_cache::instance();
+        for (auto const& l : old->locales) {
+            cache.release(l.second);
+        }
+        // Idle threads don't keep the old catalogs
+        detail::release_thread_locales();
+    }
+};
+
+catalog_registry::catalog_registry(string_list const& paths,
+        string_list const& domains)
+    : pimpl_{ ::std::make_shared<impl>(paths, domains) }
+{
+}
+
+catalog_registry::~catalog_registry() = default;
+
+::std::locale
+catalog_registry::get(::std::string const& locale_name) const
+{
+    ::std::locale loc;
+    if (pimpl_->find(locale_name, loc))
+        return loc;
+    return pimpl_->add(locale_name);
+}
+
+void
+catalog_registry::reload()
+{
+    pimpl_->reload();
+}
+
+::std::future<void>
+catalog_registry::reload_async()
+{
+    // The state is kept alive by the task, the registry can be destroyed
+    // before the reload finishes
+    auto p = pimpl_;
+    return ::std::async(::std::launch::async, [p]() { p->reload(); });
+}
+
+::std::size_t
+catalog_registry::version() const
+{
+    return pimpl_->version.load(::std::memory_order_acquire);
+}
+
+catalog_registry::string_list
+catalog_registry::locales() const
+{
+    snapshot_guard snap{pimpl_->current_ptr};
+    string_list names;
+    for (auto const& l : snap->locales) {
+        names.push_back(l.first);
+    }
+    return names;
+}
+
+}  /* namespace l10n */
+}  /* namespace psst */
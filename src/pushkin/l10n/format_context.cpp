@@ -0,0 +1,210 @@
+/*
+ * format_context.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: zmij
+ */
+
+#include "format_context.hpp"
+#include "number_format.hpp"
+
+#include <boost/locale/formatting.hpp>
+
+#include <algorithm>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace psst {
+namespace l10n {
+namespace detail {
+
+namespace {
+
+/**
+ * Registered per thread caches
+ */
+struct thread_cache_list {
+    using mutex_type    = ::std::mutex;
+    using lock_type     = ::std::lock_guard<mutex_type>;
+
+    mutex_type                          mtx;
+    ::std::vector<thread_locale_cache*> caches;
+};
+
+thread_cache_list&
+thread_caches()
+{
+    // Never destroyed, threads can exit after static objects are destroyed
+    static thread_cache_list* list = new thread_cache_list{};
+    return *list;
+}
+
+}  /* namespace  */
+
+thread_locale_cache::thread_locale_cache()
+{
+    busy_.clear();
+    auto& list = thread_caches();
+    thread_cache_list::lock_type lock{list.mtx};
+    list.caches.push_back(this);
+}
+
+thread_locale_cache::~thread_locale_cache()
+{
+    auto& list = thread_caches();
+    thread_cache_list::lock_type lock{list.mtx};
+    list.caches.erase(::std::find(list.caches.begin(), list.caches.end(), this));
+}
+
+void
+release_thread_locales()
+{
+    auto& list = thread_caches();
+    thread_cache_list::lock_type lock{list.mtx};
+    for (auto cache : list.caches) {
+        ::std::lock_guard<thread_locale_cache> cache_lock{*cache};
+        cache->release_locales();
+    }
+}
+
+namespace {
+
+::std::size_t const locale_cache_size = 8;
+
+struct locale_entry {
+    ::std::locale   loc;
+    locale_info     info;
+};
+
+struct locale_cache : thread_locale_cache {
+    ::std::vector<locale_entry> entries;
+    ::std::size_t               next = 0;
+
+    locale_cache()
+    {
+        entries.reserve(locale_cache_size);
+    }
+
+    void
+    release_locales() override
+    {
+        entries.clear();
+        next = 0;
+    }
+
+    locale_info
+    get(::std::locale const& loc)
+    {
+        // Comparison of locales is a pointer comparison for locales
+        // created with facets, names are compared for named ones
+        for (auto const& e : entries) {
+            if (e.loc == loc)
+                return e.info;
+        }
+        using message_format = locale_info::message_format;
+        locale_info info{ nullptr, nullptr, plain_numbers(loc) };
+        if (::std::has_facet<message_format>(loc)) {
+            info.catalog = &::std::use_facet<message_format>(loc);
+            info.mapped = dynamic_cast<mo_message_format const*>(info.catalog);
+        }
+        if (entries.size() < locale_cache_size) {
+            entries.push_back(locale_entry{ loc, info });
+        } else {
+            entries[next] = locale_entry{ loc, info };
+            next = (next + 1) % locale_cache_size;
+        }
+        return info;
+    }
+};
+
+}  /* namespace  */
+
+locale_info
+get_locale_info(::std::locale const& loc)
+{
+    static thread_local locale_cache cache;
+    ::std::lock_guard<thread_locale_cache> lock{cache};
+    return cache.get(loc);
+}
+
+struct pooled_stream::context {
+    string_appender buf;
+    ::std::ostream  os;
+
+    context() : buf{}, os{&buf} {}
+
+    void
+    reset()
+    {
+        buf.target(nullptr);
+        os.clear();
+        os.flags(::std::ios_base::dec | ::std::ios_base::skipws);
+        os.width(0);
+        os.precision(6);
+        os.fill(' ');
+    }
+};
+
+namespace {
+
+using context_ptr   = ::std::unique_ptr<pooled_stream::context>;
+
+/**
+ * Streams of a thread, the streams keep the locales they are imbued with
+ */
+struct context_pool : thread_locale_cache {
+    ::std::vector<context_ptr>  contexts;
+
+    void
+    release_locales() override
+    {
+        contexts.clear();
+    }
+};
+
+context_pool&
+stream_pool()
+{
+    static thread_local context_pool pool;
+    return pool;
+}
+
+}  /* namespace  */
+
+pooled_stream::pooled_stream(::std::string& out, ::std::locale const& loc,
+        int domain_id)
+    : ctx_{nullptr}, os_{nullptr}
+{
+    {
+        auto& pool = stream_pool();
+        ::std::lock_guard<thread_locale_cache> lock{pool};
+        if (!pool.contexts.empty()) {
+            ctx_ = pool.contexts.back().release();
+            pool.contexts.pop_back();
+        }
+    }
+    if (!ctx_)
+        ctx_ = new context{};
+    ctx_->buf.target(&out);
+    os_ = &ctx_->os;
+    if (!(os_->getloc() == loc))
+        os_->imbue(loc);
+    ::boost::locale::ios_info::get(*os_).domain_id(domain_id);
+}
+
+pooled_stream::~pooled_stream()
+{
+    ctx_->reset();
+    try {
+        auto& pool = stream_pool();
+        ::std::lock_guard<thread_locale_cache> lock{pool};
+        pool.contexts.emplace_back(ctx_);
+    } catch (...) {
+        delete ctx_;
+    }
+}
+
+}  /* namespace detail */
+}  /* namespace l10n */
+}  /* namespace psst */
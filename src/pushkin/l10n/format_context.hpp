@@ -0,0 +1,152 @@
+/*
+ * format_context.hpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: zmij
+ */
+
+#ifndef PUSHKIN_L10N_FORMAT_CONTEXT_HPP_
+#define PUSHKIN_L10N_FORMAT_CONTEXT_HPP_
+
+#include <pushkin/l10n/mo_catalog.hpp>
+#include <boost/locale/message.hpp>
+
+#include <atomic>
+#include <locale>
+#include <ostream>
+#include <streambuf>
+#include <string>
+#include <thread>
+
+namespace psst {
+namespace l10n {
+namespace detail {
+
+/**
+ * Facets of a locale used for rendering
+ */
+struct locale_info {
+    using message_format = ::boost::locale::message_format<char>;
+
+    /** Message catalog facet, nullptr if the locale has none */
+    message_format const*   catalog;
+    /** The catalog facet if it uses mapped catalogs */
+    mo_message_format const* mapped;
+    /** Numbers are written without grouping and with a dot */
+    bool                    plain_numbers;
+};
+
+/**
+ * Get facets of a locale. A few recently used locales are cached per
+ * thread, the cached locales are kept alive until replaced or released
+ * by release_thread_locales, so the facet pointers stay valid while
+ * the locale is cached.
+ * @param loc
+ * @return
+ */
+locale_info
+get_locale_info(::std::locale const& loc);
+
+/**
+ * Per thread cache that keeps locales alive. The caches of all threads
+ * are registered, so that the locales can be released from another
+ * thread, e.g. when catalogs are reloaded and an idle thread still has
+ * the old ones. The owner thread locks the cache while using it, the
+ * lock is contended only while locales are released.
+ */
+class thread_locale_cache {
+public:
+    thread_locale_cache();
+    virtual ~thread_locale_cache();
+
+    thread_locale_cache(thread_locale_cache const&) = delete;
+    thread_locale_cache&
+    operator = (thread_locale_cache const&) = delete;
+
+    void
+    lock()
+    {
+        while (busy_.test_and_set(::std::memory_order_acquire))
+            ::std::this_thread::yield();
+    }
+    void
+    unlock()
+    {
+        busy_.clear(::std::memory_order_release);
+    }
+
+    /**
+     * Drop cached locales, called with the cache locked
+     */
+    virtual void
+    release_locales() = 0;
+private:
+    ::std::atomic_flag  busy_;
+};
+
+/**
+ * Release locales cached by all threads. Threads cache the locales they
+ * render with, so without releasing a thread that doesn't render anymore
+ * keeps the last locales alive.
+ */
+void
+release_thread_locales();
+
+/**
+ * Stream buffer appending output to a string
+ */
+class string_appender : public ::std::streambuf {
+public:
+    string_appender() : out_{nullptr} {}
+
+    void
+    target(::std::string* out)
+    { out_ = out; }
+protected:
+    int_type
+    overflow(int_type c) override
+    {
+        if (!traits_type::eq_int_type(c, traits_type::eof()))
+            out_->push_back(traits_type::to_char_type(c));
+        return traits_type::not_eof(c);
+    }
+    ::std::streamsize
+    xsputn(char_type const* s, ::std::streamsize n) override
+    {
+        out_->append(s, n);
+        return n;
+    }
+private:
+    ::std::string* out_;
+};
+
+/**
+ * Output stream appending to a string, borrowed from a per-thread pool.
+ * The stream is imbued with the locale and has the message domain set,
+ * formatting flags are default. The stream is returned to the pool
+ * on destruction.
+ */
+class pooled_stream {
+public:
+    pooled_stream(::std::string& out, ::std::locale const& loc, int domain_id);
+    ~pooled_stream();
+
+    pooled_stream(pooled_stream const&) = delete;
+    pooled_stream&
+    operator = (pooled_stream const&) = delete;
+
+    ::std::ostream&
+    stream()
+    { return *os_; }
+
+    struct context;
+private:
+    context*        ctx_;
+    ::std::ostream* os_;
+};
+
+}  /* namespace detail */
+}  /* namespace l10n */
+}  /* namespace psst */
+
+#endif /* PUSHKIN_L10N_FORMAT_CONTEXT_HPP_ */
@@ -0,0 +1,270 @@
+/*
+ * format_template.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: zmij
+ */
+
+#include <pushkin/l10n/format_template.hpp>
+#include "format_context.hpp"
+#include "number_format.hpp"
+
+#include <boost/locale/format.hpp>
+
+#include <cstdlib>
+#include <cstring>
+#include <ostream>
+
+namespace psst {
+namespace l10n {
+
+namespace {
+
+char const obrk     = '{';
+char const cbrk     = '}';
+char const eq       = '=';
+char const comma    = ',';
+char const quote    = '\'';
+
+bool
+is_number(::std::string const& key)
+{
+    for (auto c : key) {
+        if (c < '0' || '9' < c)
+            return false;
+    }
+    return true;
+}
+
+void
+imbue_stream(void* ptr, ::std::locale const& loc)
+{
+    static_cast<::std::ostream*>(ptr)->imbue(loc);
+}
+
+/**
+ * Restores stream state after writing an argument with options
+ */
+struct slot_guard {
+    ::boost::locale::details::format_parser& parser;
+
+    ~slot_guard()
+    {
+        try {
+            parser.restore();
+        } catch (...) {}
+    }
+};
+
+}  /* namespace  */
+
+// The parsing follows ::boost::locale::basic_format::format_output, so
+// that rendered strings are the same.
+format_template::format_template(interned_string const& str)
+    : str_{str}, segments_{}, options_{}, slots_{0}
+{
+    char const* format = str_.str().c_str();
+    ::std::size_t size = ::std::strlen(format);
+    ::std::size_t pos = 0;
+    segment current{ 0, 0, no_argument, -1, false };
+
+    auto append_literal = [&](::std::size_t offset, ::std::size_t sz)
+    {
+        if (current.offset + current.size != offset) {
+            // Not adjacent to the current literal, start a new segment
+            if (current.size > 0)
+                segments_.push_back(current);
+            current = segment{ offset, 0, no_argument, -1, false };
+        }
+        current.size += sz;
+    };
+
+    while (pos < size) {
+        if (format[pos] != obrk) {
+            append_literal(pos, 1);
+            if (format[pos] == cbrk && format[pos + 1] == cbrk) {
+                pos += 2;
+            } else {
+                ++pos;
+            }
+            continue;
+        }
+        if (pos + 1 < size && format[pos + 1] == obrk) {
+            append_literal(pos, 1);
+            pos += 2;
+            continue;
+        }
+        ++pos;
+
+        unsigned position = no_argument;
+        options opts;
+        bool closed = false;
+        while (pos < size) {
+            ::std::string key;
+            ::std::string value;
+            bool quoted = false;
+            for (; format[pos]; ++pos) {
+                char c = format[pos];
+                if (c == comma || c == eq || c == cbrk)
+                    break;
+                key += c;
+            }
+            if (format[pos] == eq) {
+                ++pos;
+                if (format[pos] == quote) {
+                    ++pos;
+                    quoted = true;
+                    while (format[pos]) {
+                        if (format[pos] == quote) {
+                            if (format[pos + 1] == quote) {
+                                value += quote;
+                                pos += 2;
+                            } else {
+                                ++pos;
+                                break;
+                            }
+                        } else {
+                            value += format[pos++];
+                        }
+                    }
+                } else {
+                    char c;
+                    while ((c = format[pos]) != 0 && c != comma && c != cbrk) {
+                        value += c;
+                        ++pos;
+                    }
+                }
+            }
+            if (!key.empty()) {
+                if (!quoted && is_number(key)) {
+                    position = ::std::atoi(key.c_str()) - 1;
+                } else {
+                    opts.push_back(option{ key, value, quoted });
+                }
+            }
+
+            if (format[pos] == comma) {
+                ++pos;
+                continue;
+            } else if (format[pos] == cbrk) {
+                ++pos;
+                closed = true;
+            }
+            break;
+        }
+        if (!closed)
+            break;
+        current.argument = position;
+        current.has_slot = true;
+        if (!opts.empty()) {
+            current.options = static_cast<int>(options_.size());
+            options_.push_back(::std::move(opts));
+        }
+        segments_.push_back(current);
+        ++slots_;
+        current = segment{ pos, 0, no_argument, -1, false };
+    }
+    if (current.size > 0)
+        segments_.push_back(current);
+}
+
+void
+format_template::write(::std::ostream& os, arguments const& args) const
+{
+    char const* format = str_.str().data();
+    for (auto const& seg : segments_) {
+        if (seg.size > 0)
+            os.write(format + seg.offset, seg.size);
+        if (!seg.has_slot)
+            continue;
+        bool valid = seg.argument < args.size();
+        write_slot(os, seg, valid && args.is_plain(seg.argument),
+                valid ? &write_argument<arguments> : nullptr, &args);
+    }
+}
+
+void
+format_template::render(::std::string& out, arguments const& args,
+        ::std::locale const& loc) const
+{
+    char const* format = str_.str().data();
+    for (auto const& seg : segments_) {
+        if (seg.size > 0)
+            out.append(format + seg.offset, seg.size);
+        if (!seg.has_slot)
+            continue;
+        if (seg.options < 0 && (seg.argument >= args.size() ||
+                args.append(out, seg.argument, loc)))
+            continue;
+        bool valid = seg.argument < args.size();
+        render_slot(out, seg, loc, args.domain_id(loc),
+                valid && args.is_plain(seg.argument),
+                valid ? &write_argument<arguments> : nullptr, &args);
+    }
+}
+
+bool
+format_template::append_integer(::std::string& out, long long val,
+        ::std::locale const& loc)
+{
+    if (!detail::get_locale_info(loc).plain_numbers)
+        return false;
+    detail::append_integer(out, val);
+    return true;
+}
+
+bool
+format_template::append_integer(::std::string& out, unsigned long long val,
+        ::std::locale const& loc)
+{
+    if (!detail::get_locale_info(loc).plain_numbers)
+        return false;
+    detail::append_integer(out, val);
+    return true;
+}
+
+bool
+format_template::append_double(::std::string& out, double val,
+        ::std::locale const& loc)
+{
+    if (!detail::get_locale_info(loc).plain_numbers)
+        return false;
+    detail::append_double(out, val);
+    return true;
+}
+
+void
+format_template::render_slot(::std::string& out, segment const& seg,
+        ::std::locale const& loc, int domain_id, bool plain,
+        write_func write, void const* args) const
+{
+    detail::pooled_stream os{out, loc, domain_id};
+    write_slot(os.stream(), seg, plain, write, args);
+}
+
+void
+format_template::write_slot(::std::ostream& os, segment const& seg,
+        bool plain, write_func write, void const* args) const
+{
+    if (seg.options < 0 && plain) {
+        write(os, args, seg.argument);
+        return;
+    }
+    ::boost::locale::details::format_parser parser{
+            os, static_cast<void*>(&os), &imbue_stream };
+    slot_guard guard{parser};
+    if (seg.options >= 0) {
+        for (auto const& opt : options_[seg.options]) {
+            if (opt.quoted) {
+                parser.set_flag_with_str(opt.key, opt.value);
+            } else {
+                parser.set_one_flag(opt.key, opt.value);
+            }
+        }
+    }
+    if (write)
+        write(os, args, seg.argument);
+}
+
+}  /* namespace l10n */
+}  /* namespace psst */
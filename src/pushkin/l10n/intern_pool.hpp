@@ -0,0 +1,134 @@
+/*
+ * intern_pool.hpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: zmij
+ */
+
+#ifndef PUSHKIN_L10N_INTERN_POOL_HPP_
+#define PUSHKIN_L10N_INTERN_POOL_HPP_
+
+#include <atomic>
+#include <array>
+#include <mutex>
+#include <unordered_map>
+
+namespace psst {
+namespace l10n {
+namespace detail {
+
+/**
+ * Pool of refcounted immutable entries, one entry per distinct value.
+ * Split to shards by hash to reduce contention.
+ *
+ * Entry type must have members:
+ *  - ::std::atomic<::std::size_t> refs, initialized to 1;
+ *  - ::std::size_t const hash;
+ *  - bool matches(Key const&) const.
+ *
+ * Reference count of an entry can drop from one to zero or be raised from
+ * zero only under the shard lock, the entry is erased under the same lock.
+ */
+template < typename Entry >
+class intern_pool {
+public:
+    using entry_type = Entry;
+public:
+    /**
+     * Find an entry matching the key or create a new one.
+     * @param hash
+     * @param key
+     * @param create    Function to create a new entry
+     * @return Entry with a reference acquired
+     */
+    template < typename Key, typename Create >
+    entry_type*
+    intern(::std::size_t hash, Key const& key, Create create)
+    {
+        auto& s = shard_for(hash);
+        lock_type lock{s.mtx};
+        auto range = s.entries.equal_range(hash);
+        for (auto p = range.first; p != range.second; ++p) {
+            if (p->second->matches(key)) {
+                p->second->refs.fetch_add(1, ::std::memory_order_relaxed);
+                return p->second;
+            }
+        }
+        entry_type* e = create();
+        s.entries.emplace(hash, e);
+        return e;
+    }
+
+    static void
+    acquire(entry_type* e)
+    {
+        e->refs.fetch_add(1, ::std::memory_order_relaxed);
+    }
+
+    void
+    release(entry_type* e)
+    {
+        auto cnt = e->refs.load(::std::memory_order_relaxed);
+        while (cnt > 1) {
+            if (e->refs.compare_exchange_weak(cnt, cnt - 1,
+                    ::std::memory_order_acq_rel))
+                return;
+        }
+        auto& s = shard_for(e->hash);
+        lock_type lock{s.mtx};
+        if (e->refs.fetch_sub(1, ::std::memory_order_acq_rel) == 1) {
+            auto range = s.entries.equal_range(e->hash);
+            for (auto p = range.first; p != range.second; ++p) {
+                if (p->second == e) {
+                    s.entries.erase(p);
+                    break;
+                }
+            }
+            delete e;
+        }
+    }
+
+    ::std::size_t
+    size()
+    {
+        ::std::size_t sz = 0;
+        for (auto& s : shards_) {
+            lock_type lock{s.mtx};
+            sz += s.entries.size();
+        }
+        return sz;
+    }
+private:
+    static constexpr ::std::size_t shard_count = 16;
+    using mutex_type    = ::std::mutex;
+    using lock_type     = ::std::lock_guard<mutex_type>;
+    using entries_type  = ::std::unordered_multimap<::std::size_t, entry_type*>;
+
+    struct shard {
+        mutex_type      mtx;
+        entries_type    entries;
+    };
+
+    shard&
+    shard_for(::std::size_t hash)
+    {
+        return shards_[hash % shard_count];
+    }
+
+    ::std::array<shard, shard_count> shards_;
+};
+
+/**
+ * Combine a hash value with another one
+ */
+inline ::std::size_t
+hash_combine(::std::size_t seed, ::std::size_t v)
+{
+    return seed ^ (v + 0x9e3779b97f4a7c15ULL + (seed << 6) + (seed >> 2));
+}
+
+}  /* namespace detail */
+}  /* namespace l10n */
+}  /* namespace psst */
+
+#endif /* PUSHKIN_L10N_INTERN_POOL_HPP_ */
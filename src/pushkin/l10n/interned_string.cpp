@@ -0,0 +1,120 @@
+/*
+ * interned_string.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: zmij
+ */
+
+#include <pushkin/l10n/interned_string.hpp>
+#include "intern_pool.hpp"
+
+#include <iostream>
+
+namespace psst {
+namespace l10n {
+
+struct interned_string::entry {
+    ::std::atomic<::std::size_t>    refs;
+    ::std::size_t const             hash;
+    ::std::string const             text;
+
+    entry(::std::size_t h, ::std::string const& t)
+        : refs{1}, hash{h}, text{t} {}
+
+    bool
+    matches(::std::string const& str) const
+    { return text == str; }
+};
+
+namespace {
+
+using string_pool = detail::intern_pool<interned_string::entry>;
+
+string_pool&
+pool()
+{
+    // Never destroyed, handles in static objects can outlive the pool
+    static string_pool* pool = new string_pool{};
+    return *pool;
+}
+
+::std::string const EMPTY_STRING;
+
+}  /* namespace  */
+
+interned_string::interned_string(::std::string const& str)
+    : entry_{nullptr}
+{
+    auto h = ::std::hash<::std::string>{}(str);
+    entry_ = pool().intern(h, str, [&]() { return new entry{h, str}; });
+}
+
+interned_string::interned_string(char const* str)
+    : interned_string{ ::std::string{str} }
+{
+}
+
+interned_string::interned_string(interned_string const& rhs) noexcept
+    : entry_{rhs.entry_}
+{
+    if (entry_)
+        string_pool::acquire(entry_);
+}
+
+interned_string::~interned_string()
+{
+    if (entry_)
+        pool().release(entry_);
+}
+
+::std::string const&
+interned_string::str() const
+{
+    return entry_ ? entry_->text : EMPTY_STRING;
+}
+
+::std::size_t
+interned_string::hash() const
+{
+    return entry_ ? entry_->hash : 0;
+}
+
+::std::size_t
+interned_string::memory_usage() const
+{
+    if (!entry_)
+        return 0;
+    return (sizeof(entry) + entry_->text.capacity()) /
+            entry_->refs.load(::std::memory_order_relaxed);
+}
+
+bool
+interned_string::operator < (interned_string const& rhs) const
+{
+    if (entry_ == rhs.entry_)
+        return false;
+    if (!entry_)
+        return true;
+    if (!rhs.entry_)
+        return false;
+    return entry_->text < rhs.entry_->text;
+}
+
+::std::size_t
+interned_string::pool_size()
+{
+    return pool().size();
+}
+
+::std::ostream&
+operator << (::std::ostream& os, interned_string const& val)
+{
+    ::std::ostream::sentry s(os);
+    if (s) {
+        os << val.str();
+    }
+    return os;
+}
+
+}  /* namespace l10n */
+}  /* namespace psst */
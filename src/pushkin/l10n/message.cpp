@@ -8,6 +8,11 @@
 #include <pushkin/l10n/message.hpp>
 #include <pushkin/l10n/message_io.hpp>
 #include <pushkin/l10n/message_util.hpp>
+#include <pushkin/l10n/placeholder_cache.hpp>
+#include <pushkin/l10n/translation_cache.hpp>
+#include "format_context.hpp"
+#include "intern_pool.hpp"
+#include "number_format.hpp"
 
 #include <boost/lexical_cast.hpp>
 #include <boost/variant/apply_visitor.hpp>
@@ -25,21 +30,528 @@ namespace l10n {
 
 namespace detail {
 
-message_args::message_args(message_args const& rhs)
-    : args_{}
+erased_arg::erased_arg(erased_arg const& rhs)
+    : value_{nullptr}
 {
-    args_.reserve(rhs.args_.size());
-    ::std::transform(rhs.args_.begin(), rhs.args_.end(),
-        ::std::back_inserter(args_),
-         [](arg_holder const& arg)
-         {
-            return arg->clone();
-         });
+    if (rhs.is_inline()) {
+        value_ = rhs.value_->clone_to(inline_ptr());
+    } else if (rhs.value_) {
+        value_ = const_cast<abstract_arg_value*>(rhs.value_)->clone().release();
+    }
+}
+
+erased_arg::erased_arg(erased_arg&& rhs) noexcept
+    : value_{nullptr}
+{
+    if (rhs.is_inline()) {
+        value_ = rhs.value_->move_to(inline_ptr());
+        rhs.clear();
+    } else {
+        ::std::swap(value_, rhs.value_);
+    }
+}
+
+void
+erased_arg::swap(erased_arg& rhs) noexcept
+{
+    if (!is_inline() && !rhs.is_inline()) {
+        ::std::swap(value_, rhs.value_);
+    } else {
+        erased_arg tmp{ ::std::move(rhs) };
+        rhs.~erased_arg();
+        new (&rhs) erased_arg{ ::std::move(*this) };
+        this->~erased_arg();
+        new (this) erased_arg{ ::std::move(tmp) };
+    }
+}
+
+void
+erased_arg::clear() noexcept
+{
+    if (is_inline()) {
+        value_->~abstract_arg_value();
+    } else {
+        delete value_;
+    }
+    value_ = nullptr;
+}
+
+nested_message::nested_message(message const& msg)
+    : msg_{ ::std::make_shared<message>(msg) }
+{
+}
+
+nested_message::nested_message(message&& msg)
+    : msg_{ ::std::make_shared<message>(::std::move(msg)) }
+{
+}
+
+namespace {
+
+struct format_arg : ::boost::static_visitor<> {
+    using formatted_message = abstract_arg_value::formatted_message;
+
+    formatted_message& fmt;
+
+    explicit
+    format_arg(formatted_message& f) : fmt(f) {}
+
+    void
+    operator()(::boost::blank const&) const {}
+    template < typename T >
+    void
+    operator()(T const& v) const
+    {
+        fmt % v;
+    }
+    void
+    operator()(nested_message const& v) const
+    {
+        fmt % v.get();
+    }
+    void
+    operator()(erased_arg const& v) const
+    {
+        v->format(fmt);
+    }
+};
+
+struct write_arg : ::boost::static_visitor<> {
+    ::std::ostream& os;
+
+    explicit
+    write_arg(::std::ostream& o) : os(o) {}
+
+    void
+    operator()(::boost::blank const&) const {}
+    template < typename T >
+    void
+    operator()(T const& v) const
+    {
+        os << v;
+    }
+    void
+    operator()(nested_message const& v) const
+    {
+        os << v.get();
+    }
+    void
+    operator()(erased_arg const& v) const
+    {
+        v->write(os);
+    }
+};
+
+struct append_arg : ::boost::static_visitor<bool> {
+    ::std::string&          out;
+    ::std::locale const&    loc;
+    int                     domain_id;
+
+    append_arg(::std::string& o, ::std::locale const& l, int d)
+        : out(o), loc(l), domain_id(d) {}
+
+    bool
+    operator()(::boost::blank const&) const
+    {
+        return true;
+    }
+    bool
+    operator()(int v) const
+    {
+        return append_number(v);
+    }
+    bool
+    operator()(long v) const
+    {
+        return append_number(v);
+    }
+    bool
+    operator()(double v) const
+    {
+        if (!get_locale_info(loc).plain_numbers)
+            return false;
+        append_double(out, v);
+        return true;
+    }
+    bool
+    operator()(::std::string const& v) const
+    {
+        out += v;
+        return true;
+    }
+    bool
+    operator()(nested_message const& v) const
+    {
+        v.get().render(out, loc, domain_id);
+        return true;
+    }
+    bool
+    operator()(erased_arg const&) const
+    {
+        return false;
+    }
+
+    template < typename T >
+    bool
+    append_number(T v) const
+    {
+        if (!get_locale_info(loc).plain_numbers)
+            return false;
+        append_integer(out, v);
+        return true;
+    }
+};
+
+}  /* namespace  */
+
+bool
+arg_holder::is_inline() const
+{
+    switch (kind()) {
+        case message_value:
+            return false;
+        case erased_value:
+            return ::boost::get<erased_arg>(value_).is_inline();
+        default:
+            return true;
+    }
+}
+
+void
+arg_holder::format(abstract_arg_value::formatted_message& fmt) const
+{
+    ::boost::apply_visitor(format_arg{fmt}, value_);
+}
+
+void
+arg_holder::write(::std::ostream& os) const
+{
+    ::boost::apply_visitor(write_arg{os}, value_);
+}
+
+bool
+arg_holder::append(::std::string& out, ::std::locale const& loc,
+        int domain_id) const
+{
+    return ::boost::apply_visitor(append_arg{out, loc, domain_id}, value_);
+}
+
+::std::size_t
+arg_holder::memory_usage() const
+{
+    switch (kind()) {
+        case string_value: {
+            auto const& str = ::boost::get<::std::string>(value_);
+            auto begin = reinterpret_cast<char const*>(&str);
+            // Don't count the string's small buffer
+            if (str.data() < begin || str.data() >= begin + sizeof(str))
+                return str.capacity() + 1;
+            return 0;
+        }
+        case message_value: {
+            auto const& nested = ::boost::get<nested_message>(value_);
+            return nested.get().memory_usage() / nested.use_count();
+        }
+        case erased_value: {
+            auto const& erased = ::boost::get<erased_arg>(value_);
+            if (!erased.is_inline())
+                return erased->size();
+            return 0;
+        }
+        default:
+            return 0;
+    }
+}
+
+void
+arg_holder::collect(message_list& messages) const
+{
+    switch (kind()) {
+        case message_value: {
+            auto const& msg = ::boost::get<nested_message>(value_).get();
+            messages.push_back(msg);
+            msg.collect(messages);
+            break;
+        }
+        case erased_value:
+            ::boost::get<erased_arg>(value_)->collect(messages);
+            break;
+        default:
+            break;
+    }
+}
+
+arg_list::arg_list(arg_list const& rhs)
+    : size_{0}, heap_{rhs.heap_}
+{
+    if (heap_.empty()) {
+        auto dst = inline_data();
+        for (auto const& arg : rhs) {
+            new (dst + size_) arg_holder{ arg };
+            ++size_;
+        }
+    }
+}
+
+arg_list::arg_list(arg_list&& rhs) noexcept
+    : size_{0}, heap_{::std::move(rhs.heap_)}
+{
+    auto src = rhs.inline_data();
+    auto dst = inline_data();
+    for (; size_ < rhs.size_; ++size_) {
+        new (dst + size_) arg_holder{ ::std::move(src[size_]) };
+    }
+    rhs.clear();
+}
+
+void
+arg_list::swap(arg_list& rhs) noexcept
+{
+    arg_list tmp{ ::std::move(rhs) };
+    rhs.~arg_list();
+    new (&rhs) arg_list{ ::std::move(*this) };
+    this->~arg_list();
+    new (this) arg_list{ ::std::move(tmp) };
+}
+
+void
+arg_list::clear() noexcept
+{
+    auto args = inline_data();
+    for (size_type i = 0; i < size_; ++i) {
+        args[i].~arg_holder();
+    }
+    size_ = 0;
+    heap_.clear();
+}
+
+void
+arg_list::emplace_back(arg_holder&& arg)
+{
+    if (heap_.empty() && size_ < inline_capacity) {
+        new (inline_data() + size_) arg_holder{ ::std::move(arg) };
+        ++size_;
+    } else {
+        if (heap_.empty())
+            spill();
+        heap_.push_back(::std::move(arg));
+    }
+}
+
+void
+arg_list::spill()
+{
+    heap_.reserve(inline_capacity * 2);
+    auto args = inline_data();
+    for (size_type i = 0; i < size_; ++i) {
+        heap_.push_back(::std::move(args[i]));
+        args[i].~arg_holder();
+    }
+    size_ = 0;
+}
+
+namespace {
+
+// Count of free argument lists a thread keeps for reuse
+::std::size_t const max_free_arg_lists = 64;
+
+// Set when the thread's pool is destroyed, lists released after that,
+// e.g. by destructors of static messages, are deleted
+thread_local bool arg_lists_destroyed = false;
+
+struct arg_list_pool {
+    ::std::vector<shared_arg_list*> free;
+
+    ~arg_list_pool()
+    {
+        for (auto list : free) {
+            delete list;
+        }
+        arg_lists_destroyed = true;
+    }
+};
+
+arg_list_pool*
+arg_lists()
+{
+    if (arg_lists_destroyed)
+        return nullptr;
+    static thread_local arg_list_pool pool;
+    return &pool;
+}
+
+shared_arg_list*
+acquire_arg_list()
+{
+    auto pool = arg_lists();
+    if (!pool || pool->free.empty())
+        return new shared_arg_list{};
+    auto list = pool->free.back();
+    pool->free.pop_back();
+    list->refs.store(1, ::std::memory_order_relaxed);
+    return list;
+}
+
+}  /* namespace  */
+
+::std::size_t
+message_args::memory_usage() const
+{
+    if (!args_)
+        return 0;
+    ::std::size_t sz = sizeof(shared_arg_list);
+    if (args_->args.size() > arg_list::inline_capacity) {
+        sz += args_->args.size() * sizeof(arg_holder);
+    }
+    for (auto const& arg : args_->args) {
+        sz += arg.memory_usage();
+    }
+    return sz / args_->refs.load(::std::memory_order_relaxed);
+}
+
+arg_list&
+message_args::mutable_args()
+{
+    if (!args_) {
+        args_ = acquire_arg_list();
+    } else if (shared()) {
+        auto copy = acquire_arg_list();
+        try {
+            copy->args = args_->args;
+        } catch (...) {
+            release(copy);
+            throw;
+        }
+        release(args_);
+        args_ = copy;
+    }
+    return args_->args;
+}
+
+void
+message_args::release(shared_arg_list* list) noexcept
+{
+    if (!list || list->refs.fetch_sub(1, ::std::memory_order_acq_rel) != 1)
+        return;
+    // Releases nested messages, their lists go to the pool first
+    list->args.clear();
+    auto pool = arg_lists();
+    if (pool && pool->free.size() < max_free_arg_lists) {
+        try {
+            pool->free.push_back(list);
+            return;
+        } catch (...) {}
+    }
+    delete list;
+}
+
+namespace {
+
+using text_pool = intern_pool<message_text::block>;
+
+text_pool&
+texts()
+{
+    // Never destroyed, texts in static objects can outlive the pool
+    static text_pool* pool = new text_pool{};
+    return *pool;
+}
+
+}  /* namespace  */
+
+message_text::message_text(int type, interned_string const& id,
+        interned_string const& str, interned_string const& context,
+        interned_string const& plural, interned_string const& domain)
+    : block_{nullptr}
+{
+    ::std::size_t h = ::std::hash<int>{}(type);
+    h = hash_combine(h, id.hash());
+    h = hash_combine(h, str.hash());
+    h = hash_combine(h, context.hash());
+    h = hash_combine(h, plural.hash());
+    h = hash_combine(h, domain.hash());
+    block key{h, type, id, str, context, plural, domain};
+    block_ = texts().intern(h, key, [&]() { return new block{
+            h, type, id, str, context, plural, domain }; });
+}
+
+message_text::message_text(message_table const& table, ::std::size_t index)
+    : block_{nullptr}
+{
+    auto const& entry = table[index];
+    using message_type = message::message_type;
+    auto type = static_cast<int>(entry.plural ?
+            (entry.context ? message_type::context_plural : message_type::plural) :
+            (entry.context ? message_type::context : message_type::simple));
+    interned_string id{entry.id};
+    interned_string context = entry.context ?
+            interned_string{entry.context} : interned_string{};
+    interned_string plural = entry.plural ?
+            interned_string{entry.plural} : interned_string{};
+    interned_string domain = table.domain() ?
+            interned_string{table.domain()} : interned_string{};
+    ::std::size_t h = ::std::hash<int>{}(type);
+    h = hash_combine(h, id.hash());
+    h = hash_combine(h, context.hash());
+    h = hash_combine(h, plural.hash());
+    h = hash_combine(h, domain.hash());
+    h = hash_combine(h, ::std::hash<void const*>{}(&table));
+    h = hash_combine(h, ::std::hash<::std::size_t>{}(index));
+    block key{h, type, id, id, context, plural, domain, &table, index};
+    block_ = texts().intern(h, key, [&]() { return new block{
+            h, type, id, id, context, plural, domain, &table, index }; });
+}
+
+message_text::~message_text()
+{
+    if (block_)
+        texts().release(block_);
+}
+
+::std::size_t
+message_text::memory_usage() const
+{
+    if (!block_)
+        return 0;
+    auto sz = sizeof(block) + block_->id.memory_usage() +
+            block_->context.memory_usage() + block_->plural.memory_usage() +
+            block_->domain.memory_usage();
+    if (block_->str != block_->id)
+        sz += block_->str.memory_usage();
+    return sz / block_->refs.load(::std::memory_order_relaxed);
+}
+
+::std::size_t
+message_text::pool_size()
+{
+    return texts().size();
+}
+
+::std::size_t
+message_text::make_fingerprint(interned_string const& domain,
+        interned_string const& context, interned_string const& id,
+        bool has_plural)
+{
+    ::std::size_t h = ::std::hash<bool>{}(has_plural);
+    h = hash_combine(h, domain.hash());
+    h = hash_combine(h, context.hash());
+    h = hash_combine(h, id.hash());
+    return h;
+}
+
+::std::size_t
+message_text::null_fingerprint()
+{
+    static ::std::size_t const fp = make_fingerprint(
+            null_string(), null_string(), null_string(), false);
+    return fp;
 }
 
-message_args::message_args(message_args&& rhs)
-    : args_{::std::move(rhs.args_)}
+interned_string const&
+message_text::null_string()
 {
+    static interned_string const null;
+    return null;
 }
 
 }  /* namespace detail */
@@ -58,8 +570,6 @@ namespace {
         { "L10NC", message::message_type::context },
         { "L10NNC", message::message_type::context_plural },
     }; // STRING_TO_TYPE
-
-    const ::std::string DEFAULT_DOMAIN = "";
 } // namespace
 
 // Generated output operator
@@ -113,56 +623,325 @@ format::format(formatted_message_ptr&& fmt)
 {
 }
 
-message::message() : type_(message_type::empty), n_(0)
+format::format(detail::message_text const& text, int n)
+    : fmt_{}, text_{text}, n_{n}
+{
+}
+
+namespace {
+
+struct write_arg_ref : ::boost::static_visitor<> {
+    ::std::ostream& os;
+
+    explicit
+    write_arg_ref(::std::ostream& o) : os(o) {}
+
+    void
+    operator()(format const* v) const
+    {
+        os << *v;
+    }
+    void
+    operator()(detail::abstract_arg_value const* v) const
+    {
+        v->write(os);
+    }
+    void
+    operator()(detail::arg_holder const* v) const
+    {
+        v->write(os);
+    }
+};
+
+struct append_arg_ref : ::boost::static_visitor<bool> {
+    ::std::string&                      out;
+    ::std::locale const&                loc;
+    format_template::arguments const&   args;
+
+    append_arg_ref(::std::string& o, ::std::locale const& l,
+            format_template::arguments const& a)
+        : out(o), loc(l), args(a) {}
+
+    bool
+    operator()(format const* v) const
+    {
+        v->render(out, loc, args.domain_id(loc));
+        return true;
+    }
+    bool
+    operator()(detail::abstract_arg_value const*) const
+    {
+        return false;
+    }
+    bool
+    operator()(detail::arg_holder const* v) const
+    {
+        if (v->kind() == detail::arg_holder::message_value)
+            return v->append(out, loc, args.domain_id(loc));
+        return v->append(out, loc, 0);
+    }
+};
+
+struct is_plain_arg : ::boost::static_visitor<bool> {
+    template < typename T >
+    bool
+    operator()(T const*) const
+    {
+        return false;
+    }
+    bool
+    operator()(detail::arg_holder const* v) const
+    {
+        return v->is_plain();
+    }
+};
+
+template < typename Refs >
+struct format_arguments : format_template::arguments {
+    Refs const& refs;
+    // Domain of the message and domain inherited from the enclosing
+    // message, used for nested messages
+    detail::message_text const* text;
+    int                         inherited_domain;
+
+    explicit
+    format_arguments(Refs const& r, detail::message_text const* t = nullptr,
+            int domain = 0)
+        : refs(r), text(t), inherited_domain(domain) {}
+
+    ::std::size_t
+    size() const override
+    {
+        return refs.size();
+    }
+    bool
+    is_plain(::std::size_t idx) const override
+    {
+        return ::boost::apply_visitor(is_plain_arg{}, refs[idx]);
+    }
+    void
+    write(::std::ostream& os, ::std::size_t idx) const override
+    {
+        ::boost::apply_visitor(write_arg_ref{os}, refs[idx]);
+    }
+    bool
+    append(::std::string& out, ::std::size_t idx,
+            ::std::locale const& loc) const override
+    {
+        return ::boost::apply_visitor(
+                append_arg_ref{out, loc, *this}, refs[idx]);
+    }
+    int
+    domain_id(::std::locale const& loc) const override
+    {
+        if (text && !text->domain().is_null())
+            return translation_cache::domain_id(loc, text->domain());
+        return inherited_domain;
+    }
+};
+
+/**
+ * Arguments of a message, preceded by the plural number if the message
+ * has a plural form
+ */
+struct message_arguments : format_template::arguments {
+    detail::message_args const& args;
+    detail::message_text const& text;
+    ::std::size_t               plural;
+    int                         n;
+    int                         inherited_domain;
+
+    message_arguments(detail::message_args const& a,
+            detail::message_text const& t, int n, int domain)
+        : args(a), text(t), plural(t.plural().is_null() ? 0 : 1), n(n),
+          inherited_domain(domain) {}
+
+    ::std::size_t
+    size() const override
+    {
+        return args.size() + plural;
+    }
+    bool
+    is_plain(::std::size_t idx) const override
+    {
+        return idx < plural || arg(idx).is_plain();
+    }
+    void
+    write(::std::ostream& os, ::std::size_t idx) const override
+    {
+        if (idx < plural) {
+            os << n;
+        } else {
+            arg(idx).write(os);
+        }
+    }
+    bool
+    append(::std::string& out, ::std::size_t idx,
+            ::std::locale const& loc) const override
+    {
+        if (idx < plural) {
+            if (!detail::get_locale_info(loc).plain_numbers)
+                return false;
+            detail::append_integer(out, n);
+            return true;
+        }
+        auto const& v = arg(idx);
+        if (v.kind() == detail::arg_holder::message_value)
+            return v.append(out, loc, domain_id(loc));
+        return v.append(out, loc, 0);
+    }
+    int
+    domain_id(::std::locale const& loc) const override
+    {
+        if (!text.domain().is_null())
+            return translation_cache::domain_id(loc, text.domain());
+        return inherited_domain;
+    }
+
+    detail::arg_holder const&
+    arg(::std::size_t idx) const
+    {
+        return args.begin()[idx - plural];
+    }
+};
+
+int
+stream_domain(::std::ostream& os, detail::message_text const& text)
+{
+    if (!text.domain().is_null())
+        return translation_cache::message_domain;
+    return ::boost::locale::ios_info::get(os).domain_id();
+}
+
+}  /* namespace  */
+
+::std::string
+format::str(::std::locale const& loc) const
+{
+    ::std::string out;
+    render(out, loc);
+    return out;
+}
+
+void
+format::render(::std::string& out, ::std::locale const& loc, int domain_id) const
+{
+    if (fmt_) {
+        detail::pooled_stream os{out, loc, domain_id};
+        os.stream() << *fmt_;
+        return;
+    }
+    auto tmpl = translation_cache::instance().get_template(loc, text_, n_,
+            text_.domain().is_null() ? domain_id : translation_cache::message_domain);
+    tmpl->render(out, format_arguments<arg_refs>{args_, &text_, domain_id}, loc);
+}
+
+void
+format::write(::std::ostream& os) const
+{
+    if (fmt_) {
+        os << *fmt_;
+        return;
+    }
+    auto tmpl = translation_cache::instance().get_template(
+            os.getloc(), text_, n_, stream_domain(os, text_));
+    tmpl->write(os, format_arguments<arg_refs>{args_, &text_,
+            ::boost::locale::ios_info::get(os).domain_id()});
+}
+
+namespace {
+
+interned_string
+intern(message::optional_string const& str)
+{
+    if (str.is_initialized())
+        return interned_string{ *str };
+    return interned_string{};
+}
+
+}  /* namespace  */
+
+message::message() : text_{}, n_(0)
 {
 }
 
 message::message(optional_string const& domain)
-    : type_(message_type::empty), domain_(domain), n_(0)
+    : text_{ static_cast<int>(message_type::empty), {}, {}, {}, {}, intern(domain) },
+      n_(0)
 {
 }
 
 message::message(std::string const& id, optional_string const& domain)
-    : type_(message_type::simple), msgid_(id), msgstr_(id), domain_(domain), n_(0)
+    : n_(0)
 {
+    interned_string msgid{id};
+    text_ = detail::message_text{ static_cast<int>(message_type::simple),
+            msgid, msgid, {}, {}, intern(domain) };
 }
 
 message::message(id_str_pair const& id_n_str,
         domain_type const& domain)
-    : type_(message_type::simple), msgid_(id_n_str.first), msgstr_(id_n_str.second), domain_(domain), n_(0)
+    : text_{ static_cast<int>(message_type::simple),
+             interned_string{id_n_str.first},
+             interned_string{id_n_str.second},
+             {}, {}, intern(domain) },
+      n_(0)
 {
-    if(msgstr_.find("{1}") != std::string::npos)
+    if(msgstr().find("{1}") != std::string::npos)
         set_plural();
 }
 
 message::message(std::string const& context_str,
         std::string const& id, optional_string const& domain)
-    : type_(message_type::context), msgid_(id), msgstr_(id), context_(context_str), domain_(domain), n_(0)
+    : n_(0)
 {
+    interned_string msgid{id};
+    text_ = detail::message_text{ static_cast<int>(message_type::context),
+            msgid, msgid, interned_string{context_str}, {}, intern(domain) };
 }
 
 message::message(std::string const& context_str,
         id_str_pair const& id_n_str,
         domain_type const& domain)
-    : type_(message_type::context), msgid_(id_n_str.first), msgstr_(id_n_str.second), context_(context_str), domain_(domain), n_(0)
+    : text_{ static_cast<int>(message_type::context),
+             interned_string{id_n_str.first},
+             interned_string{id_n_str.second},
+             interned_string{context_str}, {}, intern(domain) },
+      n_(0)
 {
-    if(msgstr_.find("{1}") != std::string::npos)
+    if(msgstr().find("{1}") != std::string::npos)
         set_plural();
 }
 
 message::message(std::string const& singular,
         std::string const& plural_str,
         int n, optional_string const& domain)
-    : type_(message_type::plural), msgid_(singular), msgstr_(singular), plural_(plural_str), domain_(domain), n_(n)
+    : n_(n)
 {
+    interned_string id{singular};
+    text_ = detail::message_text{ static_cast<int>(message_type::plural),
+            id, id, {}, interned_string{plural_str}, intern(domain) };
 }
 
 message::message(std::string const& context,
         std::string const& singular,
         std::string const& plural,
         int n, optional_string const& domain)
-    : type_(message_type::context_plural), msgid_(singular), msgstr_(singular), context_(context),
-      plural_(plural), domain_(domain), n_(n)
+    : n_(n)
+{
+    interned_string id{singular};
+    text_ = detail::message_text{ static_cast<int>(message_type::context_plural),
+            id, id, interned_string{context}, interned_string{plural},
+            intern(domain) };
+}
+
+message::message(message_id const& id)
+    : text_{ id.table().text(id.value) }, n_(0)
+{
+}
+
+message::message(message_id const& id, int n)
+    : text_{ id.table().text(id.value) }, n_(n)
 {
 }
 
@@ -170,63 +949,81 @@ void
 message::swap(message& rhs) noexcept
 {
     using std::swap;
-    swap(type_, rhs.type_);
-    swap(msgid_, rhs.msgid_);
-    swap(msgstr_, rhs.msgstr_);
-    swap(plural_, rhs.plural_);
-    swap(context_, rhs.context_);
+    swap(text_, rhs.text_);
     swap(n_, rhs.n_);
-    swap(domain_, rhs.domain_);
     swap(args_, rhs.args_);
 }
 
+bool
+message::operator < (message const& rhs) const
+{
+    if (text_.same_message(rhs.text_))
+        return false;
+    if (text_.id() != rhs.text_.id())
+        return text_.id() < rhs.text_.id();
+    if (text_.context() != rhs.text_.context())
+        return text_.context() < rhs.text_.context();
+    if (has_plural() != rhs.has_plural())
+        // Message with no plural is less than message with plural
+        return !has_plural();
+    return text_.domain() < rhs.text_.domain();
+}
+
 ::std::string const&
 message::plural() const
 {
-    if (!plural_.is_initialized())
+    if (text_.plural().is_null())
         throw ::std::runtime_error{
-            "Message msgid '" + msgid_ + "' doesn't contain a plural form" };
-    return *plural_;
-    }
+            "Message msgid '" + id() + "' doesn't contain a plural form" };
+    return text_.plural().str();
+}
 
 ::std::string const&
 message::context() const
 {
-    if (!context_.is_initialized())
+    if (text_.context().is_null())
         throw ::std::runtime_error{
-            "Message msgid '" + msgid_ + "' doesn't have context" };
-    return *context_;
-    }
+            "Message msgid '" + id() + "' doesn't have context" };
+    return text_.context().str();
+}
 
 ::std::string const&
 message::domain() const
 {
-    if (!domain_.is_initialized())
-        return DEFAULT_DOMAIN;
-    return *domain_;
+    return text_.domain().str();
 }
 
 void
 message::domain( std::string const& domain)
 {
-    domain_ = domain;
+    text_ = detail::message_text{ text_.type(), text_.id(), text_.str(),
+            text_.context(), text_.plural(), interned_string{domain} };
+}
+
+void
+message::set_id(::std::string const& id)
+{
+    text_ = detail::message_text{ text_.type(), interned_string{id}, text_.str(),
+            text_.context(), text_.plural(), text_.domain() };
 }
 
 void
 message::set_plural()
 {
-    switch (type_) {
+    message_type type;
+    switch (this->type()) {
         case message_type::simple:
         case message_type::plural:
-            type_ = message_type::plural; break;
+            type = message_type::plural; break;
         case message_type::context:
         case message_type::context_plural:
-            type_ = message_type::context_plural; break;
+            type = message_type::context_plural; break;
         default:
             throw ::std::runtime_error{"Cannot convert message to a plural form"};
     }
 
-    plural_ = msgid_;
+    text_ = detail::message_text{ static_cast<int>(type), text_.id(), text_.str(),
+            text_.context(), text_.id(), text_.domain() };
 }
 
 void
@@ -236,20 +1033,26 @@ message::set_plural(int n)
     n_ = n;
 }
 
+::std::size_t
+message::memory_usage() const
+{
+    return sizeof(message) + text_.memory_usage() + args_.memory_usage();
+}
+
 message::localized_message
 message::translate(int n) const
 {
-    switch (type_) {
+    switch (type()) {
         case message_type::empty:
             return localized_message();
         case message_type::simple:
-            return localized_message(msgid_);
+            return localized_message(id());
         case message_type::context:
-            return localized_message(context_.value(), msgid_);
+            return localized_message(text_.context().str(), id());
         case message_type::plural:
-            return localized_message(msgid_, plural_.value(), n);
+            return localized_message(id(), text_.plural().str(), n);
         case message_type::context_plural:
-            return localized_message(context_.value(), msgid_, plural_.value(), n);
+            return localized_message(text_.context().str(), id(), text_.plural().str(), n);
         default:
             throw std::runtime_error("Unknown message type");
     }
@@ -258,7 +1061,7 @@ message::translate(int n) const
 format
 message::format(int n, bool feed_plural) const
 {
-    l10n::format fmt{translate(n)};
+    l10n::format fmt{text_, n};
     if (has_plural() && feed_plural)
         fmt % n;
     fmt % args_;
@@ -269,21 +1072,214 @@ void
 message::write(std::ostream& os) const
 {
     namespace locn = boost::locale;
-    if (domain_.is_initialized()) {
-        os << locn::as::domain(domain_.value());
+    if (!text_.domain().is_null()) {
+        os << locn::as::domain(text_.domain().str());
+    }
+    ::std::ostream::sentry s (os);
+    if (!s)
+        return;
+    auto tmpl = translation_cache::instance().get_template(
+            os.getloc(), text_, n_, stream_domain(os, text_));
+    if(has_plural() || has_format_args()) {
+        tmpl->write(os, message_arguments{args_, text_, n_,
+                locn::ios_info::get(os).domain_id()});
+    } else {
+        // Nothing to format, output the translated string as is
+        os << tmpl->str();
     }
+}
+
+::std::string&
+message::render(::std::string& out, ::std::locale const& loc, int domain_id) const
+{
     if(has_plural() || has_format_args()) {
-        os << format();
+        render_format(out, loc, domain_id);
     } else {
-        os << translate(n_);
+        out += translation_cache::instance().translate(loc, text_, n_,
+                text_.domain().is_null() ? domain_id : translation_cache::message_domain).str();
+    }
+    return out;
+}
+
+void
+message::render_format(::std::string& out, ::std::locale const& loc,
+        int domain_id) const
+{
+    auto tmpl = translation_cache::instance().get_template(loc, text_, n_,
+            text_.domain().is_null() ? domain_id : translation_cache::message_domain);
+    tmpl->render(out, message_arguments{args_, text_, n_, domain_id}, loc);
+}
+
+namespace detail {
+
+/**
+ * Message prepared for rendering to several locales.
+ * The arguments are extracted once, numbers are formatted for locales
+ * that write them without grouping, nested messages are prepared
+ * recursively. The prepared message refers to the message, it's
+ * arguments and nested messages.
+ */
+class prepared_message {
+public:
+    explicit
+    prepared_message(message const& msg)
+        : msg_(msg)
+    {
+        auto plural = msg.has_plural() ? 1 : 0;
+        args_.reserve(msg.args_.size() + plural);
+        if (plural) {
+            prepared_arg n{ prepared_arg::number, nullptr, 0, {} };
+            append_integer(n.str, msg.n_);
+            args_.push_back(::std::move(n));
+        }
+        for (auto const& arg : msg.args_) {
+            prepared_arg prepared{ prepared_arg::other, &arg, 0, {} };
+            switch (arg.kind()) {
+                case arg_holder::int_value:
+                    prepared.kind = prepared_arg::number;
+                    append_integer(prepared.str, ::boost::get<int>(arg.value()));
+                    break;
+                case arg_holder::long_value:
+                    prepared.kind = prepared_arg::number;
+                    append_integer(prepared.str, ::boost::get<long>(arg.value()));
+                    break;
+                case arg_holder::double_value:
+                    prepared.kind = prepared_arg::number;
+                    append_double(prepared.str, ::boost::get<double>(arg.value()));
+                    break;
+                case arg_holder::message_value:
+                    prepared.kind = prepared_arg::nested_message;
+                    prepared.nested = nested_.size();
+                    nested_.emplace_back(
+                            ::boost::get<nested_message>(arg.value()).get());
+                    break;
+                default:
+                    break;
+            }
+            args_.push_back(::std::move(prepared));
+        }
+    }
+
+    /**
+     * Append the message translated to a locale
+     * @param out
+     * @param loc
+     * @param plain_numbers The locale writes numbers without grouping
+     * @param domain_id     Domain to use if the message has no domain
+     * @param format        Format the message even if it has no arguments,
+     *                      as str does
+     */
+    void
+    render(::std::string& out, ::std::locale const& loc, bool plain_numbers,
+            int domain_id, bool format) const
+    {
+        auto const& text = msg_.text_;
+        int tmpl_domain = text.domain().is_null() ?
+                domain_id : translation_cache::message_domain;
+        auto& cache = translation_cache::instance();
+        if (!format && !msg_.has_plural() && !msg_.has_format_args()) {
+            out += cache.translate(loc, text, msg_.n_, tmpl_domain).str();
+            return;
+        }
+        if (!text.domain().is_null())
+            domain_id = translation_cache::domain_id(loc, text.domain());
+        cache.get_template(loc, text, msg_.n_, tmpl_domain)->render(out,
+                arguments{*this, plain_numbers, domain_id}, loc);
+    }
+private:
+    struct prepared_arg {
+        enum kind_type {
+            number,
+            nested_message,
+            other
+        };
+        kind_type           kind;
+        /** Argument of the message, nullptr for the plural number */
+        arg_holder const*   holder;
+        /** Index of a nested message */
+        ::std::size_t       nested;
+        /** A number written without grouping */
+        ::std::string       str;
+    };
+
+    /**
+     * Arguments for the format template, numbers and nested messages are
+     * appended from the prepared message
+     */
+    struct arguments {
+        prepared_message const& msg;
+        bool                    plain_numbers;
+        int                     domain;
+
+        ::std::size_t
+        size() const
+        { return msg.args_.size(); }
+        bool
+        is_plain(::std::size_t idx) const
+        {
+            auto const& arg = msg.args_[idx];
+            return !arg.holder || arg.holder->is_plain();
+        }
+        void
+        write(::std::ostream& os, ::std::size_t idx) const
+        {
+            auto const& arg = msg.args_[idx];
+            if (arg.holder) {
+                arg.holder->write(os);
+            } else {
+                os << msg.msg_.n_;
+            }
+        }
+        bool
+        append(::std::string& out, ::std::size_t idx,
+                ::std::locale const& loc) const
+        {
+            auto const& arg = msg.args_[idx];
+            switch (arg.kind) {
+                case prepared_arg::number:
+                    if (!plain_numbers)
+                        return false;
+                    out += arg.str;
+                    return true;
+                case prepared_arg::nested_message:
+                    msg.nested_[arg.nested].render(out, loc, plain_numbers,
+                            domain, false);
+                    return true;
+                default:
+                    return arg.holder->append(out, loc, 0);
+            }
+        }
+        int
+        domain_id(::std::locale const&) const
+        { return domain; }
+    };
+
+    message const&                  msg_;
+    ::std::vector<prepared_arg>     args_;
+    ::std::vector<prepared_message> nested_;
+};
+
+}  /* namespace detail */
+
+message::string_list
+message::str(locale_list const& locales) const
+{
+    detail::prepared_message prepared{*this};
+    string_list res;
+    res.reserve(locales.size());
+    for (auto const& loc : locales) {
+        res.emplace_back();
+        prepared.render(res.back(), loc,
+                detail::get_locale_info(loc).plain_numbers, 0, true);
     }
+    return res;
 }
 
 void
 message::collect(message_list& messages) const
 {
     for (auto const& arg : args_) {
-        arg->collect(messages);
+        arg.collect(messages);
     }
 }
 
@@ -291,9 +1287,9 @@ message
 message::create_message(::std::string const& id, get_named_param_func f,
             domain_type const& domain)
 {
-    auto id_phs = extract_named_placeholders(id);
-    message msg{id_phs.first, domain};
-    for (auto const& ph : id_phs.second) {
+    auto id_phs = placeholder_cache::instance().get(id);
+    message msg{id_phs->first, domain};
+    for (auto const& ph : id_phs->second) {
         auto const& nm = ::boost::get<::std::string>(ph.id);
         f(msg, nm);
     }
@@ -306,9 +1302,9 @@ message::create_message(std::string const& context,
             get_named_param_func f,
             domain_type const& domain)
 {
-    auto id_phs = extract_named_placeholders(id);
-    message msg{context, id_phs.first, domain};
-    for (auto const& ph : id_phs.second) {
+    auto id_phs = placeholder_cache::instance().get(id);
+    message msg{context, id_phs->first, domain};
+    for (auto const& ph : id_phs->second) {
         auto const& nm = ::boost::get<::std::string>(ph.id);
         f(msg, nm);
     }
@@ -323,10 +1319,11 @@ message::create_message(std::string const& singular,
         int n,
         domain_type const& domain)
 {
-    auto singular_phs = extract_named_placeholders(singular);
-    auto plural_phs   = extract_named_placeholders(plural);
-    message msg{singular_phs.first, plural_phs.first, n, domain};
-    for (auto const& ph : singular_phs.second) {
+    auto& cache = placeholder_cache::instance();
+    auto singular_phs = cache.get(singular);
+    auto plural_phs   = cache.get(plural);
+    message msg{singular_phs->first, plural_phs->first, n, domain};
+    for (auto const& ph : singular_phs->second) {
         auto const& nm = ::boost::get<::std::string>(ph.id);
         if (ph.is_pluralizer) {
             if (get_n) {
@@ -350,10 +1347,11 @@ message::create_message(std::string const& context,
         int n,
         domain_type const& domain)
 {
-    auto singular_phs = extract_named_placeholders(singular);
-    auto plural_phs   = extract_named_placeholders(plural);
-    message msg{context, singular_phs.first, plural_phs.first, n, domain};
-    for (auto const& ph : singular_phs.second) {
+    auto& cache = placeholder_cache::instance();
+    auto singular_phs = cache.get(singular);
+    auto plural_phs   = cache.get(plural);
+    message msg{context, singular_phs->first, plural_phs->first, n, domain};
+    for (auto const& ph : singular_phs->second) {
         auto const& nm = ::boost::get<::std::string>(ph.id);
         if (ph.is_pluralizer) {
             if (get_n) {
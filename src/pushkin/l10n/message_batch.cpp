@@ -0,0 +1,30 @@
+/*
+ * message_batch.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: zmij
+ */
+
+#include <pushkin/l10n/message_batch.hpp>
+#include "batch_renderer.hpp"
+
+namespace psst {
+namespace l10n {
+
+void
+render_batch(message const* first, message const* last,
+        ::std::locale const& loc, rendered_batch& out)
+{
+    auto& offsets = out.offsets_;
+    offsets.reserve(offsets.size() + (last - first) + 1);
+    if (offsets.empty())
+        offsets.push_back(out.data_.size());
+    detail::batch_renderer renderer{loc};
+    for (; first != last; ++first) {
+        renderer.render(out.data_, *first, 0, true);
+        offsets.push_back(out.data_.size());
+    }
+}
+
+}  /* namespace l10n */
+}  /* namespace psst */
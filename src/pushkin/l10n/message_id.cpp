@@ -0,0 +1,37 @@
+/*
+ * message_id.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: zmij
+ */
+
+#include <pushkin/l10n/message_id.hpp>
+#include <pushkin/l10n/message.hpp>
+
+#include <new>
+#include <stdexcept>
+
+namespace psst {
+namespace l10n {
+
+detail::message_text const&
+message_table::text(::std::size_t idx) const
+{
+    if (idx >= size_)
+        throw ::std::out_of_range{"Message id is out of the message table"};
+    ::std::call_once(once_, [this]()
+    {
+        // Never destroyed, messages can be created from ids by static
+        // objects' destructors
+        auto texts = static_cast<detail::message_text*>(::operator new(
+                sizeof(detail::message_text) * size_));
+        for (::std::size_t i = 0; i < size_; ++i) {
+            new (texts + i) detail::message_text{*this, i};
+        }
+        texts_ = texts;
+    });
+    return texts_[idx];
+}
+
+}  /* namespace l10n */
+}  /* namespace psst */
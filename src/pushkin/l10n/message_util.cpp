@@ -6,11 +6,12 @@
  */
 
 #include <pushkin/l10n/message_util.hpp>
-#include <pushkin/l10n/grammar/placeholders.hpp>
+#include <pushkin/l10n/static_placeholders.hpp>
 
+#include <cstring>
 #include <iostream>
-#include <sstream>
-#include <map>
+#include <limits>
+#include <vector>
 
 namespace psst {
 namespace l10n {
@@ -38,106 +39,341 @@ operator << (::std::ostream& os, placeholders const& val)
     return os;
 }
 
-placeholders
-extract_placeholders(::std::string const& input)
-{
-    namespace qi = ::boost::spirit::qi;
-    using string_iterator   = ::std::string::const_iterator;
-    using grammar_type      = grammar::parse::placeholders_grammar<string_iterator>;
-    static grammar_type parser;
-
-    string_iterator first = input.begin();
-    string_iterator last = input.end();
-
-    placeholders ph;
-    qi::parse(first, last, parser, ph);
-    return ph;
-}
+namespace {
 
-struct ph_usage {
+/**
+ * Placeholder found in a string, parts are pointers into the string
+ */
+struct raw_placeholder {
+    char const*     begin;
+    char const*     end;
+    bool            is_number;
     ::std::size_t   number;
+    char const*     name;
+    ::std::size_t   name_size;
     bool            is_pluralizer;
-    ::std::size_t   uses;
+    char const*     options;
+    ::std::size_t   options_size;
+
+    placeholder
+    get() const
+    {
+        placeholder ph;
+        if (is_number) {
+            ph.id = number;
+        } else {
+            ph.id = ::std::string{name, name_size};
+        }
+        ph.is_pluralizer = is_pluralizer;
+        ph.options.assign(options, options_size);
+        return ph;
+    }
 };
 
-::std::pair<::std::string, placeholders>
-extract_named_placeholders(::std::string const& input)
-{
-    auto phs = extract_placeholders(input);
-    if (phs.empty())
-        return {input, placeholders{}};
-    placeholders named_phs;
-    ::std::copy_if(phs.begin(), phs.end(), ::std::back_inserter(named_phs),
-            [](placeholder const& ph)
-            {
-                return ph.type() == placeholder::name;
-            });
-    if (named_phs.empty())
-        return {input, placeholders{}};
+/**
+ * Scanner of placeholders, accepts the same input as the placeholders
+ * grammar in grammar/placeholders.hpp and produces the same result.
+ * Text between placeholders is skipped with memchr.
+ */
+class placeholder_scanner {
+public:
+    placeholder_scanner(char const* begin, char const* end)
+        : p_{begin}, end_{end} {}
 
-    // 1. Assign numbers to names
-    ::std::map< ::std::string, ph_usage > name_numbers;
-    for (auto const& ph : named_phs) {
-        auto nm = ::boost::get< ::std::string >(ph.id);
-        auto f = name_numbers.find(nm);
-        if (f == name_numbers.end()) {
-            name_numbers.emplace(nm, ph_usage{name_numbers.size() + 1, ph.is_pluralizer, 1});
-        } else{
-            if (ph.is_pluralizer)
-                f->second.is_pluralizer = ph.is_pluralizer;
-            ++f->second.uses;
+    /**
+     * Find next placeholder
+     * @param ph
+     * @return false at the end of input or, like the grammar, at the
+     *         first invalid placeholder
+     */
+    bool
+    next(raw_placeholder& ph)
+    {
+        while (p_ != end_) {
+            auto brace = static_cast<char const*>(
+                    ::std::memchr(p_, '{', end_ - p_));
+            if (!brace)
+                return false;
+            p_ = brace;
+            if (p_ + 1 != end_ && p_[1] == '{') {
+                p_ += 2;
+                continue;
+            }
+            return parse_placeholder(ph);
         }
+        return false;
+    }
+private:
+    static bool
+    is_name_start(char c)
+    {
+        return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '_';
+    }
+    static bool
+    is_name_char(char c)
+    {
+        return is_name_start(c) || (c >= '0' && c <= '9') || c == '.';
+    }
+    static bool
+    is_digit(char c)
+    {
+        return c >= '0' && c <= '9';
     }
 
-    // 2. Renumber placeholders
-    auto delta = name_numbers.size();
-    for (auto& ph : phs) {
-        if (ph.type() == placeholder::number) {
-            ::boost::get<::std::size_t>(ph.id) += delta;
+    /**
+     * Parse a placeholder starting at an opening brace
+     */
+    bool
+    parse_placeholder(raw_placeholder& ph)
+    {
+        ph = raw_placeholder{ p_, nullptr, false, 0, nullptr, 0, false, nullptr, 0 };
+        auto p = p_ + 1;
+        if (p == end_)
+            return false;
+        if (is_digit(*p)) {
+            ph.is_number = true;
+            auto const max = ::std::numeric_limits<::std::size_t>::max();
+            for (; p != end_ && is_digit(*p); ++p) {
+                ::std::size_t digit = *p - '0';
+                if (ph.number > (max - digit) / 10)
+                    return false;
+                ph.number = ph.number * 10 + digit;
+            }
         } else {
-            auto const& nm = ::boost::get< ::std::string >(ph.id);
-            ph.id = name_numbers[nm].number;
+            if (end_ - p > 1 && p[0] == 'n' && p[1] == ':') {
+                ph.is_pluralizer = true;
+                p += 2;
+            }
+            if (p == end_ || !is_name_start(*p))
+                return false;
+            ph.name = p;
+            for (++p; p != end_ && is_name_char(*p); ++p);
+            ph.name_size = p - ph.name;
         }
+        if (p == end_)
+            return false;
+        if (*p == ',' && p + 1 != end_ && p[1] != '}') {
+            ph.options = ++p;
+            auto close = static_cast<char const*>(
+                    ::std::memchr(p, '}', end_ - p));
+            if (!close)
+                return false;
+            ph.options_size = close - ph.options;
+            p = close;
+        }
+        if (*p != '}')
+            return false;
+        p_ = ph.end = p + 1;
+        return true;
     }
-    // 3. Construct message id with replaced placeholders
-    ::std::ostringstream os;
-    auto ph = phs.begin();
-    for (auto c = input.begin(); c != input.end(); ++c) {
-        if (*c == '{') {
-            ::std::ostringstream backtrack;
-            for (; c != input.end() && *c != '}'; ++c) {
-                backtrack.put(*c);
-            }
-            if (c == input.end()) {
-                os << backtrack.str();
-            } else {
-                os << *ph++;
-            }
+private:
+    char const* p_;
+    char const* end_;
+};
+
+/**
+ * Sequence of trivial values stored inline up to N values, in a vector
+ * when there are more
+ */
+template < typename T, ::std::size_t N >
+class small_buffer {
+public:
+    small_buffer() : size_{0} {}
+
+    void
+    push_back(T const& v)
+    {
+        if (size_ < N) {
+            inline_[size_] = v;
         } else {
-            os.put(*c);
+            if (overflow_.empty())
+                overflow_.assign(inline_, inline_ + N);
+            overflow_.push_back(v);
         }
+        ++size_;
     }
-    // 4. Remove duplicate names
-    if (named_phs.size() != name_numbers.size()) {
-        placeholders tmp;
-        tmp.reserve(name_numbers.size());
-        ::std::set<::std::string> seen;
-        for (auto& ph: named_phs) {
-            auto const& nm = ::boost::get< ::std::string >(ph.id);
-            if (!seen.count(nm)) {
-                auto const& use = name_numbers[nm];
-                ph.is_pluralizer = use.is_pluralizer;
-                ph.uses = use.uses;
-                tmp.push_back(ph);
-                seen.emplace(nm);
+
+    T*
+    begin()
+    { return size_ <= N ? inline_ : overflow_.data(); }
+    T*
+    end()
+    { return begin() + size_; }
+    T const*
+    begin() const
+    { return size_ <= N ? inline_ : overflow_.data(); }
+    T const*
+    end() const
+    { return begin() + size_; }
+
+    T&
+    operator[](::std::size_t idx)
+    { return begin()[idx]; }
+    T const&
+    operator[](::std::size_t idx) const
+    { return begin()[idx]; }
+
+    ::std::size_t
+    size() const
+    { return size_; }
+    bool
+    empty() const
+    { return size_ == 0; }
+private:
+    T                   inline_[N];
+    ::std::vector<T>    overflow_;
+    ::std::size_t       size_;
+};
+
+/**
+ * Name of a placeholder and it's usage in a message
+ */
+struct name_usage {
+    char const*     name;
+    ::std::size_t   size;
+    ::std::size_t   first;
+    bool            is_pluralizer;
+    ::std::size_t   uses;
+};
+
+/**
+ * Small flat map of placeholder names in order of first appearance,
+ * number of a name is it's index + 1
+ */
+class name_table {
+public:
+
+    ::std::size_t
+    add(raw_placeholder const& ph, ::std::size_t idx)
+    {
+        for (::std::size_t i = 0; i < names_.size(); ++i) {
+            auto& n = names_[i];
+            if (n.size == ph.name_size &&
+                    ::std::memcmp(n.name, ph.name, n.size) == 0) {
+                n.is_pluralizer = n.is_pluralizer || ph.is_pluralizer;
+                ++n.uses;
+                return i + 1;
             }
         }
-        named_phs.swap(tmp);
+        names_.push_back(name_usage{ ph.name, ph.name_size, idx,
+            ph.is_pluralizer, 1 });
+        return names_.size();
+    }
+
+    ::std::size_t
+    size() const
+    { return names_.size(); }
+    bool
+    empty() const
+    { return names_.empty(); }
+
+    name_usage const*
+    begin() const
+    { return names_.begin(); }
+    name_usage const*
+    end() const
+    { return names_.end(); }
+private:
+    small_buffer<name_usage, 8> names_;
+};
+
+void
+append_number(::std::string& out, ::std::size_t n)
+{
+    char buffer[24];
+    auto p = buffer + sizeof(buffer);
+    do {
+        *--p = static_cast<char>('0' + n % 10);
+        n /= 10;
+    } while (n);
+    out.append(p, buffer + sizeof(buffer));
+}
+
+}  /* namespace  */
+
+placeholders
+extract_placeholders(::std::string const& input)
+{
+    placeholders phs;
+    placeholder_scanner scanner{input.data(), input.data() + input.size()};
+    raw_placeholder ph;
+    while (scanner.next(ph)) {
+        phs.push_back(ph.get());
+    }
+    return phs;
+}
+
+::std::pair<::std::string, placeholders>
+extract_named_placeholders(::std::string const& input)
+{
+    // Scan the input once, assigning numbers to names. The number of
+    // a named placeholder is stored in the raw placeholder.
+    small_buffer<raw_placeholder, 16> phs;
+    name_table names;
+    placeholder_scanner scanner{input.data(), input.data() + input.size()};
+    raw_placeholder ph;
+    while (scanner.next(ph)) {
+        if (!ph.is_number)
+            ph.number = names.add(ph, phs.size());
+        phs.push_back(ph);
+    }
+    if (names.empty())
+        return {input, placeholders{}};
+
+    // Numbered placeholders go after the named ones
+    auto delta = names.size();
+    ::std::pair<::std::string, placeholders> res;
+    auto& out = res.first;
+    out.reserve(input.size() + phs.size() * 2);
+    auto text = input.data();
+    for (auto const& p : phs) {
+        out.append(text, p.begin);
+        out += '{';
+        append_number(out, p.is_number ? p.number + delta : p.number);
+        if (p.options_size) {
+            out += ',';
+            out.append(p.options, p.options_size);
+        }
+        out += '}';
+        text = p.end;
     }
+    out.append(text, input.data() + input.size());
 
-    return { os.str(), named_phs };
+    res.second.resize(names.size());
+    auto named = res.second.begin();
+    for (auto const& n : names) {
+        auto const& first = phs[n.first];
+        named->id = ::std::string{n.name, n.size};
+        named->is_pluralizer = n.is_pluralizer;
+        named->options.assign(first.options, first.options_size);
+        named->uses = n.uses;
+        ++named;
+    }
+    return res;
 }
 
+namespace detail {
+
+named_placeholders
+make_named_placeholders(char const* str, ::std::size_t size,
+        static_placeholder const* phs, ::std::size_t count)
+{
+    named_placeholders res;
+    res.first.assign(str, size);
+    if (count == 0)
+        return res;
+    res.second.resize(count);
+    auto named = res.second.begin();
+    for (auto ph = phs; ph != phs + count; ++ph, ++named) {
+        named->id = ::std::string{ph->name, ph->name_size};
+        named->is_pluralizer = ph->is_pluralizer;
+        named->options.assign(ph->options, ph->options_size);
+        named->uses = ph->uses;
+    }
+    return res;
+}
+
+}  /* namespace detail */
+
 }  /* namespace l10n */
 }  /* namespace psst */
-
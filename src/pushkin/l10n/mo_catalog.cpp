@@ -0,0 +1,510 @@
+/*
+ * mo_catalog.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: zmij
+ */
+
+#include <pushkin/l10n/mo_catalog.hpp>
+
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace psst {
+namespace l10n {
+
+namespace {
+
+::std::uint32_t const mo_magic          = 0x950412de;
+::std::uint32_t const mo_magic_swapped  = 0xde120495;
+::std::size_t const   mo_header_size    = 28;
+char const            context_separator = '\x04';
+
+/**
+ * Hash function used by gettext for the hash table in .mo files
+ */
+class hash_pjw {
+public:
+    void
+    feed(char const* s)
+    {
+        while (*s)
+            feed(*s++);
+    }
+    void
+    feed(char c)
+    {
+        hval_ <<= 4;
+        hval_ += static_cast<unsigned char>(c);
+        ::std::uint32_t g = hval_ & (static_cast<::std::uint32_t>(0xf) << 28);
+        if (g != 0) {
+            hval_ ^= g >> 24;
+            hval_ ^= g;
+        }
+    }
+    ::std::uint32_t
+    value() const
+    { return hval_; }
+private:
+    ::std::uint32_t hval_ = 0;
+};
+
+/**
+ * Message key, context and id without allocating the concatenation
+ */
+struct message_key {
+    char const* context;
+    char const* id;
+    ::std::size_t context_size;
+    ::std::size_t id_size;
+
+    message_key(char const* ctx, char const* msgid)
+        : context{ctx && *ctx ? ctx : nullptr}, id{msgid},
+          context_size{context ? ::std::strlen(context) : 0},
+          id_size{::std::strlen(id)}
+    {
+    }
+
+    ::std::uint32_t
+    hash() const
+    {
+        hash_pjw h;
+        if (context) {
+            h.feed(context);
+            h.feed(context_separator);
+        }
+        h.feed(id);
+        return h.value();
+    }
+
+    /**
+     * Test if original string of catalog entry matches the key
+     * @param str       Original string, singular and plural forms separated
+     *                  by zero char
+     * @param size      Size of the original string
+     * @return
+     */
+    bool
+    matches(char const* str, ::std::size_t size) const
+    {
+        if (context) {
+            if (size < context_size + 1 + id_size ||
+                    ::std::memcmp(str, context, context_size) != 0 ||
+                    str[context_size] != context_separator)
+                return false;
+            str += context_size + 1;
+            size -= context_size + 1;
+        }
+        return size >= id_size && ::std::memcmp(str, id, id_size) == 0 &&
+                str[id_size] == 0;
+    }
+};
+
+}  /* namespace  */
+
+struct mo_catalog::impl {
+    using index_type = ::std::vector<::std::uint32_t>;
+
+    ::std::string       path;
+    char const*         data    = nullptr;
+    ::std::size_t       size    = 0;
+    bool                swapped = false;
+
+    ::std::uint32_t     count       = 0;
+    ::std::uint32_t     orig_table  = 0;
+    ::std::uint32_t     trans_table = 0;
+    ::std::uint32_t     hash_size   = 0;
+    ::std::uint32_t     hash_table  = 0;
+
+    // Index built if the file has no hash table
+    index_type          index;
+    plural_forms        plural;
+
+    explicit
+    impl(::std::string const& p) : path{p}
+    {
+        map();
+        try {
+            read_header();
+        } catch (...) {
+            unmap();
+            throw;
+        }
+    }
+    ~impl()
+    {
+        unmap();
+    }
+
+    void
+    error(char const* what) const
+    {
+        throw ::std::runtime_error{ path + ": " + what };
+    }
+
+    void
+    map()
+    {
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0)
+            error("cannot open message catalog");
+        struct ::stat st;
+        if (::fstat(fd, &st) != 0 || st.st_size <= 0) {
+            ::close(fd);
+            error("cannot read message catalog");
+        }
+        size = static_cast<::std::size_t>(st.st_size);
+        void* p = ::mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+        ::close(fd);
+        if (p == MAP_FAILED)
+            error("cannot map message catalog");
+        data = static_cast<char const*>(p);
+    }
+    void
+    unmap()
+    {
+        if (data) {
+            ::munmap(const_cast<char*>(data), size);
+            data = nullptr;
+        }
+    }
+
+    ::std::uint32_t
+    word(::std::size_t offset) const
+    {
+        ::std::uint32_t w;
+        ::std::memcpy(&w, data + offset, sizeof(w));
+        if (swapped) {
+            w = ((w & 0xff) << 24) | ((w & 0xff00) << 8) |
+                ((w >> 8) & 0xff00) | (w >> 24);
+        }
+        return w;
+    }
+
+    void
+    read_header()
+    {
+        if (size < mo_header_size)
+            error("message catalog is too short");
+        ::std::uint32_t magic;
+        ::std::memcpy(&magic, data, sizeof(magic));
+        if (magic == mo_magic_swapped) {
+            swapped = true;
+        } else if (magic != mo_magic) {
+            error("invalid message catalog magic number");
+        }
+        count       = word(8);
+        orig_table  = word(12);
+        trans_table = word(16);
+        hash_size   = word(20);
+        hash_table  = word(24);
+
+        if (!table_fits(orig_table, count, 8) ||
+                !table_fits(trans_table, count, 8))
+            error("message catalog string tables are out of bounds");
+        for (::std::uint32_t i = 0; i < count; ++i) {
+            if (!string_fits(orig_table + i * 8) ||
+                    !string_fits(trans_table + i * 8))
+                error("message catalog string is out of bounds");
+        }
+        if (hash_size > 2) {
+            if (!table_fits(hash_table, hash_size, 4))
+                error("message catalog hash table is out of bounds");
+        } else {
+            build_index();
+        }
+        auto header = find(message_key{nullptr, ""});
+        if (header >= 0) {
+            plural = plural_forms::from_header(::std::string{
+                translation(header), translation_size(header)});
+        }
+    }
+
+    bool
+    table_fits(::std::size_t offset, ::std::size_t entries,
+            ::std::size_t entry_size) const
+    {
+        return offset <= size && entries <= (size - offset) / entry_size;
+    }
+    bool
+    string_fits(::std::size_t descriptor) const
+    {
+        ::std::size_t length = word(descriptor);
+        ::std::size_t offset = word(descriptor + 4);
+        return offset < size && length < size - offset &&
+                data[offset + length] == 0;
+    }
+
+    char const*
+    original(::std::uint32_t i) const
+    { return data + word(orig_table + i * 8 + 4); }
+    ::std::size_t
+    original_size(::std::uint32_t i) const
+    { return word(orig_table + i * 8); }
+    char const*
+    translation(::std::uint32_t i) const
+    { return data + word(trans_table + i * 8 + 4); }
+    ::std::size_t
+    translation_size(::std::uint32_t i) const
+    { return word(trans_table + i * 8); }
+
+    void
+    build_index()
+    {
+        ::std::size_t sz = 16;
+        while (sz < count * 2)
+            sz <<= 1;
+        index.assign(sz, 0);
+        for (::std::uint32_t i = 0; i < count; ++i) {
+            hash_pjw h;
+            h.feed(original(i));
+            auto pos = h.value() & (sz - 1);
+            while (index[pos])
+                pos = (pos + 1) & (sz - 1);
+            index[pos] = i + 1;
+        }
+    }
+
+    /**
+     * @param key
+     * @return Index of entry, -1 if not found
+     */
+    long
+    find(message_key const& key) const
+    {
+        auto hval = key.hash();
+        if (!index.empty()) {
+            auto mask = index.size() - 1;
+            for (auto pos = hval & mask; index[pos]; pos = (pos + 1) & mask) {
+                auto i = index[pos] - 1;
+                if (key.matches(original(i), original_size(i)))
+                    return i;
+            }
+            return -1;
+        }
+        // Double hashing as in gettext
+        ::std::uint32_t idx = hval % hash_size;
+        ::std::uint32_t incr = 1 + (hval % (hash_size - 2));
+        for (::std::uint32_t probe = 0; probe < hash_size; ++probe) {
+            auto entry = word(hash_table + idx * 4);
+            if (entry == 0)
+                return -1;
+            --entry;
+            if (entry < count && key.matches(original(entry), original_size(entry)))
+                return entry;
+            if (idx >= hash_size - incr) {
+                idx -= hash_size - incr;
+            } else {
+                idx += incr;
+            }
+        }
+        return -1;
+    }
+
+    char const*
+    get(message_key const& key, long form) const
+    {
+        if (!key.id_size || form < 0)
+            return nullptr;
+        auto i = find(key);
+        if (i < 0)
+            return nullptr;
+        auto str = translation(i);
+        auto end = str + translation_size(i);
+        for (; form > 0 && str < end; --form) {
+            str += ::std::strlen(str) + 1;
+        }
+        if (str >= end || !*str)
+            return nullptr;
+        return str;
+    }
+};
+
+mo_catalog::mo_catalog(::std::string const& path)
+    : pimpl_{ new impl{path} }
+{
+}
+
+mo_catalog::~mo_catalog() = default;
+
+::std::string const&
+mo_catalog::path() const
+{
+    return pimpl_->path;
+}
+
+::std::size_t
+mo_catalog::size() const
+{
+    return pimpl_->count;
+}
+
+plural_forms const&
+mo_catalog::plural() const
+{
+    return pimpl_->plural;
+}
+
+char const*
+mo_catalog::get(char const* context, char const* id) const
+{
+    return pimpl_->get(message_key{context, id}, 0);
+}
+
+char const*
+mo_catalog::get(char const* context, char const* id, long n) const
+{
+    return pimpl_->get(message_key{context, id}, pimpl_->plural(n));
+}
+
+char const*
+mo_catalog::get_form(char const* context, char const* id, long form) const
+{
+    return pimpl_->get(message_key{context, id}, form);
+}
+
+//----------------------------------------------------------------------------
+mo_message_format::mo_message_format(domain_list const& domains,
+        ::std::size_t refs)
+    : ::boost::locale::message_format<char>{refs}, domains_{domains}
+{
+}
+
+mo_catalog const*
+mo_message_format::catalog(int domain_id) const
+{
+    if (domain_id < 0 || static_cast<::std::size_t>(domain_id) >= domains_.size())
+        return nullptr;
+    return domains_[domain_id].second.get();
+}
+
+char const*
+mo_message_format::get(int domain_id, char const* context, char const* id) const
+{
+    auto cat = catalog(domain_id);
+    return cat ? cat->get(context, id) : nullptr;
+}
+
+char const*
+mo_message_format::get(int domain_id, char const* context, char const* id,
+        int n) const
+{
+    auto cat = catalog(domain_id);
+    return cat ? cat->get(context, id, n) : nullptr;
+}
+
+int
+mo_message_format::domain(::std::string const& name) const
+{
+    for (::std::size_t i = 0; i < domains_.size(); ++i) {
+        if (domains_[i].first == name)
+            return static_cast<int>(i);
+    }
+    return -1;
+}
+
+char const*
+mo_message_format::convert(char const* msg, ::std::string&) const
+{
+    return msg;
+}
+
+long
+mo_message_format::plural_form(int domain_id, long n) const
+{
+    auto cat = catalog(domain_id);
+    return cat ? cat->plural()(n) : -1;
+}
+
+::std::size_t
+mo_message_format::plural_count(int domain_id) const
+{
+    auto cat = catalog(domain_id);
+    return cat ? cat->plural().size() : 0;
+}
+
+char const*
+mo_message_format::get_form(int domain_id, char const* context, char const* id,
+        long form) const
+{
+    auto cat = catalog(domain_id);
+    return cat ? cat->get_form(context, id, form) : nullptr;
+}
+
+//----------------------------------------------------------------------------
+namespace {
+
+bool
+file_exists(::std::string const& path)
+{
+    struct ::stat st;
+    return ::stat(path.c_str(), &st) == 0 && S_ISREG(st.st_mode);
+}
+
+::std::vector<::std::string>
+locale_dirs(::std::string const& name)
+{
+    // lang_COUNTRY.encoding@variant
+    auto variant_pos = name.find('@');
+    ::std::string variant = variant_pos == ::std::string::npos ?
+            ::std::string{} : name.substr(variant_pos);
+    auto base = name.substr(0, variant_pos);
+    base = base.substr(0, base.find('.'));
+    auto lang = base.substr(0, base.find('_'));
+
+    ::std::vector<::std::string> dirs;
+    if (!variant.empty()) {
+        if (base != lang)
+            dirs.push_back(base + variant);
+        dirs.push_back(lang + variant);
+    }
+    if (base != lang)
+        dirs.push_back(base);
+    dirs.push_back(lang);
+    return dirs;
+}
+
+}  /* namespace  */
+
+mo_message_format::domain_list
+find_catalogs(::std::string const& locale_name,
+        ::std::vector<::std::string> const& paths,
+        ::std::vector<::std::string> const& domains)
+{
+    auto dirs = locale_dirs(locale_name);
+    mo_message_format::domain_list result;
+    for (auto const& domain : domains) {
+        mo_catalog_ptr catalog;
+        for (auto const& dir : dirs) {
+            for (auto const& path : paths) {
+                auto file = path + "/" + dir + "/LC_MESSAGES/" + domain + ".mo";
+                if (file_exists(file)) {
+                    catalog = ::std::make_shared<mo_catalog>(file);
+                    break;
+                }
+            }
+            if (catalog)
+                break;
+        }
+        result.emplace_back(domain, catalog);
+    }
+    return result;
+}
+
+::std::locale
+catalog_locale(::std::locale const& base, ::std::string const& locale_name,
+        ::std::vector<::std::string> const& paths,
+        ::std::vector<::std::string> const& domains)
+{
+    return ::std::locale{ base,
+        new mo_message_format{ find_catalogs(locale_name, paths, domains) } };
+}
+
+}  /* namespace l10n */
+}  /* namespace psst */
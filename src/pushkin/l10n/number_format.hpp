@@ -0,0 +1,86 @@
+/*
+ * number_format.hpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: zmij
+ */
+
+#ifndef PUSHKIN_L10N_NUMBER_FORMAT_HPP_
+#define PUSHKIN_L10N_NUMBER_FORMAT_HPP_
+
+#include <clocale>
+#include <cstdio>
+#include <locale>
+#include <string>
+
+namespace psst {
+namespace l10n {
+namespace detail {
+
+/**
+ * Numbers written to a stream imbued with the locale with default flags
+ * are plain: no digit grouping and a dot as decimal point. This is the
+ * case for locales created by ::boost::locale::generator.
+ * @param loc
+ * @return
+ */
+inline bool
+plain_numbers(::std::locale const& loc)
+{
+    using numpunct = ::std::numpunct<char>;
+    if (!::std::has_facet<numpunct>(loc))
+        return true;
+    auto const& np = ::std::use_facet<numpunct>(loc);
+    return np.grouping().empty() && np.decimal_point() == '.';
+}
+
+/**
+ * Append an integer as it would be written by a stream with default flags
+ * and plain numbers.
+ */
+template < typename T >
+void
+append_integer(::std::string& out, T val)
+{
+    char buffer[24];
+    char* end = buffer + sizeof(buffer);
+    char* p = end;
+    // Negate by digits to handle the minimum value
+    bool negative = val < 0;
+    do {
+        int digit = static_cast<int>(val % 10);
+        *--p = static_cast<char>('0' + (negative ? -digit : digit));
+        val /= 10;
+    } while (val != 0);
+    if (negative)
+        *--p = '-';
+    out.append(p, end);
+}
+
+/**
+ * Append a floating point number as it would be written by a stream with
+ * default flags and precision and plain numbers.
+ */
+inline void
+append_double(::std::string& out, double val)
+{
+    char buffer[32];
+    int sz = ::std::snprintf(buffer, sizeof(buffer), "%.6g", val);
+    if (sz <= 0)
+        return;
+    // snprintf uses C locale decimal point
+    char dp = *::std::localeconv()->decimal_point;
+    if (dp != '.') {
+        for (int i = 0; i < sz; ++i) {
+            if (buffer[i] == dp)
+                buffer[i] = '.';
+        }
+    }
+    out.append(buffer, sz);
+}
+
+}  /* namespace detail */
+}  /* namespace l10n */
+}  /* namespace psst */
+
+#endif /* PUSHKIN_L10N_NUMBER_FORMAT_HPP_ */
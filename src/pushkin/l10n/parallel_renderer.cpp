@@ -0,0 +1,362 @@
+/*
+ * parallel_renderer.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: zmij
+ */
+
+#include <pushkin/l10n/parallel_renderer.hpp>
+#include "batch_renderer.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace psst {
+namespace l10n {
+
+namespace {
+
+using string_list = message::string_list;
+
+/**
+ * A list of messages being rendered
+ */
+struct render_job {
+    using result_callback       = parallel_renderer::result_callback;
+    using completion_callback   = parallel_renderer::completion_callback;
+    using mutex_type            = ::std::mutex;
+    using lock_type             = ::std::lock_guard<mutex_type>;
+
+    message_list                    messages;
+    ::std::locale                   loc;
+    result_callback                 on_result;
+    completion_callback             on_complete;
+    bool                            ordered;
+    ::std::size_t                   chunk_size;
+    ::std::size_t                   chunks;
+
+    ::std::atomic<::std::size_t>    remaining;
+    ::std::atomic<bool>             failed;
+
+    mutex_type                      mtx;
+    ::std::exception_ptr            error;
+    // Rendered chunks waiting for ordered delivery
+    ::std::vector<string_list>      pending;
+    ::std::vector<bool>             ready;
+    ::std::size_t                   next;
+
+    render_job(message_list&& m, ::std::locale const& l, result_callback&& r,
+            completion_callback&& c, bool o, ::std::size_t size)
+        : messages(::std::move(m)), loc(l), on_result(::std::move(r)),
+          on_complete(::std::move(c)), ordered(o), chunk_size(size),
+          // An empty list is one empty chunk, so that the completion
+          // callback is called from a worker as for any other list
+          chunks(::std::max<::std::size_t>(
+                  (messages.size() + size - 1) / size, 1)),
+          remaining{chunks}, failed{false}, next{0}
+    {
+        if (ordered) {
+            pending.resize(chunks);
+            ready.resize(chunks, false);
+        }
+    }
+
+    void
+    fail(::std::exception_ptr e)
+    {
+        lock_type lock{mtx};
+        if (!error)
+            error = e;
+        failed = true;
+    }
+
+    void
+    render(::std::size_t chunk)
+    {
+        auto begin = chunk * chunk_size;
+        auto end = ::std::min(begin + chunk_size, messages.size());
+        detail::batch_renderer renderer{loc};
+        if (ordered) {
+            string_list strs(end - begin);
+            for (auto i = begin; i < end && !failed; ++i) {
+                renderer.render(strs[i - begin], messages[i], 0, true);
+            }
+            deliver(chunk, ::std::move(strs));
+        } else {
+            for (auto i = begin; i < end && !failed; ++i) {
+                ::std::string str;
+                renderer.render(str, messages[i], 0, true);
+                on_result(i, ::std::move(str));
+            }
+        }
+    }
+
+    /**
+     * Deliver the chunk and the following rendered chunks, if all of the
+     * previous chunks are delivered
+     */
+    void
+    deliver(::std::size_t chunk, string_list&& strs)
+    {
+        lock_type lock{mtx};
+        pending[chunk] = ::std::move(strs);
+        ready[chunk] = true;
+        for (; next < chunks && ready[next] && !failed; ++next) {
+            auto& rendered = pending[next];
+            try {
+                for (::std::size_t i = 0; i < rendered.size(); ++i) {
+                    on_result(next * chunk_size + i, ::std::move(rendered[i]));
+                }
+            } catch (...) {
+                // Fail under the lock, so that no other worker delivers
+                // the rest of the chunk
+                if (!error)
+                    error = ::std::current_exception();
+                failed = true;
+                return;
+            }
+            string_list{}.swap(rendered);
+        }
+    }
+
+    void
+    run(::std::size_t chunk)
+    {
+        if (!failed) {
+            try {
+                render(chunk);
+            } catch (...) {
+                fail(::std::current_exception());
+            }
+        }
+        if (remaining.fetch_sub(1) == 1) {
+            ::std::exception_ptr e;
+            {
+                lock_type lock{mtx};
+                e = error;
+            }
+            on_complete(e);
+        }
+    }
+};
+
+using job_ptr = ::std::shared_ptr<render_job>;
+
+struct render_task {
+    job_ptr         job;
+    ::std::size_t   chunk;
+};
+
+/**
+ * Queue of a worker. The owner takes tasks from the front, other workers
+ * steal from the back. The count of tasks in all of the queues is changed
+ * under the lock of the queue, so it's never more than the count of tasks
+ * a worker can take.
+ */
+struct task_queue {
+    using mutex_type    = ::std::mutex;
+    using lock_type     = ::std::lock_guard<mutex_type>;
+    using counter_type  = ::std::atomic<::std::size_t>;
+
+    mutex_type                  mtx;
+    ::std::deque<render_task>   tasks;
+
+    void
+    push(render_task&& task, counter_type& queued)
+    {
+        lock_type lock{mtx};
+        tasks.push_back(::std::move(task));
+        ++queued;
+    }
+    bool
+    pop_front(render_task& task, counter_type& queued)
+    {
+        lock_type lock{mtx};
+        if (tasks.empty())
+            return false;
+        task = ::std::move(tasks.front());
+        tasks.pop_front();
+        --queued;
+        return true;
+    }
+    bool
+    pop_back(render_task& task, counter_type& queued)
+    {
+        lock_type lock{mtx};
+        if (tasks.empty())
+            return false;
+        task = ::std::move(tasks.back());
+        tasks.pop_back();
+        --queued;
+        return true;
+    }
+};
+
+// Chunks per worker for a list, more chunks balance better, fewer chunks
+// reuse more of the batch lookups
+::std::size_t const chunks_per_worker   = 8;
+::std::size_t const min_chunk_size      = 16;
+::std::size_t const max_chunk_size      = 1024;
+
+}  /* namespace  */
+
+struct parallel_renderer::impl {
+    using queue_ptr     = ::std::unique_ptr<task_queue>;
+    using mutex_type    = ::std::mutex;
+    using lock_type     = ::std::unique_lock<mutex_type>;
+
+    ::std::vector<queue_ptr>        queues;
+    ::std::vector<::std::thread>    threads;
+
+    mutex_type                      mtx;
+    ::std::condition_variable       cv;
+    ::std::atomic<::std::size_t>    queued;
+    bool                            stop;
+
+    explicit
+    impl(::std::size_t size)
+        : queued{0}, stop{false}
+    {
+        if (size == 0)
+            size = ::std::max(::std::thread::hardware_concurrency(), 1u);
+        for (::std::size_t i = 0; i < size; ++i) {
+            queues.emplace_back(new task_queue{});
+        }
+        for (::std::size_t i = 0; i < size; ++i) {
+            threads.emplace_back([this, i]() { work(i); });
+        }
+    }
+    ~impl()
+    {
+        {
+            lock_type lock{mtx};
+            stop = true;
+        }
+        cv.notify_all();
+        for (auto& t : threads) {
+            t.join();
+        }
+    }
+
+    void
+    submit(job_ptr const& job)
+    {
+        {
+            lock_type lock{mtx};
+            // Chunks are dealt round robin, so that the workers progress
+            // through the list from it's beginning
+            for (::std::size_t c = 0; c < job->chunks; ++c) {
+                queues[c % queues.size()]->push(render_task{ job, c }, queued);
+            }
+        }
+        cv.notify_all();
+    }
+
+    bool
+    take(::std::size_t idx, render_task& task)
+    {
+        if (queues[idx]->pop_front(task, queued))
+            return true;
+        for (::std::size_t i = 1; i < queues.size(); ++i) {
+            if (queues[(idx + i) % queues.size()]->pop_back(task, queued))
+                return true;
+        }
+        return false;
+    }
+
+    void
+    work(::std::size_t idx)
+    {
+        render_task task;
+        while (true) {
+            if (take(idx, task)) {
+                task.job->run(task.chunk);
+                task.job.reset();
+                continue;
+            }
+            lock_type lock{mtx};
+            cv.wait(lock, [this]() { return stop || queued > 0; });
+            if (stop && queued == 0)
+                return;
+        }
+    }
+
+    ::std::size_t
+    chunk_size(::std::size_t messages) const
+    {
+        auto size = messages / (queues.size() * chunks_per_worker);
+        return ::std::min(::std::max(size, min_chunk_size), max_chunk_size);
+    }
+};
+
+parallel_renderer::parallel_renderer(::std::size_t threads)
+    : pimpl_{ new impl{threads} }
+{
+}
+
+parallel_renderer::~parallel_renderer() = default;
+
+::std::size_t
+parallel_renderer::size() const
+{
+    return pimpl_->threads.size();
+}
+
+void
+parallel_renderer::render(message_list messages, ::std::locale const& loc,
+        result_callback on_result, completion_callback on_complete,
+        delivery order)
+{
+    auto size = pimpl_->chunk_size(messages.size());
+    pimpl_->submit(::std::make_shared<render_job>(::std::move(messages), loc,
+            ::std::move(on_result), ::std::move(on_complete),
+            order == delivery::ordered, size));
+}
+
+::std::future<void>
+parallel_renderer::render(message_list messages, ::std::locale const& loc,
+        result_callback on_result, delivery order)
+{
+    auto done = ::std::make_shared<::std::promise<void>>();
+    auto res = done->get_future();
+    render(::std::move(messages), loc, ::std::move(on_result),
+        [done](::std::exception_ptr e)
+        {
+            if (e) {
+                done->set_exception(e);
+            } else {
+                done->set_value();
+            }
+        }, order);
+    return res;
+}
+
+::std::future<message::string_list>
+parallel_renderer::render(message_list messages, ::std::locale const& loc)
+{
+    auto strs = ::std::make_shared<string_list>(messages.size());
+    auto done = ::std::make_shared<::std::promise<string_list>>();
+    auto res = done->get_future();
+    render(::std::move(messages), loc,
+        [strs](::std::size_t idx, ::std::string&& str)
+        {
+            (*strs)[idx] = ::std::move(str);
+        },
+        [strs, done](::std::exception_ptr e)
+        {
+            if (e) {
+                done->set_exception(e);
+            } else {
+                done->set_value(::std::move(*strs));
+            }
+        }, delivery::unordered);
+    return res;
+}
+
+}  /* namespace l10n */
+}  /* namespace psst */
@@ -0,0 +1,78 @@
+/*
+ * placeholder_cache.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: zmij
+ */
+
+#include <pushkin/l10n/placeholder_cache.hpp>
+
+namespace psst {
+namespace l10n {
+
+struct placeholder_cache::impl {
+    using cache_type = lru_cache<::std::string, named_placeholders_ptr>;
+
+    cache_type cache;
+
+    explicit
+    impl(::std::size_t capacity) : cache{capacity} {}
+};
+
+placeholder_cache::placeholder_cache(::std::size_t capacity)
+    : pimpl_{ new impl{capacity} }
+{
+}
+
+placeholder_cache::~placeholder_cache() = default;
+
+placeholder_cache&
+placeholder_cache::instance()
+{
+    // Never destroyed, messages can be created by static objects' destructors
+    static placeholder_cache* cache = new placeholder_cache{};
+    return *cache;
+}
+
+named_placeholders_ptr
+placeholder_cache::get(::std::string const& tmpl)
+{
+    return pimpl_->cache.get(tmpl, [&]()
+    {
+        return ::std::make_shared<named_placeholders const>(
+                extract_named_placeholders(tmpl));
+    });
+}
+
+::std::size_t
+placeholder_cache::capacity() const
+{
+    return pimpl_->cache.capacity();
+}
+
+void
+placeholder_cache::set_capacity(::std::size_t capacity)
+{
+    pimpl_->cache.set_capacity(capacity);
+}
+
+void
+placeholder_cache::clear()
+{
+    pimpl_->cache.clear();
+}
+
+cache_stats
+placeholder_cache::stats() const
+{
+    return pimpl_->cache.stats();
+}
+
+void
+placeholder_cache::reset_stats()
+{
+    pimpl_->cache.reset_stats();
+}
+
+}  /* namespace l10n */
+}  /* namespace psst */
@@ -0,0 +1,506 @@
+/*
+ * plural_forms.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: zmij
+ */
+
+#include <pushkin/l10n/plural_forms.hpp>
+
+#include <cctype>
+#include <cstdlib>
+#include <stdexcept>
+#include <utility>
+
+namespace psst {
+namespace l10n {
+
+/**
+ * Recursive descent parser of the plural expression, with C operator
+ * precedence.
+ */
+class plural_forms::parser {
+public:
+    parser(::std::string const& expr, nodes& n)
+        : p_{expr.c_str()}, nodes_(n) {}
+
+    int
+    parse()
+    {
+        auto root = condition();
+        skip_ws();
+        if (*p_)
+            error("Unexpected characters at the end of plural expression");
+        return root;
+    }
+private:
+    int
+    condition()
+    {
+        auto cond = logical_or();
+        if (accept("?")) {
+            auto then = condition();
+            expect(":");
+            auto otherwise = condition();
+            return add(op_cond, cond, then, otherwise);
+        }
+        return cond;
+    }
+    int
+    logical_or()
+    {
+        auto lhs = logical_and();
+        while (accept("||")) {
+            lhs = add(op_or, lhs, logical_and());
+        }
+        return lhs;
+    }
+    int
+    logical_and()
+    {
+        auto lhs = equality();
+        while (accept("&&")) {
+            lhs = add(op_and, lhs, equality());
+        }
+        return lhs;
+    }
+    int
+    equality()
+    {
+        auto lhs = relation();
+        while (true) {
+            if (accept("==")) {
+                lhs = add(op_eq, lhs, relation());
+            } else if (accept("!=")) {
+                lhs = add(op_ne, lhs, relation());
+            } else {
+                return lhs;
+            }
+        }
+    }
+    int
+    relation()
+    {
+        auto lhs = additive();
+        while (true) {
+            if (accept("<=")) {
+                lhs = add(op_le, lhs, additive());
+            } else if (accept(">=")) {
+                lhs = add(op_ge, lhs, additive());
+            } else if (accept("<")) {
+                lhs = add(op_lt, lhs, additive());
+            } else if (accept(">")) {
+                lhs = add(op_gt, lhs, additive());
+            } else {
+                return lhs;
+            }
+        }
+    }
+    int
+    additive()
+    {
+        auto lhs = multiplicative();
+        while (true) {
+            if (accept("+")) {
+                lhs = add(op_add, lhs, multiplicative());
+            } else if (accept("-")) {
+                lhs = add(op_sub, lhs, multiplicative());
+            } else {
+                return lhs;
+            }
+        }
+    }
+    int
+    multiplicative()
+    {
+        auto lhs = unary();
+        while (true) {
+            if (accept("*")) {
+                lhs = add(op_mul, lhs, unary());
+            } else if (accept("/")) {
+                lhs = add(op_div, lhs, unary());
+            } else if (accept("%")) {
+                lhs = add(op_mod, lhs, unary());
+            } else {
+                return lhs;
+            }
+        }
+    }
+    int
+    unary()
+    {
+        if (accept("!") )
+            return add(op_not, unary());
+        return primary();
+    }
+    int
+    primary()
+    {
+        skip_ws();
+        if (*p_ == 'n') {
+            ++p_;
+            return add(op_n);
+        }
+        if (::std::isdigit(static_cast<unsigned char>(*p_))) {
+            char* end = nullptr;
+            long value = ::std::strtol(p_, &end, 10);
+            p_ = end;
+            auto idx = add(op_const);
+            nodes_[idx].value = value;
+            return idx;
+        }
+        if (accept("(")) {
+            auto expr = condition();
+            expect(")");
+            return expr;
+        }
+        error("Unexpected character in plural expression");
+        return -1;
+    }
+
+    void
+    skip_ws()
+    {
+        while (::std::isspace(static_cast<unsigned char>(*p_)))
+            ++p_;
+    }
+    bool
+    accept(char const* token)
+    {
+        skip_ws();
+        auto p = p_;
+        while (*token) {
+            if (*p++ != *token++)
+                return false;
+        }
+        // Don't take `!` from `!=`, `<` from `<=` etc.
+        if ((p - p_ == 1) && *p == '=' &&
+                (*p_ == '!' || *p_ == '<' || *p_ == '>'))
+            return false;
+        p_ = p;
+        return true;
+    }
+    void
+    expect(char const* token)
+    {
+        if (!accept(token))
+            error(::std::string{"Expected '"} + token + "' in plural expression");
+    }
+    void
+    error(::std::string const& msg)
+    {
+        throw ::std::runtime_error{msg};
+    }
+
+    int
+    add(op_type op, int a = -1, int b = -1, int c = -1)
+    {
+        nodes_.push_back(node{ op, 0, {a, b, c} });
+        return static_cast<int>(nodes_.size() - 1);
+    }
+private:
+    char const* p_;
+    nodes&      nodes_;
+};
+
+namespace {
+
+::std::size_t const max_stack_depth = 32;
+
+}  /* namespace  */
+
+/**
+ * Compiles the expression tree to a program, emits binary operations
+ * with a constant right operand as immediate.
+ */
+class plural_forms::compiler {
+public:
+    compiler(nodes const& n, program& code)
+        : nodes_(n), code_(code), depth_{0} {}
+
+    void
+    compile(int idx)
+    {
+        auto const& nd = nodes_[idx];
+        switch (nd.op) {
+            case op_n:
+                emit(op_n);
+                push();
+                break;
+            case op_const:
+                emit(op_const, nd.value);
+                push();
+                break;
+            case op_not:
+                compile(nd.args[0]);
+                emit(op_not);
+                break;
+            case op_and:
+            case op_or: {
+                // a && b: a; jz false; b; bool; jmp end; false: 0; end:
+                compile(nd.args[0]);
+                auto short_cut = emit(nd.op == op_and ? op_jz : op_jnz);
+                pop();
+                compile(nd.args[1]);
+                emit(op_bool);
+                auto end = emit(op_jmp);
+                pop();
+                target(short_cut);
+                emit(op_const, nd.op == op_and ? 0 : 1);
+                push();
+                target(end);
+                break;
+            }
+            case op_cond: {
+                compile(nd.args[0]);
+                auto otherwise = emit(op_jz);
+                pop();
+                compile(nd.args[1]);
+                auto end = emit(op_jmp);
+                pop();
+                target(otherwise);
+                compile(nd.args[2]);
+                target(end);
+                break;
+            }
+            default: {
+                compile(nd.args[0]);
+                auto const& rhs = nodes_[nd.args[1]];
+                if (rhs.op == op_const) {
+                    code_.push_back(instruction{ nd.op, true, rhs.value });
+                } else {
+                    compile(nd.args[1]);
+                    emit(nd.op);
+                    pop();
+                }
+                break;
+            }
+        }
+    }
+private:
+    ::std::size_t
+    emit(op_type op, long value = 0)
+    {
+        code_.push_back(instruction{ op, false, value });
+        return code_.size() - 1;
+    }
+    void
+    target(::std::size_t jump)
+    {
+        code_[jump].value = static_cast<long>(code_.size());
+    }
+    void
+    push()
+    {
+        if (++depth_ > max_stack_depth)
+            throw ::std::runtime_error{"Plural expression is too complex"};
+    }
+    void
+    pop()
+    { --depth_; }
+private:
+    nodes const&    nodes_;
+    program&        code_;
+    ::std::size_t   depth_;
+};
+
+namespace {
+
+/**
+ * Expressions of common rule families and functions evaluating them,
+ * the function bodies must be the same expressions.
+ */
+struct native_rule {
+    char const* expr;
+    long (*func)(long);
+};
+
+native_rule const native_rules[] {
+    // Asian languages, Turkish
+    { "0",
+      [](long) -> long { return 0; } },
+    // Germanic, Romance and most other languages
+    { "n != 1",
+      [](long n) -> long { return n != 1; } },
+    // French, Brazilian Portuguese
+    { "n > 1",
+      [](long n) -> long { return n > 1; } },
+    // Latvian
+    { "n%10==1 && n%100!=11 ? 0 : n != 0 ? 1 : 2",
+      [](long n) -> long { return n%10==1 && n%100!=11 ? 0 : n != 0 ? 1 : 2; } },
+    // Irish
+    { "n==1 ? 0 : n==2 ? 1 : 2",
+      [](long n) -> long { return n==1 ? 0 : n==2 ? 1 : 2; } },
+    // Romanian
+    { "n==1 ? 0 : (n==0 || (n%100 > 0 && n%100 < 20)) ? 1 : 2",
+      [](long n) -> long { return n==1 ? 0 : (n==0 || (n%100 > 0 && n%100 < 20)) ? 1 : 2; } },
+    // Lithuanian
+    { "n%10==1 && n%100!=11 ? 0 : n%10>=2 && (n%100<10 || n%100>=20) ? 1 : 2",
+      [](long n) -> long { return n%10==1 && n%100!=11 ? 0 : n%10>=2 && (n%100<10 || n%100>=20) ? 1 : 2; } },
+    // Russian, Ukrainian, Belarusian, Serbian, Croatian
+    { "n%10==1 && n%100!=11 ? 0 : n%10>=2 && n%10<=4 && (n%100<10 || n%100>=20) ? 1 : 2",
+      [](long n) -> long { return n%10==1 && n%100!=11 ? 0 : n%10>=2 && n%10<=4 && (n%100<10 || n%100>=20) ? 1 : 2; } },
+    // Czech, Slovak
+    { "(n==1) ? 0 : (n>=2 && n<=4) ? 1 : 2",
+      [](long n) -> long { return (n==1) ? 0 : (n>=2 && n<=4) ? 1 : 2; } },
+    // Polish
+    { "n==1 ? 0 : n%10>=2 && n%10<=4 && (n%100<10 || n%100>=20) ? 1 : 2",
+      [](long n) -> long { return n==1 ? 0 : n%10>=2 && n%10<=4 && (n%100<10 || n%100>=20) ? 1 : 2; } },
+    // Slovenian
+    { "n%100==1 ? 0 : n%100==2 ? 1 : n%100==3 || n%100==4 ? 2 : 3",
+      [](long n) -> long { return n%100==1 ? 0 : n%100==2 ? 1 : n%100==3 || n%100==4 ? 2 : 3; } },
+    // Arabic
+    { "n==0 ? 0 : n==1 ? 1 : n==2 ? 2 : n%100>=3 && n%100<=10 ? 3 : n%100>=11 ? 4 : 5",
+      [](long n) -> long { return n==0 ? 0 : n==1 ? 1 : n==2 ? 2 : n%100>=3 && n%100<=10 ? 3 : n%100>=11 ? 4 : 5; } },
+};
+
+}  /* namespace  */
+
+/**
+ * Canonical form of an expression tree, the same for expressions that
+ * differ only in spacing and redundant parentheses.
+ */
+::std::string
+plural_forms::canonical(nodes const& n, int idx)
+{
+    auto const& nd = n[idx];
+    switch (nd.op) {
+        case op_n:
+            return "n";
+        case op_const:
+            return ::std::to_string(nd.value);
+        default:
+            break;
+    }
+    ::std::string res = "(" + ::std::to_string(static_cast<int>(nd.op));
+    for (auto arg : nd.args) {
+        if (arg >= 0)
+            res += " " + canonical(n, arg);
+    }
+    return res + ")";
+}
+
+plural_forms::function_type
+plural_forms::find_native(::std::string const& canonical_expr)
+{
+    using native_forms = ::std::vector<::std::pair<::std::string, function_type>>;
+    static native_forms const forms = []()
+    {
+        native_forms res;
+        for (auto const& rule : native_rules) {
+            nodes n;
+            auto root = parser{rule.expr, n}.parse();
+            res.emplace_back(canonical(n, root), rule.func);
+        }
+        return res;
+    }();
+    for (auto const& f : forms) {
+        if (f.first == canonical_expr)
+            return f.second;
+    }
+    return nullptr;
+}
+
+plural_forms::plural_forms()
+    : plural_forms{"n != 1", 2}
+{
+}
+
+plural_forms::plural_forms(::std::string const& expr, ::std::size_t nplurals)
+    : expr_{expr}, nplurals_{nplurals}, code_{}, func_{nullptr}
+{
+    if (nplurals_ == 0)
+        throw ::std::runtime_error{"Number of plural forms must be positive"};
+    nodes tree;
+    auto root = parser{expr_, tree}.parse();
+    compiler{tree, code_}.compile(root);
+    func_ = find_native(canonical(tree, root));
+}
+plural_forms
+plural_forms::from_header(::std::string const& header)
+{
+    static ::std::string const tag = "Plural-Forms:";
+    auto start = header.find(tag);
+    if (start == ::std::string::npos)
+        return plural_forms{};
+    auto end = header.find('\n', start);
+    auto line = header.substr(start + tag.size(),
+            end == ::std::string::npos ? end : end - start - tag.size());
+
+    auto np = line.find("nplurals");
+    auto pl = line.find("plural", np == ::std::string::npos ? 0 : np + 8);
+    if (np == ::std::string::npos || pl == ::std::string::npos)
+        return plural_forms{};
+    auto np_eq = line.find('=', np);
+    auto pl_eq = line.find('=', pl);
+    if (np_eq == ::std::string::npos || pl_eq == ::std::string::npos)
+        return plural_forms{};
+    auto nplurals = ::std::strtol(line.c_str() + np_eq + 1, nullptr, 10);
+    auto expr_end = line.find(';', pl_eq);
+    auto expr = line.substr(pl_eq + 1,
+            expr_end == ::std::string::npos ? expr_end : expr_end - pl_eq - 1);
+    try {
+        return plural_forms{expr, static_cast<::std::size_t>(nplurals)};
+    } catch (::std::exception const&) {
+        return plural_forms{};
+    }
+}
+
+long
+plural_forms::run(long n) const
+{
+    long stack[max_stack_depth];
+    ::std::size_t sp = 0;
+    auto const size = code_.size();
+    for (::std::size_t pc = 0; pc < size; ++pc) {
+        auto const& ins = code_[pc];
+        switch (ins.op) {
+            case op_n:
+                stack[sp++] = n;
+                continue;
+            case op_const:
+                stack[sp++] = ins.value;
+                continue;
+            case op_not:
+                stack[sp - 1] = !stack[sp - 1];
+                continue;
+            case op_bool:
+                stack[sp - 1] = stack[sp - 1] != 0;
+                continue;
+            case op_jz:
+                if (!stack[--sp])
+                    pc = ins.value - 1;
+                continue;
+            case op_jnz:
+                if (stack[--sp])
+                    pc = ins.value - 1;
+                continue;
+            case op_jmp:
+                pc = ins.value - 1;
+                continue;
+            default:
+                break;
+        }
+        long b = ins.immediate ? ins.value : stack[--sp];
+        long& a = stack[sp - 1];
+        switch (ins.op) {
+            case op_mul:    a = a * b; break;
+            // Division by zero is undefined in the catalog, yield 0
+            case op_div:    a = b ? a / b : 0; break;
+            case op_mod:    a = b ? a % b : 0; break;
+            case op_add:    a = a + b; break;
+            case op_sub:    a = a - b; break;
+            case op_lt:     a = a < b; break;
+            case op_gt:     a = a > b; break;
+            case op_le:     a = a <= b; break;
+            case op_ge:     a = a >= b; break;
+            case op_eq:     a = a == b; break;
+            case op_ne:     a = a != b; break;
+            default:        a = 0; break;
+        }
+    }
+    return stack[0];
+}
+
+}  /* namespace l10n */
+}  /* namespace psst */
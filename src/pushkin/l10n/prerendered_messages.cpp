@@ -0,0 +1,134 @@
+/*
+ * prerendered_messages.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: zmij
+ */
+
+#include <pushkin/l10n/prerendered_messages.hpp>
+#include <pushkin/l10n/catalog_registry.hpp>
+#include <pushkin/l10n/message_util.hpp>
+#include <pushkin/l10n/translation_cache.hpp>
+
+#include <stdexcept>
+
+namespace psst {
+namespace l10n {
+
+namespace {
+
+using message_format = ::boost::locale::message_format<char>;
+
+void const*
+catalog_of(::std::locale const& loc)
+{
+    // Facet lookup doesn't allocate, unlike comparison of named locales
+    if (::std::has_facet<message_format>(loc))
+        return &::std::use_facet<message_format>(loc);
+    return nullptr;
+}
+
+/**
+ * Arguments of a message without arguments, for the format template
+ */
+struct no_arguments {
+    ::std::size_t
+    size() const
+    { return 0; }
+    bool
+    is_plain(::std::size_t) const
+    { return true; }
+    void
+    write(::std::ostream&, ::std::size_t) const {}
+    bool
+    append(::std::string&, ::std::size_t, ::std::locale const&) const
+    { return true; }
+    int
+    domain_id(::std::locale const&) const
+    { return 0; }
+};
+
+prerendered_messages::locale_list
+registry_locales(catalog_registry const& registry)
+{
+    prerendered_messages::locale_list locales;
+    for (auto const& name : registry.locales()) {
+        locales.push_back(registry.get(name));
+    }
+    return locales;
+}
+
+}  /* namespace  */
+
+constexpr prerendered_messages::size_type prerendered_messages::npos;
+
+prerendered_messages::prerendered_messages(message_table const& table,
+        locale_list const& locales)
+    : table_{&table}
+{
+    render(locales);
+}
+
+prerendered_messages::prerendered_messages(message_table const& table,
+        catalog_registry const& registry)
+    : table_{&table}
+{
+    render(registry_locales(registry));
+}
+
+void
+prerendered_messages::render(locale_list const& locales)
+{
+    auto const& table = *table_;
+    rendered_.resize(table.size(), false);
+    for (::std::size_t i = 0; i < table.size(); ++i) {
+        rendered_[i] = !table[i].plural &&
+                extract_placeholders(table[i].id).empty();
+    }
+    auto& cache = translation_cache::instance();
+    locales_ = locales;
+    catalogs_.reserve(locales.size());
+    strings_.resize(locales.size() * table.size());
+    auto out = strings_.begin();
+    for (auto const& loc : locales) {
+        catalogs_.push_back(catalog_of(loc));
+        for (::std::size_t i = 0; i < table.size(); ++i, ++out) {
+            if (!rendered_[i])
+                continue;
+            // The same as message::str renders a message without arguments
+            cache.get_template(loc, table.text(i), 0)->render(
+                    *out, no_arguments{}, loc);
+        }
+    }
+}
+
+prerendered_messages::size_type
+prerendered_messages::locale_index(::std::locale const& loc) const
+{
+    // Copies of a locale share the implementation, the comparison is a
+    // pointer comparison for them
+    for (size_type i = 0; i < locales_.size(); ++i) {
+        if (locales_[i] == loc)
+            return i;
+    }
+    auto catalog = catalog_of(loc);
+    for (size_type i = 0; i < catalogs_.size(); ++i) {
+        if (catalogs_[i] == catalog)
+            return i;
+    }
+    return npos;
+}
+
+::std::string const&
+prerendered_messages::str(message_id const& id, ::std::locale const& loc) const
+{
+    auto str = find(id, loc);
+    if (!str)
+        throw ::std::out_of_range{
+            "Message '" + ::std::string{id.entry().id} +
+            "' is not rendered in advance to the locale" };
+    return *str;
+}
+
+}  /* namespace l10n */
+}  /* namespace psst */
@@ -0,0 +1,517 @@
+/*
+ * translation_cache.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: zmij
+ */
+
+#include <pushkin/l10n/translation_cache.hpp>
+#include "format_context.hpp"
+#include "intern_pool.hpp"
+
+#include <atomic>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace psst {
+namespace l10n {
+
+namespace {
+
+using message_format    = ::boost::locale::message_format<char>;
+using message_type      = message::message_type;
+
+struct translation_key {
+    message_format const*   facet;
+    int                     domain_id;
+    detail::message_text    text;
+    // Plural number or form, see get_template
+    int                     n;
+
+    bool
+    operator == (translation_key const& rhs) const
+    {
+        return facet == rhs.facet && domain_id == rhs.domain_id &&
+                text == rhs.text && n == rhs.n;
+    }
+};
+
+struct translation_key_hash {
+    ::std::size_t
+    operator()(translation_key const& key) const
+    {
+        auto h = ::std::hash<void const*>{}(key.facet);
+        h = detail::hash_combine(h, ::std::hash<int>{}(key.domain_id));
+        h = detail::hash_combine(h, key.text.hash());
+        h = detail::hash_combine(h, ::std::hash<int>{}(key.n));
+        return h;
+    }
+};
+
+bool
+is_plural(detail::message_text const& text)
+{
+    return !text.plural().is_null();
+}
+
+/**
+ * Cached template with the locale it was translated for. Cached values
+ * point into the holder, so the facet used in the cache key stays alive
+ * while the template is cached or used, and it's address cannot be
+ * taken by a facet of another locale.
+ */
+struct translated_template {
+    ::std::locale   loc;
+    format_template tmpl;
+
+    translated_template(::std::locale const& l, interned_string const& str)
+        : loc{l}, tmpl{str} {}
+};
+
+format_template_ptr
+make_template(::std::locale const& loc, interned_string const& str)
+{
+    auto holder = ::std::make_shared<translated_template>(loc, str);
+    return format_template_ptr{ holder, &holder->tmpl };
+}
+
+/**
+ * Translations of a generated message table in a locale and domain,
+ * indexed by message id.
+ * A plural message has a template per plural form of the catalog,
+ * followed by the untranslated singular and plural. Plural messages are
+ * not stored for catalogs that are not mapped, as their plural rule is
+ * not known.
+ */
+class id_catalog {
+public:
+    struct slot {
+        ::std::size_t   first;
+        ::std::size_t   forms;
+        bool            plural;
+    };
+    using slots     = ::std::vector<slot>;
+    using templates = ::std::vector<format_template_ptr>;
+public:
+    id_catalog(::std::locale const& loc, mo_message_format const* mapped,
+            int domain_id)
+        : loc_{loc}, mapped_{mapped}, domain_id_{domain_id} {}
+
+    /**
+     * Get a template by message index
+     * @param idx
+     * @param n Plural number
+     * @return Pointer to the template, nullptr if the message is not stored
+     */
+    format_template_ptr const*
+    get(::std::size_t idx, int n) const
+    {
+        auto const& s = slots_[idx];
+        if (!s.plural)
+            return &templates_[s.first];
+        if (!mapped_)
+            return nullptr;
+        auto form = mapped_->plural_form(domain_id_, n);
+        if (form >= 0 && static_cast<::std::size_t>(form) < s.forms &&
+                templates_[s.first + form])
+            return &templates_[s.first + form];
+        return &templates_[s.first + s.forms + (n != 1)];
+    }
+
+    slots       slots_;
+    templates   templates_;
+private:
+    // Keeps the facet used in the catalog key alive
+    ::std::locale               loc_;
+    mo_message_format const*    mapped_;
+    int                         domain_id_;
+};
+
+using id_catalog_ptr = ::std::shared_ptr<id_catalog const>;
+
+struct id_catalog_key {
+    message_format const*   facet;
+    message_table const*    table;
+    // Domain id requested by caller, can be message_domain
+    int                     domain_id;
+
+    bool
+    operator == (id_catalog_key const& rhs) const
+    {
+        return facet == rhs.facet && table == rhs.table &&
+                domain_id == rhs.domain_id;
+    }
+};
+
+struct id_catalog_key_hash {
+    ::std::size_t
+    operator()(id_catalog_key const& key) const
+    {
+        auto h = ::std::hash<void const*>{}(key.facet);
+        h = detail::hash_combine(h, ::std::hash<void const*>{}(key.table));
+        h = detail::hash_combine(h, ::std::hash<int>{}(key.domain_id));
+        return h;
+    }
+};
+
+/**
+ * Generations of id catalogs. A cache takes a new generation when it is
+ * constructed or cleared, so that catalogs remembered by threads are
+ * not used after that.
+ */
+::std::atomic<::std::size_t> id_generations{0};
+
+::std::size_t const id_memo_size = 8;
+
+/**
+ * Id catalogs recently used by a thread. The catalogs keep their locales
+ * alive, so the memo is released with other thread caches of locales.
+ */
+struct id_catalog_memo : detail::thread_locale_cache {
+    struct entry {
+        ::std::size_t   generation;
+        id_catalog_key  key;
+        id_catalog_ptr  catalog;
+    };
+
+    ::std::vector<entry>    entries;
+    ::std::size_t           next = 0;
+
+    id_catalog const*
+    find(::std::size_t generation, id_catalog_key const& key) const
+    {
+        for (auto const& e : entries) {
+            if (e.generation == generation && e.key == key)
+                return e.catalog.get();
+        }
+        return nullptr;
+    }
+
+    void
+    add(::std::size_t generation, id_catalog_key const& key,
+            id_catalog_ptr const& catalog)
+    {
+        if (entries.size() < id_memo_size) {
+            entries.push_back(entry{ generation, key, catalog });
+        } else {
+            entries[next] = entry{ generation, key, catalog };
+            next = (next + 1) % id_memo_size;
+        }
+    }
+
+    void
+    release_locales() override
+    {
+        entries.clear();
+        next = 0;
+    }
+};
+
+id_catalog_memo&
+id_memo()
+{
+    static thread_local id_catalog_memo memo;
+    return memo;
+}
+
+}  /* namespace  */
+
+struct translation_cache::impl {
+    using cache_type = lru_cache<translation_key, format_template_ptr,
+            translation_key_hash>;
+    using mutex_type = ::std::mutex;
+    using lock_type  = ::std::lock_guard<mutex_type>;
+    using id_catalogs = ::std::unordered_map<id_catalog_key, id_catalog_ptr,
+            id_catalog_key_hash>;
+
+    // Cached values keep the facets used as keys alive, see
+    // translated_template
+    cache_type  cache;
+
+    mutex_type                      ids_mtx;
+    id_catalogs                     ids;
+    ::std::atomic<::std::size_t>    ids_generation;
+
+    explicit
+    impl(::std::size_t capacity)
+        : cache{capacity}, ids_generation{++id_generations} {}
+
+    interned_string
+    translate(detail::locale_info const& info,
+            detail::message_text const& text, int n, int domain_id)
+    {
+        auto facet = info.catalog;
+        if (domain_id == message_domain) {
+            domain_id = 0;
+            if (facet && !text.domain().is_null())
+                domain_id = facet->domain(text.domain().str());
+        }
+        auto const& id = text.id().str();
+        // No context is passed as null, as ::boost::locale::message does,
+        // an empty context doesn't match messages without context
+        char const* context = text.context().empty() ?
+                nullptr : text.context().str().c_str();
+        char const* translated = nullptr;
+        if (facet) {
+            if (is_plural(text) && info.mapped) {
+                translated = info.mapped->get_form(domain_id, context, id.c_str(),
+                        info.mapped->plural_form(domain_id, n));
+            } else if (is_plural(text)) {
+                translated = facet->get(domain_id, context, id.c_str(), n);
+            } else {
+                translated = facet->get(domain_id, context, id.c_str());
+            }
+        }
+        if (translated)
+            return interned_string{translated};
+        // Not translated, fallback to the original strings
+        auto const& msg = (is_plural(text) && n != 1) ? text.plural() : text.id();
+        if (facet) {
+            ::std::string buffer;
+            auto converted = facet->convert(msg.str().c_str(), buffer);
+            if (converted != msg.str().c_str())
+                return interned_string{converted};
+        }
+        return msg;
+    }
+
+    /**
+     * Find translation of a message of a generated table in the table's
+     * catalog for the locale, build the catalog if there is none.
+     * @return The template, nullptr if the catalog doesn't store
+     *         the message
+     */
+    format_template_ptr
+    find_by_id(::std::locale const& loc, detail::locale_info const& info,
+            detail::message_text const& text, int n, int domain_id)
+    {
+        id_catalog_key key{ info.catalog, text.table(), domain_id };
+        auto generation = ids_generation.load(::std::memory_order_acquire);
+        auto& memo = id_memo();
+        {
+            // The memo can be released by another thread, the template
+            // is copied under the lock
+            ::std::lock_guard<detail::thread_locale_cache> lock{memo};
+            if (auto catalog = memo.find(generation, key))
+                return find_template(*catalog, text.index(), n);
+        }
+        id_catalog_ptr ptr;
+        {
+            lock_type lock{ids_mtx};
+            auto f = ids.find(key);
+            if (f == ids.end()) {
+                f = ids.emplace(key, build_catalog(loc, info,
+                        *text.table(), domain_id)).first;
+            }
+            ptr = f->second;
+        }
+        {
+            ::std::lock_guard<detail::thread_locale_cache> lock{memo};
+            memo.add(generation, key, ptr);
+        }
+        return find_template(*ptr, text.index(), n);
+    }
+
+    static format_template_ptr
+    find_template(id_catalog const& catalog, ::std::size_t index, int n)
+    {
+        auto tmpl = catalog.get(index, n);
+        return tmpl ? *tmpl : format_template_ptr{};
+    }
+
+    /**
+     * Translate all messages of a generated table
+     */
+    id_catalog_ptr
+    build_catalog(::std::locale const& loc, detail::locale_info const& info,
+            message_table const& table, int domain_id)
+    {
+        if (domain_id == message_domain)
+            domain_id = table.domain() ? info.catalog->domain(table.domain()) : 0;
+        auto catalog = ::std::make_shared<id_catalog>(loc, info.mapped,
+                domain_id);
+        catalog->slots_.reserve(table.size());
+        catalog->templates_.reserve(table.size());
+        for (::std::size_t i = 0; i < table.size(); ++i) {
+            auto const& text = table.text(i);
+            id_catalog::slot s{ catalog->templates_.size(), 0, is_plural(text) };
+            if (!s.plural) {
+                catalog->templates_.push_back(::std::make_shared<format_template>(
+                        translate(info, text, 0, domain_id)));
+            } else if (info.mapped) {
+                auto const& entry = table[i];
+                s.forms = info.mapped->plural_count(domain_id);
+                for (::std::size_t f = 0; f < s.forms; ++f) {
+                    auto translated = info.mapped->get_form(domain_id,
+                            entry.context, entry.id, static_cast<long>(f));
+                    catalog->templates_.push_back(translated ?
+                            ::std::make_shared<format_template>(
+                                    interned_string{translated}) :
+                            format_template_ptr{});
+                }
+                catalog->templates_.push_back(
+                        ::std::make_shared<format_template>(text.id()));
+                catalog->templates_.push_back(
+                        ::std::make_shared<format_template>(text.plural()));
+            }
+            catalog->slots_.push_back(s);
+        }
+        return catalog;
+    }
+
+    void
+    clear_ids()
+    {
+        lock_type lock{ids_mtx};
+        ids.clear();
+        ids_generation.store(++id_generations, ::std::memory_order_release);
+    }
+    void
+    release_ids(message_format const* facet)
+    {
+        lock_type lock{ids_mtx};
+        bool erased = false;
+        for (auto c = ids.begin(); c != ids.end();) {
+            if (c->first.facet == facet) {
+                c = ids.erase(c);
+                erased = true;
+            } else {
+                ++c;
+            }
+        }
+        // Catalogs remembered by threads are looked up again
+        if (erased)
+            ids_generation.store(++id_generations, ::std::memory_order_release);
+    }
+};
+
+translation_cache::translation_cache(::std::size_t capacity)
+    : pimpl_{ new impl{capacity} }
+{
+}
+
+translation_cache::~translation_cache() = default;
+
+translation_cache&
+translation_cache::instance()
+{
+    // Never destroyed, messages can be rendered by static objects' destructors
+    static translation_cache* cache = new translation_cache{};
+    return *cache;
+}
+
+interned_string
+translation_cache::translate(::std::locale const& loc,
+        detail::message_text const& text, int n, int domain_id)
+{
+    return get_template(loc, text, n, domain_id)->str();
+}
+
+format_template_ptr
+translation_cache::get_template(::std::locale const& loc,
+        detail::message_text const& text, int n, int domain_id)
+{
+    if (text.type() == static_cast<int>(message_type::empty) || text.id().empty()) {
+        static format_template_ptr const empty =
+                ::std::make_shared<format_template>(interned_string{});
+        return empty;
+    }
+    auto const info = detail::get_locale_info(loc);
+    if (text.table() && info.catalog) {
+        // Message of a generated table, index the table's catalog
+        if (auto tmpl = pimpl_->find_by_id(loc, info, text, n, domain_id))
+            return tmpl;
+    }
+    // The domain name is resolved to an id only when the translation is
+    // not cached yet
+    if (domain_id == message_domain && text.domain().is_null())
+        domain_id = 0;
+    // Number or plural form the translation depends on
+    int plural_key = 0;
+    if (is_plural(text)) {
+        plural_key = n;
+        if (info.mapped) {
+            // The plural rule of mapped catalogs is known, so the
+            // translation is cached per form. Number 1 is distinguished
+            // for the untranslated fallback.
+            if (domain_id == message_domain)
+                domain_id = info.mapped->domain(text.domain().str());
+            plural_key = static_cast<int>(
+                    info.mapped->plural_form(domain_id, n) * 2 + (n != 1));
+        }
+    }
+    if (!info.catalog) {
+        // Without a catalog the message is not translated, the template
+        // doesn't depend on the locale and only singular and plural
+        // are distinguished
+        translation_key key{ nullptr, 0, text, is_plural(text) && n != 1 };
+        return pimpl_->cache.get(key, [&]()
+        {
+            return ::std::make_shared<format_template>(
+                    pimpl_->translate(info, text, n, domain_id));
+        });
+    }
+
+    translation_key key{ info.catalog, domain_id, text, plural_key };
+    return pimpl_->cache.get(key, [&]()
+    {
+        return make_template(loc, pimpl_->translate(info, text, n, domain_id));
+    });
+}
+
+int
+translation_cache::domain_id(::std::locale const& loc, interned_string const& domain)
+{
+    if (domain.is_null())
+        return 0;
+    auto facet = detail::get_locale_info(loc).catalog;
+    return facet ? facet->domain(domain.str()) : 0;
+}
+
+::std::size_t
+translation_cache::capacity() const
+{
+    return pimpl_->cache.capacity();
+}
+
+void
+translation_cache::set_capacity(::std::size_t capacity)
+{
+    pimpl_->cache.set_capacity(capacity);
+}
+
+void
+translation_cache::release(::std::locale const& loc)
+{
+    if (!::std::has_facet<message_format>(loc))
+        return;
+    auto facet = &::std::use_facet<message_format>(loc);
+    pimpl_->cache.erase_if([facet](translation_key const& key)
+    {
+        return key.facet == facet;
+    });
+    pimpl_->release_ids(facet);
+}
+
+void
+translation_cache::clear()
+{
+    pimpl_->cache.clear();
+    pimpl_->clear_ids();
+}
+
+cache_stats
+translation_cache::stats() const
+{
+    return pimpl_->cache.stats();
+}
+
+void
+translation_cache::reset_stats()
+{
+    pimpl_->cache.reset_stats();
+}
+
+}  /* namespace l10n */
+}  /* namespace psst */
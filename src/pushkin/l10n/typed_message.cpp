@@ -0,0 +1,79 @@
+/*
+ * typed_message.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: zmij
+ */
+
+#include <pushkin/l10n/typed_message.hpp>
+#include "intern_pool.hpp"
+
+#include <functional>
+#include <unordered_map>
+
+namespace psst {
+namespace l10n {
+namespace detail {
+
+namespace {
+
+/**
+ * Addresses of static strings of a message
+ */
+struct static_text_key {
+    int         type;
+    char const* context;
+    char const* id;
+    char const* plural;
+    char const* domain;
+
+    bool
+    operator == (static_text_key const& rhs) const
+    {
+        return type == rhs.type && context == rhs.context && id == rhs.id &&
+                plural == rhs.plural && domain == rhs.domain;
+    }
+};
+
+struct static_text_hash {
+    ::std::size_t
+    operator()(static_text_key const& key) const
+    {
+        ::std::hash<char const*> hash;
+        auto h = hash_combine(::std::hash<int>{}(key.type), hash(key.id));
+        h = hash_combine(h, hash(key.context));
+        h = hash_combine(h, hash(key.plural));
+        return hash_combine(h, hash(key.domain));
+    }
+};
+
+interned_string
+intern(char const* str)
+{
+    return str ? interned_string{str} : interned_string{};
+}
+
+}  /* namespace  */
+
+message_text const&
+static_message_text(int type, char const* context, char const* id,
+        char const* plural, char const* domain)
+{
+    // Texts are never removed, the count of messages with static strings
+    // is limited by the program
+    using text_map = ::std::unordered_map<static_text_key, message_text,
+            static_text_hash>;
+    static thread_local text_map texts;
+    static_text_key key{ type, context, id, plural, domain };
+    auto f = texts.find(key);
+    if (f == texts.end()) {
+        auto msgid = intern(id);
+        f = texts.emplace(key, message_text{ type, msgid, msgid,
+                intern(context), intern(plural), intern(domain) }).first;
+    }
+    return f->second;
+}
+
+}  /* namespace detail */
+}  /* namespace l10n */
+}  /* namespace psst */
@@ -31,6 +31,38 @@ TEST(Args, Copy)
     EXPECT_EQ(3, copy.size()) << "Correct arguments size";
 }
 
+TEST(Args, SharedCopy)
+{
+    detail::message_args args;
+    EXPECT_NO_THROW(args << 10 << "Foo" << "Bar") << "Add argument";
+    EXPECT_FALSE(args.shared()) << "Arguments are not shared";
+    detail::message_args copy = args;
+    EXPECT_TRUE(args.shared()) << "Arguments are shared after copy";
+    EXPECT_EQ(args.begin(), copy.begin()) << "Copy refers to the same arguments";
+
+    EXPECT_NO_THROW(copy << 42) << "Add argument to the copy";
+    EXPECT_FALSE(args.shared()) << "Arguments are detached on modification";
+    EXPECT_FALSE(copy.shared()) << "Arguments are detached on modification";
+    EXPECT_NE(args.begin(), copy.begin()) << "Copy is detached";
+    EXPECT_EQ(3, args.size()) << "Source arguments are not modified";
+    EXPECT_EQ(4, copy.size()) << "Correct arguments size";
+}
+
+TEST(Args, ReleasedCopy)
+{
+    detail::message_args args;
+    args << 10 << "Foo";
+    auto list = args.begin();
+    {
+        detail::message_args copy = args;
+        EXPECT_TRUE(args.shared()) << "Arguments are shared with the copy";
+    }
+    EXPECT_FALSE(args.shared()) << "Arguments are not shared after the copy is destroyed";
+    args << 42;
+    EXPECT_EQ(list, args.begin()) << "Unshared arguments are not cloned";
+    EXPECT_EQ(3, args.size());
+}
+
 TEST(Args, Move)
 {
     detail::message_args args;
@@ -42,6 +74,67 @@ TEST(Args, Move)
     EXPECT_EQ(3, copy.size()) << "Correct arguments size";
 }
 
+TEST(Args, InlineStorage)
+{
+    detail::message_args args;
+    EXPECT_NO_THROW(args << 10 << "Foo" << 3.14) << "Add argument";
+    for (auto const& arg : args) {
+        EXPECT_TRUE(arg.is_inline()) << "Small argument is stored in place";
+    }
+    EXPECT_NO_THROW(args << message{"{1}"}) << "Add a nested message";
+    EXPECT_FALSE((args.end() - 1)->is_inline()) << "Big argument is on heap";
+}
+
+struct user_value {
+    int value;
+};
+
+::std::ostream&
+operator << (::std::ostream& os, user_value const& v)
+{
+    return os << "<" << v.value << ">";
+}
+
+TEST(Args, BuiltinTypes)
+{
+    using kind = detail::arg_holder::kind_type;
+    detail::message_args args;
+    EXPECT_NO_THROW(args << 1 << 2L << 3.5 << "four" << message{"five"}
+            << user_value{6}) << "Add arguments";
+    ASSERT_EQ(6, args.size()) << "Correct arguments size";
+    auto arg = args.begin();
+    EXPECT_EQ(kind::int_value, (arg++)->kind());
+    EXPECT_EQ(kind::long_value, (arg++)->kind());
+    EXPECT_EQ(kind::double_value, (arg++)->kind());
+    EXPECT_EQ(kind::string_value, (arg++)->kind());
+    EXPECT_EQ(kind::message_value, (arg++)->kind());
+    EXPECT_EQ(kind::erased_value, (arg++)->kind());
+
+    detail::message_args copy = args;
+    format fmt{message::localized_message{"{1} {2} {3} {4} {5} {6}"}};
+    fmt % copy;
+    EXPECT_EQ("1 2 3.5 four five <6>", fmt.str()) << "Correct formatted message";
+}
+
+TEST(Args, Spill)
+{
+    message::localized_message fmt_str{"{1}{2}{3}{4}{5}{6}"};
+    detail::message_args args;
+    EXPECT_NO_THROW(args << 1 << 2 << "3" << 4 << "5" << 6) << "Add argument";
+    EXPECT_EQ(6, args.size()) << "Correct arguments size";
+    detail::message_args copy = args;
+    EXPECT_EQ(6, copy.size()) << "Correct arguments size";
+    detail::message_args moved = ::std::move(copy);
+    EXPECT_TRUE(copy.empty()) << "Source arguments are empty";
+    EXPECT_EQ(6, moved.size()) << "Correct arguments size";
+    moved.swap(args);
+    EXPECT_EQ(6, args.size()) << "Correct arguments size";
+
+    format fmt{fmt_str};
+    fmt % moved;
+    EXPECT_EQ("123456", fmt.str()) << "Correct formatted message";
+}
+
 TEST(Args, Format)
 {
     message::localized_message fmt_str{"{3}{2}={1}"};
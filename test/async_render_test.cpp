@@ -0,0 +1,133 @@
+/*
+ * async_render_test.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: zmij
+ */
+
+#include <gtest/gtest.h>
+#include <pushkin/l10n/async_render.hpp>
+
+#include <deque>
+#include <thread>
+
+namespace psst {
+namespace l10n {
+namespace test {
+
+namespace {
+
+/**
+ * Executor queueing tasks until they are run by the test
+ */
+struct queue_executor {
+    using task_type = ::std::function<void()>;
+    ::std::deque<task_type> tasks;
+
+    executor
+    get()
+    {
+        return [this](task_type task) { tasks.push_back(::std::move(task)); };
+    }
+    void
+    run_all()
+    {
+        while (!tasks.empty()) {
+            auto task = ::std::move(tasks.front());
+            tasks.pop_front();
+            task();
+        }
+    }
+};
+
+message
+make_nested()
+{
+    message files{"{1} file", "{1} files", 3};
+    message folder{"Folder {1} has {2}"};
+    folder << "Documents" << files;
+    message msg{"{1}: {2}, {3}"};
+    msg << "Bob" << folder << 42;
+    return msg;
+}
+
+}  /* namespace  */
+
+TEST(AsyncRender, Queue)
+{
+    auto msg = make_nested();
+    queue_executor exec;
+    auto handle = render_async(msg, ::std::locale::classic(), exec.get());
+    EXPECT_TRUE(handle.valid());
+    EXPECT_FALSE(handle.ready());
+    EXPECT_EQ(1, exec.tasks.size());
+    exec.run_all();
+    EXPECT_TRUE(handle.ready());
+    EXPECT_FALSE(handle.cancel());
+    EXPECT_FALSE(handle.cancelled());
+    EXPECT_EQ(msg.str(::std::locale::classic()), handle.get());
+    EXPECT_FALSE(handle.valid());
+}
+
+TEST(AsyncRender, Inline)
+{
+    auto msg = make_nested();
+    auto handle = render_async(msg, ::std::locale::classic(),
+            [](::std::function<void()> task) { task(); });
+    EXPECT_TRUE(handle.ready());
+    EXPECT_EQ(msg.str(::std::locale::classic()), handle.get());
+}
+
+TEST(AsyncRender, Thread)
+{
+    ::boost::locale::generator gen;
+    auto loc = gen("en_US.UTF-8");
+    auto msg = make_nested();
+    ::std::thread worker;
+    auto handle = render_async(msg, loc,
+        [&](::std::function<void()> task)
+        {
+            worker = ::std::thread{::std::move(task)};
+        });
+    EXPECT_EQ(msg.str(loc), handle.get());
+    worker.join();
+}
+
+TEST(AsyncRender, Cancel)
+{
+    queue_executor exec;
+    auto handle = render_async(make_nested(), ::std::locale::classic(),
+            exec.get());
+    EXPECT_TRUE(handle.cancel());
+    EXPECT_TRUE(handle.cancelled());
+    EXPECT_FALSE(handle.cancel());
+    EXPECT_TRUE(handle.ready());
+    exec.run_all();
+    EXPECT_THROW(handle.get(), render_cancelled);
+
+    EXPECT_FALSE(render_handle{}.cancel());
+    EXPECT_FALSE(render_handle{}.valid());
+}
+
+TEST(AsyncRender, Dropped)
+{
+    queue_executor exec;
+    auto handle = render_async(make_nested(), ::std::locale::classic(),
+            exec.get());
+    exec.tasks.clear();
+    EXPECT_TRUE(handle.ready());
+    EXPECT_TRUE(handle.cancelled());
+    EXPECT_THROW(handle.get(), render_cancelled);
+
+    handle = render_async(make_nested(), ::std::locale::classic(),
+            [](::std::function<void()>) {
+                throw ::std::runtime_error{"Executor is stopped"};
+            });
+    EXPECT_TRUE(handle.ready());
+    EXPECT_FALSE(handle.cancelled());
+    EXPECT_THROW(handle.get(), ::std::runtime_error);
+}
+
+}  /* namespace test */
+}  /* namespace l10n */
+}  /* namespace psst */
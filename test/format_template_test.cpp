@@ -0,0 +1,132 @@
+/*
+ * format_template_test.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: zmij
+ */
+
+#include <gtest/gtest.h>
+#include <pushkin/l10n/format_template.hpp>
+#include <pushkin/l10n/message.hpp>
+
+#include <sstream>
+
+namespace psst {
+namespace l10n {
+namespace test {
+
+namespace {
+
+struct holder_arguments : format_template::arguments {
+    ::std::vector<detail::arg_holder> args;
+
+    ::std::size_t
+    size() const override
+    { return args.size(); }
+    bool
+    is_plain(::std::size_t idx) const override
+    { return args[idx].is_plain(); }
+    void
+    write(::std::ostream& os, ::std::size_t idx) const override
+    { args[idx].write(os); }
+};
+
+::std::string
+render(::std::string const& str, ::std::locale const& loc)
+{
+    format_template tmpl{ interned_string{str} };
+    holder_arguments args;
+    args.args.emplace_back(42);
+    args.args.emplace_back("str");
+    args.args.emplace_back(3.5);
+    args.args.emplace_back(1234567l);
+    ::std::ostringstream os;
+    os.imbue(loc);
+    tmpl.write(os, args);
+    return os.str();
+}
+
+::std::string
+boost_render(::std::string const& str, ::std::locale const& loc)
+{
+    // boost format keeps pointers to the values
+    int i = 42;
+    ::std::string s = "str";
+    double d = 3.5;
+    long l = 1234567;
+    ::boost::locale::format fmt{str};
+    fmt % i % s % d % l;
+    return fmt.str(loc);
+}
+
+}  /* namespace  */
+
+TEST(FormatTemplate, Segments)
+{
+    format_template tmpl{ interned_string{"a {1} b {{c}} {2,num} d"} };
+    auto const& segs = tmpl.get_segments();
+    ASSERT_EQ(5, segs.size());
+    EXPECT_TRUE(tmpl.has_slots());
+    EXPECT_TRUE(segs[0].has_slot);
+    EXPECT_EQ(0, segs[0].argument);
+    EXPECT_GT(0, segs[0].options);
+    EXPECT_FALSE(segs[1].has_slot) << "Escaped braces are literal";
+    EXPECT_FALSE(segs[2].has_slot) << "Escaped braces are literal";
+    EXPECT_TRUE(segs[3].has_slot);
+    EXPECT_EQ(1, segs[3].argument);
+    ASSERT_LE(0, segs[3].options);
+    EXPECT_EQ("num", tmpl.get_options(segs[3]).front().key);
+    EXPECT_FALSE(segs.back().has_slot);
+
+    format_template plain{ interned_string{"no placeholders"} };
+    EXPECT_FALSE(plain.has_slots());
+    ASSERT_EQ(1, plain.get_segments().size());
+}
+
+TEST(FormatTemplate, SameAsBoostFormat)
+{
+    ::boost::locale::generator gen;
+    ::std::locale locales[] { ::std::locale::classic(), gen("en_US.UTF-8") };
+    char const* formats[] {
+        "",
+        "text",
+        "{1}",
+        "{1} {2} {3} {4}",
+        "{4}{3}{2}{1}",
+        "{{1}} {1}}}",
+        "}{1}}{",
+        "{1,num} {4,num} {3,number}",
+        "{1,w=6} [{2,width=5,left}] {3,p=3}",
+        "{1,hex} {1,oct} {1}",
+        "{3,ftime='%H''%M'}",
+        "{0} {5} {}",
+        "{num,2}",
+        "{1='x'}",
+        "{1",
+        "text {2,num",
+        "{1,w=3",
+        "{",
+        "}",
+        "{{",
+    };
+    for (auto const& loc : locales) {
+        for (auto f : formats) {
+            EXPECT_EQ(boost_render(f, loc), render(f, loc))
+                    << "Format string '" << f << "'";
+        }
+    }
+}
+
+TEST(FormatTemplate, MessageFormat)
+{
+    message msg{"{1}, {2,w=4}, {3}"};
+    msg << 1 << 2 << message{"nested {1}"};
+    EXPECT_EQ("1,    2, nested {1}", msg.str());
+    EXPECT_EQ("1,    2, nested {1}!",
+            (msg.format() % "ignored").str() + "!")
+        << "Extra arguments are ignored";
+}
+
+}  /* namespace test */
+}  /* namespace l10n */
+}  /* namespace psst */
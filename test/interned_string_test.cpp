@@ -0,0 +1,85 @@
+/*
+ * interned_string_test.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: zmij
+ */
+
+#include <gtest/gtest.h>
+#include <pushkin/l10n/interned_string.hpp>
+#include <pushkin/l10n/message.hpp>
+
+#include <thread>
+#include <vector>
+
+namespace psst {
+namespace l10n {
+namespace test {
+
+TEST(InternedString, Null)
+{
+    interned_string null;
+    interned_string empty{""};
+    EXPECT_TRUE(null.is_null());
+    EXPECT_FALSE(empty.is_null());
+    EXPECT_TRUE(null.empty());
+    EXPECT_TRUE(empty.empty());
+    EXPECT_NE(null, empty) << "Null handle is not equal to an empty string";
+    EXPECT_LT(null, empty) << "Null handle is less than an empty string";
+}
+
+TEST(InternedString, Share)
+{
+    auto pool_size = interned_string::pool_size();
+    {
+        interned_string a{"interned test string"};
+        interned_string b{::std::string{"interned test string"}};
+        interned_string c{"another interned test string"};
+        EXPECT_EQ(a, b) << "Equal strings are equal";
+        EXPECT_EQ(&a.str(), &b.str()) << "Equal strings share the entry";
+        EXPECT_NE(a, c) << "Different strings are not equal";
+        EXPECT_EQ(a.hash(), ::std::hash<::std::string>{}(a.str()));
+        EXPECT_EQ(pool_size + 2, interned_string::pool_size());
+
+        interned_string copy{a};
+        EXPECT_EQ(a, copy);
+        interned_string moved{::std::move(copy)};
+        EXPECT_TRUE(copy.is_null());
+        EXPECT_EQ(a, moved);
+    }
+    EXPECT_EQ(pool_size, interned_string::pool_size())
+            << "Strings are released with the last handle";
+}
+
+TEST(InternedString, Concurrent)
+{
+    auto pool_size = interned_string::pool_size();
+    ::std::vector<::std::thread> threads;
+    for (auto t = 0; t < 4; ++t) {
+        threads.emplace_back([]()
+        {
+            for (auto i = 0; i < 10000; ++i) {
+                interned_string s{ "concurrent " + ::std::to_string(i % 10) };
+                interned_string copy{s};
+                EXPECT_EQ(s, copy);
+            }
+        });
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+    EXPECT_EQ(pool_size, interned_string::pool_size());
+}
+
+TEST(InternedString, MessageStrings)
+{
+    message a{"context", "message id"};
+    message b{"context", "message id"};
+    EXPECT_EQ(&a.id(), &b.id()) << "Messages share id string";
+    EXPECT_EQ(&a.id(), &a.msgstr()) << "Message id and str share storage";
+    EXPECT_EQ(&a.context(), &b.context()) << "Messages share context string";
+}
+
+}  /* namespace test */
+}  /* namespace l10n */
+}  /* namespace psst */
@@ -0,0 +1,94 @@
+/*
+ * message_batch_test.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: zmij
+ */
+
+#include <gtest/gtest.h>
+#include <pushkin/l10n/message_batch.hpp>
+#include "l10ntest_ids.hpp"
+
+#include <ostream>
+
+namespace psst {
+namespace l10n {
+namespace test {
+
+namespace {
+
+struct coords {
+    int x, y;
+};
+
+::std::ostream&
+operator << (::std::ostream& os, coords const& v)
+{
+    return os << "(" << v.x << ", " << v.y << ")";
+}
+
+}  /* namespace  */
+
+TEST(MessageBatch, Render)
+{
+    ::boost::locale::generator gen;
+    message nested{"nested {1} {2,num}"};
+    nested << -42 << 10000;
+    message user{"at {1}"};
+    user << coords{1, 2};
+    message all{"{1} {2} {3} {4} {5} {6,w=6}"};
+    all << 1 << 20000l << 1234.5 << "str" << nested << 42;
+    message domain{"{1}", message::domain_type{"other"}};
+    domain << nested;
+    message id_msg{ids::simple_format_message_1};
+    id_msg << 7;
+
+    message_list messages {
+        message{"{{raw}}"}, nested, user, all, domain, message{},
+        message{ids::simple_message}, id_msg
+    };
+    for (int n = 0; n < 5; ++n) {
+        messages.emplace_back("{1} apple", "{1} apples", n);
+        messages.emplace_back(ids::msg_1_apple, n);
+        messages.push_back(all);
+    }
+
+    for (auto const& loc : { ::std::locale::classic(), gen("en_US.UTF-8"),
+            gen("de_DE.UTF-8") }) {
+        auto batch = render_batch(messages, loc);
+        ASSERT_EQ(messages.size(), batch.size());
+        ASSERT_EQ(messages.size() + 1, batch.offsets().size());
+        EXPECT_EQ(0, batch.offset(0));
+        EXPECT_EQ(batch.data().size(), batch.offsets().back());
+        for (::std::size_t i = 0; i < messages.size(); ++i) {
+            EXPECT_EQ(messages[i].str(loc), batch.str(i))
+                    << "Render '" << messages[i].id() << "' at " << i;
+            EXPECT_EQ(batch.length(i), batch.str(i).size());
+        }
+    }
+}
+
+TEST(MessageBatch, Append)
+{
+    message_list first { message{"one"}, message{"two"} };
+    message_list second { message{"three"} };
+    rendered_batch batch;
+    EXPECT_TRUE(batch.empty());
+    render_batch(first, ::std::locale::classic(), batch);
+    render_batch(message_list{}, ::std::locale::classic(), batch);
+    render_batch(second, ::std::locale::classic(), batch);
+    ASSERT_EQ(3, batch.size());
+    EXPECT_EQ("onetwothree", batch.data());
+    EXPECT_EQ("two", batch.str(1));
+    EXPECT_EQ("three", ::std::string(batch.begin(2), batch.end(2)));
+
+    batch.clear();
+    EXPECT_TRUE(batch.empty());
+    render_batch(second, ::std::locale::classic(), batch);
+    ASSERT_EQ(1, batch.size());
+    EXPECT_EQ("three", batch.str(0));
+}
+
+}  /* namespace test */
+}  /* namespace l10n */
+}  /* namespace psst */
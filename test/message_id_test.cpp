@@ -0,0 +1,65 @@
+/*
+ * message_id_test.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: zmij
+ */
+
+#include <gtest/gtest.h>
+#include <pushkin/l10n/message.hpp>
+#include "l10ntest_ids.hpp"
+
+namespace psst {
+namespace l10n {
+namespace test {
+
+TEST(MessageId, Generated)
+{
+    static_assert(ids::count_ == 5, "Message count of l10ntest.pot");
+    static_assert(ids::open.value == 0 && ids::file_open.value == 1 &&
+            ids::msg_1_apple.value == 4, "Messages are numbered in order");
+    auto const& table = ids::table_();
+    EXPECT_EQ(ids::count_, table.size());
+    EXPECT_STREQ("l10ntest", table.domain());
+    EXPECT_STREQ("file", ids::file_open.entry().context);
+    EXPECT_STREQ("{1} apples", ids::msg_1_apple.entry().plural);
+    EXPECT_EQ(nullptr, ids::simple_message.entry().context);
+}
+
+TEST(MessageId, Construct)
+{
+    message::domain_type domain{"l10ntest"};
+    message msg{ids::simple_format_message_1};
+    EXPECT_EQ(message::message_type::simple, msg.type());
+    EXPECT_EQ("Simple format message: {1}", msg.id());
+    EXPECT_EQ("l10ntest", msg.domain());
+    EXPECT_EQ((message{"Simple format message: {1}", domain}), msg);
+
+    message ctx{ids::file_open};
+    EXPECT_EQ(message::message_type::context, ctx.type());
+    EXPECT_EQ((message{"file", "Open", domain}), ctx);
+    EXPECT_NE(message{ids::open}, ctx);
+
+    message plural{ids::msg_1_apple, 3};
+    EXPECT_EQ(message::message_type::plural, plural.type());
+    EXPECT_EQ(3, plural.get_n());
+    EXPECT_EQ((message{"{1} apple", "{1} apples", 3, domain}), plural);
+}
+
+TEST(MessageId, Render)
+{
+    ::boost::locale::generator gen;
+    auto loc = gen("en_US.UTF-8");
+    message msg{ids::simple_format_message_1};
+    msg << 42;
+    EXPECT_EQ("Simple format message: 42", msg.str(loc));
+    EXPECT_EQ("Simple message", message{ids::simple_message}.str(loc));
+    for (int n = 0; n < 5; ++n) {
+        message plural{ids::msg_1_apple, n};
+        EXPECT_EQ(message("{1} apple", "{1} apples", n).str(loc), plural.str(loc));
+    }
+}
+
+}  /* namespace test */
+}  /* namespace l10n */
+}  /* namespace psst */
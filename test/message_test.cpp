@@ -8,6 +8,11 @@
 #include <gtest/gtest.h>
 #include <pushkin/l10n/message.hpp>
 
+#include <iterator>
+#include <set>
+#include <sstream>
+#include <unordered_set>
+
 namespace psst {
 namespace l10n {
 namespace test {
@@ -72,6 +77,81 @@ TEST(Message, NestedMessage)
     EXPECT_EQ(expected, fmt.str());
 }
 
+TEST(Message, SharedText)
+{
+    auto texts = detail::message_text::pool_size();
+    {
+        message a{"ctx", "shared text"};
+        message b{"ctx", "shared text"};
+        message c{"shared text"};
+        EXPECT_EQ(texts + 2, detail::message_text::pool_size())
+                << "Equal messages share text";
+        b.set_plural(3);
+        EXPECT_EQ(message::message_type::context_plural, b.type());
+        EXPECT_EQ("shared text", b.plural());
+        EXPECT_FALSE(a.has_plural()) << "Modification doesn't affect other messages";
+        b.domain("domain");
+        EXPECT_EQ("domain", b.domain());
+        EXPECT_EQ("", a.domain());
+    }
+    EXPECT_EQ(texts, detail::message_text::pool_size())
+            << "Texts are released with the last message";
+}
+
+TEST(Message, MemoryUsage)
+{
+    EXPECT_GE(4 * sizeof(void*), sizeof(message)) << "Compact message";
+    EXPECT_EQ(sizeof(message), message{}.memory_usage());
+
+    message_list catalog(1000, message{"ctx", "a message in a catalog"});
+    ::std::size_t total = 0;
+    for (auto const& msg : catalog) {
+        total += msg.memory_usage();
+    }
+    EXPECT_GT(catalog.size() * sizeof(message) + 1024, total)
+            << "Shared text is accounted once";
+
+    message with_args{"{1} {2}"};
+    auto text_only = with_args.memory_usage();
+    with_args << 42 << ::std::string(100, 'x');
+    EXPECT_LT(text_only + 100, with_args.memory_usage())
+            << "Arguments are accounted";
+}
+
+TEST(Message, Compare)
+{
+    message simple{"apple"};
+    message simple_args{"apple"};
+    simple_args << 42;
+    message translated{message::id_str_pair{"apple", "manzana"}};
+    message ctx{"fruit", "apple"};
+    message plural{"apple", "apples", 3};
+    message plural_n{"apple", "many apples", 5};
+    message domain{"apple", message::domain_type{"fruits"}};
+
+    EXPECT_EQ(simple, simple_args) << "Arguments are not taken into account";
+    EXPECT_EQ(simple, translated) << "Translated string is not taken into account";
+    EXPECT_EQ(plural, plural_n) << "Plural form is not taken into account";
+    EXPECT_NE(simple, ctx) << "Context is taken into account";
+    EXPECT_NE(simple, plural) << "Presence of plural is taken into account";
+    EXPECT_NE(simple, domain) << "Domain is taken into account";
+    EXPECT_EQ(simple.fingerprint(), translated.fingerprint());
+    EXPECT_EQ(::std::hash<message>{}(plural), ::std::hash<message>{}(plural_n));
+
+    EXPECT_FALSE(simple < simple_args);
+    EXPECT_FALSE(simple_args < simple);
+    EXPECT_TRUE(simple < plural) << "Message with no plural is less";
+    EXPECT_FALSE(plural < simple);
+    EXPECT_TRUE(simple < message{"banana"});
+
+    ::std::set<message> ordered{ simple, simple_args, translated, ctx,
+        plural, plural_n, domain };
+    EXPECT_EQ(4, ordered.size());
+    ::std::unordered_set<message> unordered{ simple, simple_args, translated, ctx,
+        plural, plural_n, domain };
+    EXPECT_EQ(4, unordered.size());
+}
+
 TEST(Message, PluralizeInPlace)
 {
     using loc_msg = ::boost::locale::message;
@@ -107,6 +187,127 @@ TEST(Message, Pluralize)
     EXPECT_EQ(expected5, fmt5.str());
 }
 
+namespace {
+
+struct point {
+    int x, y;
+};
+
+::std::ostream&
+operator << (::std::ostream& os, point const& p)
+{
+    return os << "(" << p.x << "," << p.y << ")";
+}
+
+::std::string
+stream_output(message const& msg, ::std::locale const& loc)
+{
+    ::std::ostringstream os;
+    os.imbue(loc);
+    os << msg;
+    return os.str();
+}
+
+}  /* namespace  */
+
+TEST(Message, Render)
+{
+    ::boost::locale::generator gen;
+    ::std::locale locales[] { ::std::locale::classic(), gen("en_US.UTF-8") };
+
+    message nested{"nested {1}"};
+    nested << -42;
+    message plural{"{1} apple", "{1} apples", 3};
+    message user{"at {1}"};
+    user << point{1, 2};
+    message opts{"{1,w=5}|{2,num}|{3}"};
+    opts << 7 << 1234567 << nested;
+    message all{"{1} {2} {3} {4} {5} {6}"};
+    all << 1 << 2l << 0.25 << "str" << nested << plural;
+    message empty;
+    message braces{"{{raw}}"};
+
+    message const* messages[] {
+        &nested, &plural, &user, &opts, &all, &empty, &braces
+    };
+    for (auto const& loc : locales) {
+        for (auto msg : messages) {
+            ::std::string out{"prefix "};
+            msg->render(out, loc);
+            EXPECT_EQ("prefix " + stream_output(*msg, loc), out)
+                    << "Render '" << msg->id() << "'";
+        }
+    }
+
+    ::std::string str;
+    all.render(::std::back_inserter(str));
+    EXPECT_EQ("1 2 0.25 str nested -42 3 apples", str);
+}
+
+TEST(Message, RenderLocales)
+{
+    ::boost::locale::generator gen;
+    message::locale_list locales {
+        ::std::locale::classic(), gen("en_US.UTF-8"), gen("de_DE.UTF-8"),
+        ::std::locale{::std::locale::classic(), new ::std::numpunct_byname<char>("C")},
+        gen("ru_RU.UTF-8"), gen("en_US.UTF-8")
+    };
+    locales.push_back(locales[1]);
+
+    message nested{"nested {1} {2,num}"};
+    nested << -42 << 10000;
+    message plural{"{1} apple", "{1} apples", 1234};
+    message user{"at {1}"};
+    user << point{1, 2};
+    message all{"{1} {2} {3} {4} {5} {6} {7,w=6}"};
+    all << 1 << 20000l << 1234.5 << "str" << nested << plural << 42;
+    message outer{"{1}: {2}"};
+    outer << all << user;
+    message domain{"{1}", message::domain_type{"other"}};
+    domain << nested;
+
+    message const* messages[] {
+        &nested, &plural, &user, &all, &outer, &domain
+    };
+    for (auto msg : messages) {
+        auto strs = msg->str(locales);
+        ASSERT_EQ(locales.size(), strs.size());
+        for (::std::size_t i = 0; i < locales.size(); ++i) {
+            EXPECT_EQ(msg->str(locales[i]), strs[i])
+                    << "Render '" << msg->id() << "' to locale " << i;
+        }
+    }
+    EXPECT_TRUE(message{}.str(locales).size() == locales.size());
+    EXPECT_TRUE(all.str(message::locale_list{}).empty());
+}
+
+namespace {
+
+struct hex_value {
+    int value;
+};
+
+::std::ostream&
+operator << (::std::ostream& os, hex_value const& v)
+{
+    // Leaves the stream in hex mode
+    return os << ::std::hex << v.value;
+}
+
+}  /* namespace  */
+
+TEST(Message, RenderStreamState)
+{
+    message hex{"{1} {2,w=4}"};
+    hex << hex_value{255} << 10;
+    message dec{"{1,w=4} {2}"};
+    dec << hex_value{255} << 10;
+    for (int i = 0; i < 3; ++i) {
+        EXPECT_EQ("ff   10", hex.str()) << "Stream state is restored";
+        EXPECT_EQ("  ff 10", dec.str()) << "Stream state is restored";
+    }
+}
+
 }  /* namespace test */
 }  /* namespace l10n */
 }  /* namespace psst */
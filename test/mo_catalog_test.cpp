@@ -0,0 +1,431 @@
+/*
+ * mo_catalog_test.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: zmij
+ */
+
+#include <gtest/gtest.h>
+#include <pushkin/l10n/catalog_registry.hpp>
+#include <pushkin/l10n/mo_catalog.hpp>
+#include <pushkin/l10n/message.hpp>
+#include <pushkin/l10n/prerendered_messages.hpp>
+#include <pushkin/l10n/translation_cache.hpp>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdint>
+#include <cstdlib>
+#include <condition_variable>
+#include <fstream>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace psst {
+namespace l10n {
+namespace test {
+
+namespace {
+
+using mo_entry = ::std::pair<::std::string, ::std::string>;
+
+::std::uint32_t
+hash_pjw(char const* s)
+{
+    ::std::uint32_t hval = 0;
+    while (*s) {
+        hval <<= 4;
+        hval += static_cast<unsigned char>(*s++);
+        ::std::uint32_t g = hval & 0xf0000000;
+        if (g) {
+            hval ^= g >> 24;
+            hval ^= g;
+        }
+    }
+    return hval;
+}
+
+void
+put_word(::std::string& out, ::std::uint32_t w)
+{
+    out.append(reinterpret_cast<char const*>(&w), sizeof(w));
+}
+
+/**
+ * Write a catalog the way msgfmt does, with or without hash table
+ */
+void
+write_mo(::std::string const& file, ::std::vector<mo_entry> entries,
+        bool with_hash)
+{
+    ::std::sort(entries.begin(), entries.end());
+    ::std::uint32_t n = entries.size();
+    ::std::uint32_t hash_size = with_hash ? n * 4 / 3 + 3 : 0;
+    ::std::uint32_t orig_table = 28;
+    ::std::uint32_t trans_table = orig_table + n * 8;
+    ::std::uint32_t hash_table = trans_table + n * 8;
+    ::std::uint32_t strings = hash_table + hash_size * 4;
+
+    ::std::string out;
+    for (auto w : { 0x950412deu, 0u, n, orig_table, trans_table,
+            hash_size, hash_table }) {
+        put_word(out, w);
+    }
+    ::std::string data;
+    ::std::string trans_descr;
+    for (auto const& e : entries) {
+        put_word(out, e.first.size());
+        put_word(out, strings + data.size());
+        data += e.first;
+        data += '\0';
+    }
+    for (auto const& e : entries) {
+        put_word(trans_descr, e.second.size());
+        put_word(trans_descr, strings + data.size());
+        data += e.second;
+        data += '\0';
+    }
+    out += trans_descr;
+    ::std::vector<::std::uint32_t> hash(hash_size, 0);
+    for (::std::uint32_t i = 0; with_hash && i < n; ++i) {
+        auto h = hash_pjw(entries[i].first.c_str());
+        auto idx = h % hash_size;
+        auto incr = 1 + h % (hash_size - 2);
+        while (hash[idx]) {
+            idx = idx >= hash_size - incr ? idx - (hash_size - incr) : idx + incr;
+        }
+        hash[idx] = i + 1;
+    }
+    for (auto w : hash) {
+        put_word(out, w);
+    }
+    out += data;
+    ::std::ofstream os{file, ::std::ios::binary};
+    os << out;
+}
+
+::std::string const plural_header =
+    "Content-Type: text/plain; charset=UTF-8\n"
+    "Plural-Forms: nplurals=3; plural=(n%10==1 && n%100!=11 ? 0 : "
+    "n%10>=2 && n%10<=4 && (n%100<10 || n%100>=20) ? 1 : 2);\n";
+
+/**
+ * Join strings with zero char, as plural forms are stored
+ */
+::std::string
+forms(::std::initializer_list<char const*> strs)
+{
+    ::std::string res;
+    for (auto s : strs) {
+        if (!res.empty())
+            res += '\0';
+        res += s;
+    }
+    return res;
+}
+
+::std::vector<mo_entry> const ru_entries {
+    { "", plural_header },
+    { "hello", "привет" },
+    { "greet\x04hello", "здравствуйте" },
+    { forms({"{1} file", "{1} files"}),
+      forms({"{1} файл", "{1} файла", "{1} файлов"}) },
+    { forms({"disk\x04{1} file", "{1} files"}),
+      forms({"{1} файл на диске", "{1} файла на диске", "{1} файлов на диске"}) },
+    { "untranslated", "" },
+};
+
+/**
+ * Count of mappings of a file that was replaced or removed
+ */
+::std::size_t
+deleted_mappings(::std::string const& path)
+{
+    ::std::ifstream maps{"/proc/self/maps"};
+    ::std::string line;
+    ::std::size_t count = 0;
+    while (::std::getline(maps, line)) {
+        if (line.find(path + " (deleted)") != ::std::string::npos)
+            ++count;
+    }
+    return count;
+}
+
+class MoCatalog : public ::testing::TestWithParam<bool> {
+protected:
+    void
+    SetUp() override
+    {
+        char tmpl[] = "/tmp/l10n-mo-test-XXXXXX";
+        ASSERT_NE(nullptr, ::mkdtemp(tmpl));
+        dir_ = tmpl;
+        auto msg_dir = dir_ + "/ru";
+        ::mkdir(msg_dir.c_str(), 0755);
+        msg_dir += "/LC_MESSAGES";
+        ::mkdir(msg_dir.c_str(), 0755);
+        file_ = msg_dir + "/test.mo";
+        write_mo(file_, ru_entries, GetParam());
+    }
+    void
+    TearDown() override
+    {
+        ::unlink(file_.c_str());
+        ::rmdir((dir_ + "/ru/LC_MESSAGES").c_str());
+        ::rmdir((dir_ + "/ru").c_str());
+        ::rmdir(dir_.c_str());
+    }
+
+    ::std::string dir_;
+    ::std::string file_;
+};
+
+}  /* namespace  */
+
+TEST_P(MoCatalog, Lookup)
+{
+    mo_catalog cat{file_};
+    EXPECT_EQ(ru_entries.size(), cat.size());
+    EXPECT_EQ(3, cat.plural().size());
+    EXPECT_STREQ("привет", cat.get(nullptr, "hello"));
+    EXPECT_STREQ("привет", cat.get("", "hello"));
+    EXPECT_STREQ("здравствуйте", cat.get("greet", "hello"));
+    EXPECT_EQ(nullptr, cat.get("other", "hello"));
+    EXPECT_EQ(nullptr, cat.get(nullptr, "hell"));
+    EXPECT_EQ(nullptr, cat.get(nullptr, "untranslated"))
+        << "Empty translation is not a translation";
+    EXPECT_EQ(nullptr, cat.get(nullptr, "")) << "Header is not returned";
+
+    EXPECT_STREQ("{1} файл", cat.get(nullptr, "{1} file", 21));
+    EXPECT_STREQ("{1} файла", cat.get(nullptr, "{1} file", 3));
+    EXPECT_STREQ("{1} файлов", cat.get(nullptr, "{1} file", 11));
+    EXPECT_STREQ("{1} файлов на диске", cat.get("disk", "{1} file", 5));
+    EXPECT_EQ(nullptr, cat.get_form(nullptr, "{1} file", 3))
+        << "No such form";
+
+    EXPECT_THROW(mo_catalog{dir_ + "/none.mo"}, ::std::runtime_error);
+    EXPECT_THROW(mo_catalog{dir_ + "/ru"}, ::std::runtime_error);
+}
+
+TEST_P(MoCatalog, SameAsBoost)
+{
+    ::boost::locale::generator gen;
+    gen.add_messages_path(dir_);
+    gen.add_messages_domain("test");
+    auto boost_loc = gen("ru_RU.UTF-8");
+    auto mo_loc = catalog_locale(boost_loc, "ru_RU.UTF-8", {dir_}, {"test"});
+    ASSERT_TRUE(::std::has_facet<mo_message_format>(mo_loc));
+
+    message messages[] {
+        message{"hello"},
+        message{"greet", "hello"},
+        message{"missing"},
+    };
+    for (auto const& msg : messages) {
+        EXPECT_EQ(msg.str(boost_loc), msg.str(mo_loc)) << msg.id();
+    }
+    // Boost returns empty translations as is, gettext doesn't
+    EXPECT_EQ("untranslated", message{"untranslated"}.str(mo_loc));
+    for (int n = 0; n < 30; ++n) {
+        message plural{"{1} file", "{1} files", n};
+        message ctx_plural{"disk", "{1} file", "{1} files", n};
+        EXPECT_EQ(plural.str(boost_loc), plural.str(mo_loc));
+        EXPECT_EQ(ctx_plural.str(boost_loc), ctx_plural.str(mo_loc));
+    }
+    message other_domain{"hello", message::domain_type{"other"}};
+    EXPECT_EQ("hello", other_domain.str(mo_loc));
+}
+
+TEST_P(MoCatalog, PluralFormCache)
+{
+    auto loc = catalog_locale(::std::locale::classic(), "ru_RU.UTF-8",
+            {dir_}, {"test"});
+    auto& cache = translation_cache::instance();
+    cache.clear();
+    cache.reset_stats();
+    for (int n = 0; n < 1000; ++n) {
+        message plural{"{1} file", "{1} files", n};
+        auto expected = ::std::to_string(n) +
+                (n % 10 == 1 && n % 100 != 11 ? " файл" :
+                 n % 10 >= 2 && n % 10 <= 4 && (n % 100 < 10 || n % 100 >= 20) ?
+                         " файла" : " файлов");
+        EXPECT_EQ(expected, plural.str(loc));
+    }
+    EXPECT_EQ(4, cache.stats().misses)
+        << "Translations are cached per plural form, and one for number 1";
+}
+
+TEST_P(MoCatalog, Reload)
+{
+    catalog_registry registry{{dir_}, {"test"}};
+    EXPECT_EQ(0, registry.version());
+    auto old_loc = registry.get("ru_RU.UTF-8");
+    EXPECT_EQ(1, registry.version());
+    EXPECT_EQ(1, registry.locales().size());
+    message hello{"hello"};
+    EXPECT_EQ("привет", hello.str(old_loc));
+    ::boost::locale::generator gen;
+    auto other = gen("en_US.UTF-8");
+    hello.str(other);
+
+    auto entries = ru_entries;
+    entries[1].second = "здравствуй";
+    // Replace the file the way catalogs should be deployed
+    write_mo(file_ + ".new", entries, GetParam());
+    ASSERT_EQ(0, ::rename((file_ + ".new").c_str(), file_.c_str()));
+    EXPECT_EQ("привет", hello.str(registry.get("ru_RU.UTF-8")))
+        << "Catalogs are not reloaded until requested";
+
+    auto misses = translation_cache::instance().stats().misses;
+    registry.reload_async().get();
+    EXPECT_EQ(2, registry.version());
+    hello.str(other);
+    EXPECT_EQ(misses, translation_cache::instance().stats().misses)
+        << "Translations of other locales stay cached after a reload";
+    EXPECT_EQ("здравствуй", hello.str(registry.get("ru_RU.UTF-8")));
+    EXPECT_EQ("привет", hello.str(old_loc)) << "Old version is still in use";
+
+    ::std::ofstream{file_ + ".new", ::std::ios::binary} << "broken";
+    ASSERT_EQ(0, ::rename((file_ + ".new").c_str(), file_.c_str()));
+    EXPECT_THROW(registry.reload(), ::std::runtime_error);
+    EXPECT_EQ(2, registry.version());
+    EXPECT_EQ("здравствуй", hello.str(registry.get("ru_RU.UTF-8")));
+}
+
+TEST_P(MoCatalog, ReloadIdleThread)
+{
+    catalog_registry registry{{dir_}, {"test"}};
+    ::std::mutex mtx;
+    ::std::condition_variable cv;
+    bool rendered = false;
+    bool done = false;
+    ::std::string str;
+    ::std::thread worker{[&]()
+    {
+        {
+            auto loc = registry.get("ru_RU.UTF-8");
+            message hello{"hello"};
+            message files{"{1} file", "{1} files", 1234567};
+            files << 1234567;
+            str = hello.str(loc) + " " + files.str(loc);
+        }
+        ::std::unique_lock<::std::mutex> lock{mtx};
+        rendered = true;
+        cv.notify_all();
+        // The thread stays alive and doesn't use the registry anymore
+        cv.wait(lock, [&]() { return done; });
+    }};
+    {
+        ::std::unique_lock<::std::mutex> lock{mtx};
+        cv.wait(lock, [&]() { return rendered; });
+    }
+    EXPECT_EQ(0, str.find("привет "));
+
+    write_mo(file_ + ".new", ru_entries, GetParam());
+    ASSERT_EQ(0, ::rename((file_ + ".new").c_str(), file_.c_str()));
+    EXPECT_LT(0, deleted_mappings(file_)) << "Replaced catalog is in use";
+    registry.reload();
+    EXPECT_EQ(0, deleted_mappings(file_))
+        << "Replaced catalog is unmapped after the reload, although "
+           "an idle thread used it";
+    {
+        ::std::lock_guard<::std::mutex> lock{mtx};
+        done = true;
+    }
+    cv.notify_all();
+    worker.join();
+}
+
+TEST_P(MoCatalog, MessageIds)
+{
+    // Table as generated from a .pot file for the catalog
+    static message_entry const entries[] {
+        { nullptr, "hello", nullptr },
+        { "greet", "hello", nullptr },
+        { nullptr, "{1} file", "{1} files" },
+        { "disk", "{1} file", "{1} files" },
+        { nullptr, "missing", nullptr },
+        { nullptr, "{1} dir", "{1} dirs" },
+    };
+    static message_table const table{ "test", entries, 6 };
+    auto id = [](::std::uint32_t value)
+    {
+        return message_id{ []() -> message_table const& { return table; }, value };
+    };
+
+    auto loc = catalog_locale(::std::locale::classic(), "ru_RU.UTF-8",
+            {dir_}, {"test"});
+    auto& cache = translation_cache::instance();
+    cache.clear();
+    cache.reset_stats();
+    EXPECT_EQ("привет", message{id(0)}.str(loc));
+    EXPECT_EQ("здравствуйте", message{id(1)}.str(loc));
+    EXPECT_EQ("missing", message{id(4)}.str(loc));
+    for (int n = 0; n < 30; ++n) {
+        message plural{"{1} file", "{1} files", n, message::domain_type{"test"}};
+        message ctx_plural{"disk", "{1} file", "{1} files", n,
+            message::domain_type{"test"}};
+        message untranslated{"{1} dir", "{1} dirs", n, message::domain_type{"test"}};
+        EXPECT_EQ(plural.str(loc), message(id(2), n).str(loc));
+        EXPECT_EQ(ctx_plural.str(loc), message(id(3), n).str(loc));
+        EXPECT_EQ(untranslated.str(loc), message(id(5), n).str(loc));
+    }
+    EXPECT_EQ((message{"greet", "hello", message::domain_type{"test"}}),
+            message{id(1)});
+    EXPECT_THROW(message{id(6)}, ::std::out_of_range);
+
+    cache.reset_stats();
+    for (int n = 0; n < 30; ++n) {
+        message(id(2), n).str(loc);
+        message{id(0)}.str(loc);
+    }
+    EXPECT_EQ(0, cache.stats().misses + cache.stats().hits)
+        << "Messages with ids are looked up by index";
+}
+
+TEST_P(MoCatalog, Prerendered)
+{
+    static message_entry const entries[] {
+        { nullptr, "hello", nullptr },
+        { "greet", "hello", nullptr },
+        { nullptr, "{1} file", "{1} files" },
+        { nullptr, "untranslated", nullptr },
+    };
+    static message_table const table{ "test", entries, 4 };
+    auto id = [](::std::uint32_t value)
+    {
+        return message_id{ []() -> message_table const& { return table; }, value };
+    };
+
+    catalog_registry registry{{dir_}, {"test"}};
+    auto loc = registry.get("ru_RU.UTF-8");
+    prerendered_messages messages{table, registry};
+    ASSERT_EQ(1, messages.size());
+    EXPECT_EQ("привет", messages.str(id(0), loc));
+    EXPECT_EQ("здравствуйте", messages.str(id(1), loc));
+    EXPECT_EQ("untranslated", messages.str(id(3), loc));
+    EXPECT_FALSE(messages.prerendered(id(2)));
+
+    auto& cache = translation_cache::instance();
+    cache.reset_stats();
+    for (int i = 0; i < 10; ++i) {
+        messages.str(id(0), registry.get("ru_RU.UTF-8"));
+    }
+    EXPECT_EQ(0, cache.stats().misses + cache.stats().hits)
+        << "Strings are not looked up";
+
+    registry.reload();
+    EXPECT_EQ(prerendered_messages::npos,
+            messages.locale_index(registry.get("ru_RU.UTF-8")))
+        << "Reloaded catalogs need a new table";
+    EXPECT_EQ("привет", messages.str(id(0), loc));
+}
+
+INSTANTIATE_TEST_CASE_P(HashTable, MoCatalog, ::testing::Values(true, false));
+
+}  /* namespace test */
+}  /* namespace l10n */
+}  /* namespace psst */
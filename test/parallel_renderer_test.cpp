@@ -0,0 +1,145 @@
+/*
+ * parallel_renderer_test.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: zmij
+ */
+
+#include <gtest/gtest.h>
+#include <pushkin/l10n/parallel_renderer.hpp>
+
+#include <atomic>
+#include <future>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace psst {
+namespace l10n {
+namespace test {
+
+namespace {
+
+message_list
+make_messages(::std::size_t size)
+{
+    message_list messages;
+    for (::std::size_t i = 0; i < size; ++i) {
+        int n = static_cast<int>(i);
+        switch (i % 3) {
+            case 0:
+                messages.emplace_back("Message {1}");
+                messages.back() << n;
+                break;
+            case 1:
+                messages.emplace_back("{1} apple", "{1} apples", n);
+                break;
+            default: {
+                message nested{"nested {1}"};
+                nested << "str";
+                messages.emplace_back("{1}: {2}");
+                messages.back() << n << nested;
+                break;
+            }
+        }
+    }
+    return messages;
+}
+
+}  /* namespace  */
+
+TEST(ParallelRenderer, Future)
+{
+    ::boost::locale::generator gen;
+    auto loc = gen("en_US.UTF-8");
+    auto messages = make_messages(5000);
+    parallel_renderer renderer{4};
+    EXPECT_EQ(4, renderer.size());
+    auto strs = renderer.render(messages, loc).get();
+    ASSERT_EQ(messages.size(), strs.size());
+    for (::std::size_t i = 0; i < messages.size(); ++i) {
+        EXPECT_EQ(messages[i].str(loc), strs[i]) << "Message " << i;
+    }
+    EXPECT_TRUE(renderer.render(message_list{}, loc).get().empty());
+}
+
+TEST(ParallelRenderer, EmptyList)
+{
+    parallel_renderer renderer{2};
+    ::std::promise<::std::thread::id> done;
+    auto completed = done.get_future();
+    renderer.render(message_list{}, ::std::locale::classic(),
+        [](::std::size_t, ::std::string&&)
+        {
+            ADD_FAILURE() << "Nothing is rendered";
+        },
+        [&](::std::exception_ptr e)
+        {
+            EXPECT_FALSE(e);
+            done.set_value(::std::this_thread::get_id());
+        });
+    EXPECT_NE(::std::this_thread::get_id(), completed.get())
+        << "Completion is called from a worker thread";
+}
+
+TEST(ParallelRenderer, Ordered)
+{
+    auto messages = make_messages(3000);
+    parallel_renderer renderer{3};
+    ::std::vector<::std::size_t> indexes;
+    auto done = renderer.render(messages, ::std::locale::classic(),
+        [&](::std::size_t idx, ::std::string&& str)
+        {
+            EXPECT_EQ(messages[idx].str(::std::locale::classic()), str);
+            indexes.push_back(idx);
+        }, parallel_renderer::delivery::ordered);
+    done.get();
+    ASSERT_EQ(messages.size(), indexes.size());
+    for (::std::size_t i = 0; i < indexes.size(); ++i) {
+        EXPECT_EQ(i, indexes[i]);
+    }
+}
+
+TEST(ParallelRenderer, Unordered)
+{
+    auto messages = make_messages(3000);
+    parallel_renderer renderer{3};
+    ::std::mutex mtx;
+    ::std::vector<int> seen(messages.size(), 0);
+    ::std::promise<::std::exception_ptr> done;
+    renderer.render(messages, ::std::locale::classic(),
+        [&](::std::size_t idx, ::std::string&&)
+        {
+            ::std::lock_guard<::std::mutex> lock{mtx};
+            ++seen[idx];
+        },
+        [&](::std::exception_ptr e)
+        {
+            done.set_value(e);
+        });
+    EXPECT_FALSE(done.get_future().get());
+    for (::std::size_t i = 0; i < seen.size(); ++i) {
+        EXPECT_EQ(1, seen[i]) << "Message " << i;
+    }
+}
+
+TEST(ParallelRenderer, Error)
+{
+    auto messages = make_messages(3000);
+    parallel_renderer renderer{2};
+    ::std::atomic<::std::size_t> delivered{0};
+    auto done = renderer.render(messages, ::std::locale::classic(),
+        [&](::std::size_t idx, ::std::string&&)
+        {
+            if (idx == 100)
+                throw ::std::runtime_error{"Failed"};
+            ++delivered;
+        }, parallel_renderer::delivery::ordered);
+    EXPECT_THROW(done.get(), ::std::runtime_error);
+    EXPECT_EQ(100, delivered.load());
+}
+
+}  /* namespace test */
+}  /* namespace l10n */
+}  /* namespace psst */
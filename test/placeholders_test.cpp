@@ -9,6 +9,7 @@
 
 #include <pushkin/l10n/message.hpp>
 #include <pushkin/l10n/grammar/placeholders.hpp>
+#include <pushkin/l10n/placeholder_cache.hpp>
 
 namespace psst {
 namespace l10n {
@@ -71,6 +72,76 @@ INSTANTIATE_TEST_CASE_P(ParserTest, Placeholders,
            Placeholders::ParamType{"{n:FogGrenades.EffectTimeSec} second", 1}
         ));
 
+namespace {
+
+placeholders
+parse_with_grammar(::std::string const& input)
+{
+    namespace qi = ::boost::spirit::qi;
+    using string_iterator   = ::std::string::const_iterator;
+    using grammar_type      = grammar::parse::placeholders_grammar<string_iterator>;
+    static grammar_type parser;
+
+    string_iterator first = input.begin();
+    string_iterator last = input.end();
+    placeholders ph;
+    qi::parse(first, last, parser, ph);
+    return ph;
+}
+
+void
+expect_same(placeholders const& expected, placeholders const& actual,
+        ::std::string const& input)
+{
+    ASSERT_EQ(expected.size(), actual.size()) << "Input: '" << input << "'";
+    for (::std::size_t i = 0; i < expected.size(); ++i) {
+        EXPECT_EQ(expected[i].type(), actual[i].type()) << input;
+        EXPECT_TRUE(expected[i].id == actual[i].id) << input;
+        EXPECT_EQ(expected[i].options, actual[i].options) << input;
+        if (expected[i].type() == placeholder::name) {
+            EXPECT_EQ(expected[i].is_pluralizer, actual[i].is_pluralizer) << input;
+        }
+    }
+}
+
+}  /* namespace  */
+
+TEST(ParserTest, ScannerSameAsGrammar)
+{
+    char const* const inputs[] {
+        "", "{", "}", "{{", "{{}", "{}", "{ 1}", "{1 }", "{1", "{1,", "{1,}",
+        "{1,a", "{1,a}", "{1a}", "{007}", "{a1.b_c}", "{.a}", "{n}", "{n:}",
+        "{n:a}", "{n:1}", "{N:a}", "{n:n:a}", "{_}", "{a,{b}", "{a,b,c}",
+        "{18446744073709551615}", "{18446744073709551616}",
+        "{99999999999999999999999}", "text {1} {{ {2} }} {3",
+        "{1} { bad} {2}", "{{{1}", "{{{{1}}}}", "a{1}b{2,c}d{n:e,f}g",
+        "Ms. {1} had arrived at {2,ftime='%I o''clock'} at home",
+        "\xd0\xbf\xd1\x80\xd0\xb8 {1} \xd0\xb2 {x}",
+    };
+    for (auto input : inputs) {
+        expect_same(parse_with_grammar(input), extract_placeholders(input), input);
+    }
+
+    // Random strings of characters significant for the grammar
+    char const alphabet[] = "{{{}}}n:1a_.,, ";
+    unsigned seed = 42;
+    auto next = [&]()
+    {
+        seed = seed * 1103515245 + 12345;
+        return (seed >> 16) & 0x7fff;
+    };
+    for (int i = 0; i < 20000; ++i) {
+        ::std::string input;
+        auto size = next() % 24;
+        for (unsigned j = 0; j < size; ++j) {
+            input += alphabet[next() % (sizeof(alphabet) - 1)];
+        }
+        expect_same(parse_with_grammar(input), extract_placeholders(input), input);
+        if (HasFailure())
+            return;
+    }
+}
+
 TEST(ParserTest, ExtractNamedPlaceholders)
 {
     {
@@ -103,6 +174,13 @@ TEST(ParserTest, ExtractNamedPlaceholders)
         EXPECT_EQ(2, id_phs.second[0].uses);
         EXPECT_EQ(1, id_phs.second[1].uses);
     }
+    {
+        auto id_phs = extract_named_placeholders("Unexpected `{{' in {file} at { bad} {line}");
+        EXPECT_EQ("Unexpected `{{' in {1} at { bad} {line}", id_phs.first)
+            << "Escapes and text after an invalid placeholder are kept as is";
+        ASSERT_EQ(1, id_phs.second.size());
+        EXPECT_EQ(1, id_phs.second[0].uses);
+    }
 }
 
 TEST(Placeholders, FeedNamedValues)
@@ -133,6 +211,134 @@ TEST(Placeholders, FeedNamedValues)
     }
 }
 
+TEST(Placeholders, FeedFromTable)
+{
+    ::std::pair<char const*, ::std::string> const strings[] {
+        { "A", "foo" }, { "B", "bar" }
+    };
+    auto msg = message::create_message("{B} second {1} {A}", strings);
+    EXPECT_EQ("{1} second {3} {2}", msg.id());
+    msg << "blabla";
+    EXPECT_EQ("bar second blabla foo", msg.str());
+
+    ::std::vector<::std::pair<::std::string, int>> const numbers {
+        { "count", 3 }, { "total", 42 }
+    };
+    auto plural = message::create_message("{n:count} of {total} file",
+            "{n:count} of {total} files", numbers, 0);
+    EXPECT_EQ(3, plural.get_n());
+    EXPECT_EQ("3 of 42 files", plural.str());
+    auto ctx = message::create_message("disk", "{total} files", numbers);
+    EXPECT_EQ("disk", ctx.context());
+    EXPECT_EQ("42 files", ctx.str());
+
+    EXPECT_THROW(message::create_message("{C}", strings), ::std::runtime_error);
+    EXPECT_THROW(message::create_message("{n:A} file", "{n:A} files", strings, 0),
+            ::std::runtime_error) << "Plural value must be a number";
+}
+
+TEST(Placeholders, Cache)
+{
+    placeholder_cache cache{16};
+    auto first = cache.get("{A} second {1} {B}");
+    EXPECT_EQ("{1} second {3} {2}", first->first);
+    EXPECT_EQ(2, first->second.size());
+    EXPECT_EQ(first, cache.get("{A} second {1} {B}"));
+    auto stats = cache.stats();
+    EXPECT_EQ(1, stats.size);
+    EXPECT_EQ(1, stats.hits);
+    EXPECT_EQ(1, stats.misses);
+    EXPECT_DOUBLE_EQ(0.5, stats.hit_rate());
+
+    auto fn = [](message& msg, ::std::string const&) { msg << 42; };
+    auto& global = placeholder_cache::instance();
+    global.reset_stats();
+    for (int i = 0; i < 3; ++i) {
+        auto msg = message::create_message("{n:A} bar {B}", "{n:A} bars {B}",
+                fn, nullptr, 2);
+        EXPECT_EQ("2 bars 42", msg.str());
+    }
+    EXPECT_EQ(4, global.stats().hits) << "Both strings are cached";
+}
+
+namespace {
+
+void
+expect_same_as_runtime(static_named_id const& id, ::std::string const& input)
+{
+    auto expected = extract_named_placeholders(input);
+    auto const& parsed = id.get();
+    EXPECT_EQ(expected.first, parsed.first) << input;
+    EXPECT_EQ(expected.first, ::std::string(id.str(), id.size())) << input;
+    ASSERT_EQ(expected.second.size(), parsed.second.size()) << input;
+    for (::std::size_t i = 0; i < expected.second.size(); ++i) {
+        auto const& e = expected.second[i];
+        auto const& p = parsed.second[i];
+        EXPECT_EQ(::boost::get<::std::string>(e.id),
+                ::boost::get<::std::string>(p.id)) << input;
+        EXPECT_EQ(e.is_pluralizer, p.is_pluralizer) << input;
+        EXPECT_EQ(e.options, p.options) << input;
+        EXPECT_EQ(e.uses, p.uses) << input;
+    }
+}
+
+}  /* namespace  */
+
+TEST(Placeholders, StaticNamedId)
+{
+#define EXPECT_SAME_AS_RUNTIME(str) \
+    expect_same_as_runtime(PSST_L10N_NAMED_ID(str), str)
+    EXPECT_SAME_AS_RUNTIME("No placeholders");
+    EXPECT_SAME_AS_RUNTIME("{1} numbered {2,num} only");
+    EXPECT_SAME_AS_RUNTIME("{A} second {1} {B}");
+    EXPECT_SAME_AS_RUNTIME("{A} second {1} {B} some {n:A}");
+    EXPECT_SAME_AS_RUNTIME("{A,hex} second {1,ftime='%I o''clock'} {B,time=full} some {n:A,oct}");
+    EXPECT_SAME_AS_RUNTIME("{n:A} bar {B} {A}");
+    EXPECT_SAME_AS_RUNTIME("Unexpected `{{' in {file} at {line}");
+    EXPECT_SAME_AS_RUNTIME("{a1}{a2}{a3}{a4}{a5}{a6}{a7}{a8}{a9}{a10}{a11} {1}");
+    EXPECT_SAME_AS_RUNTIME("{FogGrenades.EffectTimeSec} second");
+    EXPECT_SAME_AS_RUNTIME("{user} sent {n:count} files to {who} at {when}, "
+            "{2,num} of {1} failed: {file} {line} {what} {total}; "
+            "{user} {who} {when} {file} {line} {what} {total} {count} "
+            "{3} {4,hex} {5} {6} {7} {8} {9} {10} {11} {12} {13} {14} "
+            "{user} {n:count} {who} {when} {file} {line} {what} {total}");
+#undef EXPECT_SAME_AS_RUNTIME
+    struct names_literal {
+        static constexpr char const*
+        get() { return "{A} {1} {B} {A}"; }
+        static constexpr ::std::size_t
+        size() { return 15; }
+    };
+    static_assert(detail::static_literal<names_literal>::names == 2,
+            "Names are counted at compile time");
+
+    ::std::pair<char const*, ::std::string> const strings[] {
+        { "A", "foo" }, { "B", "bar" }
+    };
+    ::std::vector<::std::pair<::std::string, int>> const numbers {
+        { "count", 3 }, { "total", 42 }
+    };
+    auto& global = placeholder_cache::instance();
+    global.reset_stats();
+    auto msg = message::create_message(
+            PSST_L10N_NAMED_ID("{B} second {1} {A}"), strings);
+    EXPECT_EQ("{1} second {3} {2}", msg.id());
+    msg << "blabla";
+    EXPECT_EQ("bar second blabla foo", msg.str());
+    auto plural = message::create_message(
+            PSST_L10N_NAMED_ID("{n:count} of {total} file"),
+            PSST_L10N_NAMED_ID("{n:count} of {total} files"), numbers, 0);
+    EXPECT_EQ(3, plural.get_n());
+    EXPECT_EQ("3 of 42 files", plural.str());
+    auto ctx = message::create_message("disk",
+            PSST_L10N_NAMED_ID("{total} files"),
+            [](message& m, ::std::string const&) { m << 42; });
+    EXPECT_EQ("disk", ctx.context());
+    EXPECT_EQ("42 files", ctx.str());
+    auto stats = global.stats();
+    EXPECT_EQ(0, stats.hits + stats.misses) << "The cache is not used";
+}
+
 }  /* namespace test */
 }  /* namespace l10n */
 }  /* namespace psst */
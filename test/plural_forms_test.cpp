@@ -0,0 +1,95 @@
+/*
+ * plural_forms_test.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: zmij
+ */
+
+#include <gtest/gtest.h>
+#include <pushkin/l10n/plural_forms.hpp>
+
+#include <stdexcept>
+
+namespace psst {
+namespace l10n {
+namespace test {
+
+namespace {
+
+::std::string const ru_rule =
+    "(n%10==1 && n%100!=11 ? 0 : "
+    "n%10>=2 && n%10<=4 && (n%100<10 || n%100>=20) ? 1 : 2)";
+
+}  /* namespace  */
+
+TEST(PluralForms, Evaluate)
+{
+    plural_forms def;
+    EXPECT_EQ(2, def.size());
+    EXPECT_EQ(1, def(0));
+    EXPECT_EQ(0, def(1));
+    EXPECT_EQ(1, def(2));
+
+    auto ru = plural_forms::from_header(
+        "Content-Type: text/plain; charset=UTF-8\n"
+        "Plural-Forms: nplurals=3; plural=" + ru_rule + ";\n");
+    EXPECT_EQ(3, ru.size());
+    long expected[] { 2, 0, 1, 1, 1, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+            2, 2, 2, 0, 1 };
+    for (long n = 0; n < 23; ++n) {
+        EXPECT_EQ(expected[n], ru(n)) << "n = " << n;
+    }
+    EXPECT_EQ(0, ru(101));
+    EXPECT_EQ(2, ru(111));
+
+    EXPECT_EQ(2, plural_forms("n/0 + 2", 3)(5)) << "Division by zero yields 0";
+    EXPECT_EQ(1, plural_forms("!(n == 1) && 1 || 0", 2)(5));
+    EXPECT_THROW(plural_forms("n +", 2), ::std::runtime_error);
+    EXPECT_THROW(plural_forms("(n", 2), ::std::runtime_error);
+    EXPECT_THROW(plural_forms("x", 2), ::std::runtime_error);
+    EXPECT_EQ(2, plural_forms::from_header("Plural-Forms: nplurals=2; plural=n +;").size())
+        << "Invalid expression falls back to the default rule";
+}
+
+TEST(PluralForms, Native)
+{
+    EXPECT_TRUE(plural_forms{}.is_native());
+    EXPECT_TRUE(plural_forms("0", 1).is_native());
+    EXPECT_TRUE(plural_forms("(n > 1)", 2).is_native());
+    EXPECT_TRUE(plural_forms(ru_rule, 3).is_native());
+    EXPECT_TRUE(plural_forms("n%10==1&&n%100!=11?0:(n%10>=2&&n%10<=4)&&"
+            "(n%100<10||n%100>=20)?1:2", 3).is_native())
+        << "Spacing and parentheses don't matter";
+    EXPECT_FALSE(plural_forms("n == 1 ? 0 : 1", 2).is_native());
+    EXPECT_FALSE(plural_forms("n%10==1 && n%100!=11 ? 0 : 1", 2).is_native());
+}
+
+TEST(PluralForms, CompiledSameAsNative)
+{
+    // The same rules spelled so that they are not recognized as native
+    char const* const rules[] {
+        "n != 1",
+        "n > 1",
+        "n%10==1 && n%100!=11 ? 0 : n != 0 ? 1 : 2",
+        "n==1 ? 0 : (n==0 || (n%100 > 0 && n%100 < 20)) ? 1 : 2",
+        "n%10==1 && n%100!=11 ? 0 : n%10>=2 && (n%100<10 || n%100>=20) ? 1 : 2",
+        "n%10==1 && n%100!=11 ? 0 : n%10>=2 && n%10<=4 && (n%100<10 || n%100>=20) ? 1 : 2",
+        "(n==1) ? 0 : (n>=2 && n<=4) ? 1 : 2",
+        "n==1 ? 0 : n%10>=2 && n%10<=4 && (n%100<10 || n%100>=20) ? 1 : 2",
+        "n%100==1 ? 0 : n%100==2 ? 1 : n%100==3 || n%100==4 ? 2 : 3",
+        "n==0 ? 0 : n==1 ? 1 : n==2 ? 2 : n%100>=3 && n%100<=10 ? 3 : n%100>=11 ? 4 : 5",
+    };
+    for (auto rule : rules) {
+        plural_forms native{rule, 6};
+        plural_forms compiled{::std::string{"0 + ("} + rule + ")", 6};
+        ASSERT_TRUE(native.is_native()) << rule;
+        ASSERT_FALSE(compiled.is_native()) << rule;
+        for (long n = -20; n < 1200; ++n) {
+            ASSERT_EQ(native(n), compiled(n)) << rule << " n = " << n;
+        }
+    }
+}
+
+}  /* namespace test */
+}  /* namespace l10n */
+}  /* namespace psst */
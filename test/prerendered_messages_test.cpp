@@ -0,0 +1,58 @@
+/*
+ * prerendered_messages_test.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: zmij
+ */
+
+#include <gtest/gtest.h>
+#include <pushkin/l10n/prerendered_messages.hpp>
+#include "l10ntest_ids.hpp"
+
+#include <stdexcept>
+
+namespace psst {
+namespace l10n {
+namespace test {
+
+TEST(PrerenderedMessages, Render)
+{
+    ::boost::locale::generator gen;
+    auto en = gen("en_US.UTF-8");
+    prerendered_messages table{ids::table_(), { ::std::locale::classic(), en }};
+    EXPECT_EQ(&ids::table_(), &table.table());
+    EXPECT_EQ(2, table.size());
+
+    EXPECT_TRUE(table.prerendered(ids::open));
+    EXPECT_TRUE(table.prerendered(ids::file_open));
+    EXPECT_TRUE(table.prerendered(ids::simple_message));
+    EXPECT_FALSE(table.prerendered(ids::simple_format_message_1))
+        << "Message with placeholders";
+    EXPECT_FALSE(table.prerendered(ids::msg_1_apple)) << "Plural message";
+
+    for (auto id : { ids::open, ids::file_open, ids::simple_message }) {
+        auto const& str = table.str(id, en);
+        EXPECT_EQ(message{id}.str(en), str);
+        EXPECT_EQ(&str, &table.str(id, ::std::locale{en}))
+            << "Copies of a locale find the same string";
+        EXPECT_EQ(&str, table.find(id, table.locale_index(en)));
+    }
+    EXPECT_EQ(nullptr, table.find(ids::msg_1_apple, en));
+    EXPECT_THROW(table.str(ids::simple_format_message_1, en), ::std::out_of_range);
+}
+
+TEST(PrerenderedMessages, UnknownLocale)
+{
+    ::boost::locale::generator gen;
+    auto en = gen("en_US.UTF-8");
+    prerendered_messages table{ids::table_(), { en }};
+    auto de = gen("de_DE.UTF-8");
+    EXPECT_EQ(prerendered_messages::npos, table.locale_index(de));
+    EXPECT_EQ(nullptr, table.find(ids::open, de));
+    EXPECT_EQ(nullptr, table.find(ids::open, table.size()));
+    EXPECT_THROW(table.str(ids::open, de), ::std::out_of_range);
+}
+
+}  /* namespace test */
+}  /* namespace l10n */
+}  /* namespace psst */
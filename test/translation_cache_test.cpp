@@ -0,0 +1,283 @@
+/*
+ * translation_cache_test.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: zmij
+ */
+
+#include <gtest/gtest.h>
+#include <pushkin/l10n/translation_cache.hpp>
+
+#include <map>
+#include <sstream>
+
+namespace psst {
+namespace l10n {
+namespace test {
+
+namespace {
+
+/**
+ * Message catalog translating messages by a map, counting lookups
+ */
+class test_catalog : public ::boost::locale::message_format<char> {
+public:
+    using translations = ::std::map<::std::string, ::std::string>;
+
+    explicit
+    test_catalog(translations const& tr) : tr_{tr} {}
+
+    char const*
+    get(int domain_id, char const* context, char const* id) const override
+    {
+        ++lookups;
+        auto key = ::std::to_string(domain_id) + (context ? context : "") + id;
+        auto f = tr_.find(key);
+        if (f != tr_.end())
+            return f->second.c_str();
+        return nullptr;
+    }
+    char const*
+    get(int domain_id, char const* context, char const* id, int n) const override
+    {
+        ++lookups;
+        auto key = ::std::to_string(domain_id) + (context ? context : "") + id +
+                (n == 1 ? "[1]" : "[n]");
+        auto f = tr_.find(key);
+        if (f != tr_.end())
+            return f->second.c_str();
+        return nullptr;
+    }
+    int
+    domain(::std::string const& name) const override
+    {
+        // Unknown domains are -1, as in the catalogs of boost::locale
+        return name == "other" ? 1 : -1;
+    }
+    char const*
+    convert(char const* msg, ::std::string&) const override
+    {
+        return msg;
+    }
+
+    mutable int lookups = 0;
+private:
+    translations tr_;
+};
+
+/**
+ * Catalog that reports it's destruction
+ */
+class tracked_catalog : public test_catalog {
+public:
+    tracked_catalog(translations const& tr, bool& destroyed)
+        : test_catalog{tr}, destroyed_(destroyed) {}
+    ~tracked_catalog()
+    {
+        destroyed_ = true;
+    }
+private:
+    bool& destroyed_;
+};
+
+}  /* namespace  */
+
+TEST(TranslationCache, Translate)
+{
+    auto catalog = new test_catalog{{
+        { "0hello",         "привет" },
+        { "0greethello",    "здравствуйте" },
+        { "1hello",         "hola" },
+        { "0{1} file[1]",   "{1} файл" },
+        { "0{1} file[n]",   "{1} файлов" },
+    }};
+    ::std::locale loc{ ::std::locale::classic(), catalog };
+    translation_cache cache;
+
+    message simple{"hello"};
+    message ctx{"greet", "hello"};
+    message other{"hello", message::domain_type{"other"}};
+    message missing{"unknown"};
+    message plural{"{1} file", "{1} files", 1};
+
+    EXPECT_EQ("привет", cache.translate(loc, simple.text(), 0).str());
+    EXPECT_EQ("здравствуйте", cache.translate(loc, ctx.text(), 0).str());
+    EXPECT_EQ("hola", cache.translate(loc, other.text(), 0).str());
+    EXPECT_EQ("unknown", cache.translate(loc, missing.text(), 0).str());
+    EXPECT_EQ("{1} файл", cache.translate(loc, plural.text(), 1).str());
+    EXPECT_EQ("{1} файлов", cache.translate(loc, plural.text(), 5).str());
+
+    auto stats = cache.stats();
+    EXPECT_EQ(0, stats.hits);
+    EXPECT_EQ(6, stats.misses);
+    EXPECT_EQ(6, catalog->lookups);
+
+    EXPECT_EQ("привет", cache.translate(loc, simple.text(), 0).str());
+    EXPECT_EQ("привет", cache.translate(loc, message{"hello"}.text(), 10).str())
+        << "Plural number is ignored for non-plural messages";
+    EXPECT_EQ("{1} файлов", cache.translate(loc, plural.text(), 5).str());
+    stats = cache.stats();
+    EXPECT_EQ(3, stats.hits);
+    EXPECT_EQ(6, stats.misses);
+    EXPECT_EQ(6, catalog->lookups) << "Cached translations are not looked up";
+
+    cache.clear();
+    EXPECT_EQ(0, cache.stats().size);
+    EXPECT_EQ("привет", cache.translate(loc, simple.text(), 0).str());
+    EXPECT_EQ(7, catalog->lookups);
+}
+
+TEST(TranslationCache, UnknownStreamDomain)
+{
+    ::std::locale loc{ ::std::locale::classic(), new test_catalog{{
+        { "0hello", "привет" },
+        { "1hello", "hola" },
+    }}};
+    namespace as = ::boost::locale::as;
+    message hello{"hello"};
+    ::std::ostringstream os;
+    os.imbue(loc);
+    os << as::domain("nope") << hello;
+    EXPECT_EQ("hello", os.str())
+        << "Message is not translated in an unknown domain of the stream";
+
+    os.str("");
+    os << as::domain("other") << hello;
+    EXPECT_EQ("hola", os.str());
+    os.str("");
+    os << as::domain("nope") << hello;
+    EXPECT_EQ("hello", os.str()) << "Translation of another domain is not reused";
+}
+
+TEST(TranslationCache, NoCatalog)
+{
+    auto loc = ::std::locale::classic();
+    translation_cache cache;
+    message hello{"hello"};
+    message files{"{1} file", "{1} files", 2};
+    auto tmpl = cache.get_template(loc, hello.text(), 0);
+    EXPECT_EQ("hello", tmpl->str().str());
+    EXPECT_EQ(tmpl, cache.get_template(loc, hello.text(), 0))
+        << "Messages are cached for a locale without catalogs";
+    EXPECT_EQ("{1} files", cache.translate(loc, files.text(), 2).str());
+    EXPECT_EQ("{1} files", cache.translate(loc, files.text(), 5).str());
+    EXPECT_EQ("{1} file", cache.translate(loc, files.text(), 1).str());
+    auto stats = cache.stats();
+    EXPECT_EQ(3, stats.size) << "Only singular and plural are distinguished";
+    EXPECT_EQ(2, stats.hits);
+}
+
+TEST(TranslationCache, Capacity)
+{
+    ::std::locale loc{ ::std::locale::classic(), new test_catalog{{}} };
+    translation_cache cache{4};
+    EXPECT_EQ(4, cache.capacity());
+
+    ::std::vector<message> messages;
+    for (int i = 0; i < 32; ++i) {
+        messages.emplace_back("message " + ::std::to_string(i));
+    }
+    for (auto const& msg : messages) {
+        EXPECT_EQ(msg.id(), cache.translate(loc, msg.text(), 0).str());
+    }
+    auto stats = cache.stats();
+    EXPECT_GE(4, stats.size);
+    EXPECT_EQ(32, stats.misses);
+    EXPECT_GE(32, stats.size + stats.evictions);
+
+    cache.set_capacity(0);
+    EXPECT_EQ(0, cache.stats().size);
+    EXPECT_EQ(messages.front().id(),
+            cache.translate(loc, messages.front().text(), 0).str());
+    EXPECT_EQ(0, cache.stats().size) << "Zero capacity cache stores nothing";
+}
+
+TEST(TranslationCache, Release)
+{
+    auto catalog = new test_catalog{{ { "0hello", "привет" } }};
+    ::std::locale loc{ ::std::locale::classic(), catalog };
+    auto other_catalog = new test_catalog{{ { "0hello", "hola" } }};
+    ::std::locale other{ ::std::locale::classic(), other_catalog };
+    translation_cache cache;
+    message hello{"hello"};
+    EXPECT_EQ("привет", cache.translate(loc, hello.text(), 0).str());
+    EXPECT_EQ("hola", cache.translate(other, hello.text(), 0).str());
+    EXPECT_EQ(2, cache.stats().size);
+
+    cache.release(loc);
+    EXPECT_EQ(1, cache.stats().size);
+    EXPECT_EQ("hola", cache.translate(other, hello.text(), 0).str());
+    EXPECT_EQ(1, other_catalog->lookups) << "Other locale stays cached";
+    EXPECT_EQ("привет", cache.translate(loc, hello.text(), 0).str());
+    EXPECT_EQ(2, catalog->lookups) << "Released translation is looked up again";
+
+    cache.release(::std::locale::classic());
+    EXPECT_EQ(2, cache.stats().size) << "Locale without catalogs releases nothing";
+}
+
+TEST(TranslationCache, KeepsFacets)
+{
+    translation_cache cache;
+    message hello{"hello"};
+    // Locales are also kept by the per thread cache of locale facets,
+    // rendering with other locales evicts them
+    auto evict_locales = [&]()
+    {
+        for (int i = 0; i < 8; ++i) {
+            ::std::locale other{ ::std::locale::classic(), new test_catalog{{}} };
+            translation_cache{}.translate(other, hello.text(), 0);
+        }
+    };
+    bool cached_destroyed = false;
+    {
+        ::std::locale loc{ ::std::locale::classic(),
+            new tracked_catalog{{ { "0hello", "привет" } }, cached_destroyed} };
+        EXPECT_EQ("привет", cache.translate(loc, hello.text(), 0).str());
+    }
+    evict_locales();
+    EXPECT_FALSE(cached_destroyed)
+        << "Facet of a cached translation is alive, it's address is not reused";
+
+    bool used_destroyed = false;
+    format_template_ptr tmpl;
+    {
+        ::std::locale loc{ ::std::locale::classic(),
+            new tracked_catalog{{ { "0hello", "hola" } }, used_destroyed} };
+        tmpl = cache.get_template(loc, hello.text(), 0);
+    }
+    cache.clear();
+    evict_locales();
+    EXPECT_TRUE(cached_destroyed) << "Cleared translations release facets";
+    EXPECT_FALSE(used_destroyed) << "Template in use keeps the facet";
+    EXPECT_EQ("hola", tmpl->str().str());
+    tmpl.reset();
+    EXPECT_TRUE(used_destroyed);
+}
+
+TEST(TranslationCache, Render)
+{
+    ::std::locale loc{ ::std::locale::classic(), new test_catalog{{
+        { "0hello",         "привет" },
+        { "0{1} file[1]",   "{1} файл" },
+        { "0{1} file[n]",   "{1} файлов" },
+        { "0{1}, {2}!",     "{2}, {1}!" },
+    }}};
+    message greet{"{1}, {2}!"};
+    greet << message{"hello"} << "world";
+    EXPECT_EQ("world, привет!", greet.str(loc));
+    EXPECT_EQ("hello, world!", greet.str(::std::locale::classic()));
+
+    message plural{"{1} file", "{1} files", 5};
+    EXPECT_EQ("5 файлов", plural.str(loc));
+    EXPECT_EQ("1 файл", plural.format(1).str(loc));
+    EXPECT_EQ("3 files", plural.format(3).str(::std::locale::classic()));
+
+    ::std::ostringstream os;
+    os.imbue(loc);
+    os << message{"hello"} << " " << plural;
+    EXPECT_EQ("привет 5 файлов", os.str());
+}
+
+}  /* namespace test */
+}  /* namespace l10n */
+}  /* namespace psst */
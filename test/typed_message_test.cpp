@@ -0,0 +1,126 @@
+/*
+ * typed_message_test.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: zmij
+ */
+
+#include <gtest/gtest.h>
+#include <pushkin/l10n/typed_message.hpp>
+
+#include <sstream>
+
+namespace psst {
+namespace l10n {
+namespace test {
+
+namespace {
+
+constexpr message_template<::std::string, int> received{
+        "{1} received {2} messages"};
+constexpr message_template<int> files{
+        "{1} file", "{1} files", plural_message};
+constexpr message_template<int, ::std::string> ctx_files{
+        "disk", "One file on {2}", "{1} files on {2}", plural_message};
+constexpr message_template<double, long> options{
+        "menu", "{2,num} items cost {1,num=fixed,precision=2}"};
+constexpr message_template<> hello{"Hello {{world}"};
+
+static_assert(received.type() == message::message_type::simple,
+        "Simple message template");
+static_assert(files.has_plural() && !files.context(),
+        "Plural message template");
+static_assert(detail::used_placeholders("{2} {1,num} {{3}", 0, 16, 2) == 3,
+        "Both placeholders are used");
+
+::std::locale
+en_locale()
+{
+    ::boost::locale::generator gen;
+    return gen("en_US.UTF-8");
+}
+
+}  /* namespace  */
+
+TEST(TypedMessage, Render)
+{
+    auto loc = en_locale();
+    EXPECT_EQ("Alice received 42 messages", received("Alice", 42).str(loc));
+    EXPECT_EQ("1 file", files(1).str(loc));
+    EXPECT_EQ("3 files", files(3).str(loc));
+    EXPECT_EQ("One file on C:", ctx_files(1, "C:").str(loc));
+    EXPECT_EQ("5 files on C:", ctx_files(5, "C:").str(loc));
+    EXPECT_EQ("Hello {world}", hello().str(loc));
+
+    auto msg = options(3.5, 1000l);
+    ::std::string out = "> ";
+    msg.render(out, loc);
+    message expected{"menu", "{2,num} items cost {1,num=fixed,precision=2}"};
+    expected << 3.5 << 1000l;
+    EXPECT_EQ("> " + expected.str(loc), out);
+
+    ::std::ostringstream os;
+    os.imbue(loc);
+    os << received("Bob", 1) << "; " << files(2);
+    EXPECT_EQ("Bob received 1 messages; 2 files", os.str());
+}
+
+TEST(TypedMessage, Nested)
+{
+    auto loc = en_locale();
+    message_template<message, int> const outer{"{1} and {2}"};
+    message inner{"{1} apples"};
+    inner << 3;
+    EXPECT_EQ("3 apples and 7", outer(inner, 7).str(loc));
+
+    message_template<typed_message<int>, char const*> const typed_outer{
+            "{2}: {1}"};
+    EXPECT_EQ("disk: 2 files", typed_outer(files(2), "disk").str(loc));
+}
+
+TEST(TypedMessage, ToMessage)
+{
+    auto loc = en_locale();
+    {
+        message msg = received("Alice", 42);
+        message expected{"{1} received {2} messages"};
+        EXPECT_EQ(expected, msg);
+        EXPECT_EQ(2, msg.args_size());
+        EXPECT_EQ(received("Alice", 42).str(loc), msg.str(loc));
+    }
+    {
+        auto msg = ctx_files(5, "C:").to_message();
+        message expected{"disk", "One file on {2}", "{1} files on {2}", 5};
+        EXPECT_EQ(expected, msg);
+        EXPECT_EQ(5, msg.get_n());
+        EXPECT_EQ(1, msg.args_size());
+        EXPECT_EQ(ctx_files(5, "C:").str(loc), msg.str(loc));
+    }
+    {
+        auto msg = files(3).get_template().in_domain("other")(3).to_message();
+        EXPECT_EQ("other", msg.domain());
+        EXPECT_TRUE(msg.has_plural());
+        EXPECT_EQ("3 files", msg.str(loc));
+    }
+}
+
+TEST(TypedMessage, InvalidTemplate)
+{
+    // Not constant expressions, the checks throw at run time
+    using two_args = message_template<int, int>;
+    EXPECT_THROW(two_args{"{1} {3}"}, ::std::logic_error);
+    EXPECT_THROW(two_args{"{1}"}, ::std::logic_error);
+    EXPECT_THROW(two_args{"{0} {1} {2}"}, ::std::logic_error);
+    EXPECT_THROW(two_args{"{1} {name}"}, ::std::logic_error);
+    EXPECT_THROW(two_args{"{1} {2"}, ::std::logic_error);
+    EXPECT_THROW(two_args{"{1} {2,}"}, ::std::logic_error);
+    EXPECT_THROW(two_args{"{1} {2,num"}, ::std::logic_error);
+    EXPECT_THROW((two_args{"{1} file", "files", plural_message}),
+            ::std::logic_error);
+    EXPECT_NO_THROW((two_args{"{1} file", "{1} files {2}", plural_message}));
+    EXPECT_NO_THROW(two_args{"{2,ftime='%H:%M'} {1} {{3}"});
+}
+
+}  /* namespace test */
+}  /* namespace l10n */
+}  /* namespace psst */